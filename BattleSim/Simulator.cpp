@@ -0,0 +1,179 @@
+#include "Simulator.h"
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+void SimResults::Clear()
+{
+	memset(this, 0, sizeof(SimResults));
+}
+
+void SimResults::Add(const SimResults& other)
+{
+	battles += other.battles;
+	wins[0] += other.wins[0];
+	wins[1] += other.wins[1];
+	draws += other.draws;
+	turns += other.turns;
+	for (int i = 0; i <= SIM_MAX_TURNS; i++)
+		turn_counts[i] += other.turn_counts[i];
+	for (int side = 0; side < 2; side++)
+	{
+		decisions[side] += other.decisions[side];
+		for (int i = 0; i < AI_LATENCY_BUCKETS; i++)
+			latency_counts[side][i] += other.latency_counts[side][i];
+	}
+}
+
+unsigned int SimResults::GetTurnPercentile(unsigned int percent)
+{
+	return GetPercentile(turn_counts, SIM_MAX_TURNS + 1, battles, percent);
+}
+
+unsigned int SimResults::GetLatencyPercentile(unsigned char side, unsigned int percent)
+{
+	return GetPercentile(latency_counts[side], AI_LATENCY_BUCKETS, decisions[side], percent);
+}
+
+unsigned int SimResults::GetPercentile(const unsigned int* counts, unsigned int size, unsigned long long total, unsigned int percent)
+{
+	//the smallest value that at least percent% of the counts are at or under
+	unsigned long long needed = (total * percent + 99) / 100;
+	unsigned long long seen = 0;
+	for (unsigned int i = 0; i < size; i++)
+	{
+		seen += counts[i];
+		if (seen >= needed && seen > 0)
+			return i;
+	}
+	return size - 1;
+}
+
+Simulator::Simulator(const Pokemon* party0, unsigned char count0, const Pokemon* party1, unsigned char count1)
+{
+	const Pokemon* p[2] = { party0, party1 };
+	unsigned char c[2] = { count0, count1 };
+	for (int side = 0; side < 2; side++)
+	{
+		counts[side] = c[side] < 6 ? c[side] : 6;
+		for (int i = 0; i < 6; i++)
+			parties[side][i] = i < counts[side] ? p[side][i] : Pokemon(0);
+	}
+	for (int side = 0; side < 2; side++)
+		SetAI(side, 0, 0);
+	battle_count = 0;
+	base_seed = 0;
+	thread_count = 0;
+	seconds = 0;
+	results.Clear();
+}
+
+void Simulator::SetAI(unsigned char side, unsigned char difficulty, unsigned int budget)
+{
+	ai_difficulty[side & 1] = difficulty;
+	ai_budget[side & 1] = budget;
+}
+
+void Simulator::Run(unsigned int battles, unsigned int threads, unsigned int seed)
+{
+	battle_count = battles;
+	base_seed = seed;
+	thread_count = threads ? threads : 1;
+	next_battle = 0;
+	results.Clear();
+
+	//each thread adds up its own results, they only get merged once everything is done
+	std::vector<SimResults*> thread_results;
+	std::vector<std::thread> workers;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (unsigned int i = 0; i < thread_count; i++)
+	{
+		thread_results.push_back(new SimResults());
+		workers.push_back(std::thread(&Simulator::RunThread, this, thread_results.back()));
+	}
+	for (unsigned int i = 0; i < thread_count; i++)
+	{
+		workers[i].join();
+		results.Add(*thread_results[i]);
+		delete thread_results[i];
+	}
+	seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void Simulator::RunThread(SimResults* out)
+{
+	out->Clear();
+	Battle battle;
+	BattleAI ai0(ai_difficulty[0], ai_budget[0]);
+	BattleAI ai1(ai_difficulty[1], ai_budget[1]);
+	BattleAI* ai[2] = { &ai0, &ai1 };
+	while (true)
+	{
+		unsigned int first = next_battle.fetch_add(SIM_CHUNK);
+		if (first >= battle_count)
+			break;
+		unsigned int last = first + SIM_CHUNK < battle_count ? first + SIM_CHUNK : battle_count;
+		for (unsigned int i = first; i < last; i++)
+		{
+			//battles get their own stream of the run's seed, so no two ever roll the same numbers
+			battle.Start(parties[0], counts[0], parties[1], counts[1], RandomStream(base_seed, i));
+			ai[0]->Reset();
+			ai[1]->Reset();
+			while (!battle.IsOver() && battle.GetTurn() < SIM_MAX_TURNS)
+			{
+				//side 0 always chooses first, since the random AI uses the battle's generator
+				BattleAction action0 = ai[0]->ChooseAction(battle, 0);
+				BattleAction action1 = ai[1]->ChooseAction(battle, 1);
+				battle.RunTurn(action0, action1);
+			}
+
+			out->battles++;
+			out->turns += battle.GetTurn();
+			out->turn_counts[battle.GetTurn() < SIM_MAX_TURNS ? battle.GetTurn() : SIM_MAX_TURNS]++;
+			if (battle.IsOver() && battle.GetWinner() < 2)
+				out->wins[battle.GetWinner()]++;
+			else
+				out->draws++;
+		}
+	}
+	for (int side = 0; side < 2; side++)
+	{
+		out->decisions[side] = ai[side]->GetDecisionCount();
+		memcpy(out->latency_counts[side], ai[side]->GetLatencyCounts(), sizeof(out->latency_counts[side]));
+	}
+}
+
+void Simulator::PrintResults(std::ostream& out)
+{
+	if (results.battles == 0)
+	{
+		out << "No battles were run.\n";
+		return;
+	}
+
+	double n = results.battles;
+	out.setf(std::ios::fixed);
+	out.precision(2);
+	out << "Ran " << results.battles << " battles on " << thread_count << (thread_count == 1 ? " thread in " : " threads in ") << seconds << "s ("
+		<< (seconds > 0 ? n / seconds : 0) << " battles/s, " << (seconds > 0 ? results.turns / seconds : 0) << " turns/s)\n";
+	for (int side = 0; side < 2; side++)
+	{
+		//95% confidence interval, so it's clear when a difference between two runs is just noise
+		double rate = results.wins[side] / n;
+		out << "Side " << side + 1 << " won " << results.wins[side] << " (" << rate * 100 << "% +/- " << 196 * sqrt(rate * (1 - rate) / n) << "%)\n";
+	}
+	if (results.draws)
+		out << "Draws (over " << SIM_MAX_TURNS << " turns): " << results.draws << " (" << results.draws * 100 / n << "%)\n";
+	out << "Turns: average " << results.turns / n << ", min " << results.GetTurnPercentile(0) << ", median " << results.GetTurnPercentile(50)
+		<< ", 90% " << results.GetTurnPercentile(90) << ", 99% " << results.GetTurnPercentile(99) << ", max " << results.GetTurnPercentile(100) << "\n";
+	for (int side = 0; side < 2; side++)
+	{
+		if (ai_difficulty[side] == 0 || results.decisions[side] == 0)
+			continue;
+		out << "Side " << side + 1 << " AI (difficulty " << (int)ai_difficulty[side] << ", " << ai_budget[side] << "us budget): " << results.decisions[side]
+			<< " decisions, median " << results.GetLatencyPercentile(side, 50) << "us, 90% " << results.GetLatencyPercentile(side, 90) << "us, 99% "
+			<< results.GetLatencyPercentile(side, 99) << "us, max " << results.GetLatencyPercentile(side, 100) << "us\n";
+	}
+}
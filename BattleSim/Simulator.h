@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <ostream>
+#include "BattleAI.h"
+
+#define SIM_MAX_TURNS 1000 //longer battles are counted as draws, eg. two pokemon that can't hurt each other
+#define SIM_CHUNK 256 //how many battles a thread takes at a time
+
+struct SimResults
+{
+	unsigned int battles;
+	unsigned int wins[2];
+	unsigned int draws;
+	unsigned long long turns;
+	unsigned int turn_counts[SIM_MAX_TURNS + 1]; //how many battles took each number of turns
+	unsigned int decisions[2];
+	unsigned int latency_counts[2][AI_LATENCY_BUCKETS]; //each side's AI decision times, per microsecond
+
+	void Clear();
+	void Add(const SimResults& other);
+	unsigned int GetTurnPercentile(unsigned int percent);
+	unsigned int GetLatencyPercentile(unsigned char side, unsigned int percent);
+
+	static unsigned int GetPercentile(const unsigned int* counts, unsigned int size, unsigned long long total, unsigned int percent);
+};
+
+//Plays the same two parties against each other over and over, spread across threads. Each side picks its moves
+//with a BattleAI, which picks at random unless it's given a difficulty. Every battle rolls from its own stream of
+//the run's seed, numbered by the battle, so the results only depend on the seed and the number of battles, not on
+//how many threads ran them (as long as the AI has no time budget, since how far it gets then depends on the machine).
+class Simulator
+{
+public:
+	Simulator(const Pokemon* party0, unsigned char count0, const Pokemon* party1, unsigned char count1);
+
+	void SetAI(unsigned char side, unsigned char difficulty, unsigned int budget);
+	void Run(unsigned int battles, unsigned int threads, unsigned int seed);
+	void PrintResults(std::ostream& out);
+
+	SimResults& GetResults() { return results; }
+	double GetSeconds() { return seconds; }
+
+private:
+	Pokemon parties[2][6];
+	unsigned char counts[2];
+	unsigned char ai_difficulty[2];
+	unsigned int ai_budget[2];
+
+	unsigned int battle_count;
+	unsigned int base_seed;
+	unsigned int thread_count;
+	std::atomic<unsigned int> next_battle;
+
+	SimResults results;
+	double seconds;
+
+	void RunThread(SimResults* out);
+};
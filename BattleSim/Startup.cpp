@@ -0,0 +1,234 @@
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <thread>
+#include <algorithm>
+
+#include "Simulator.h"
+
+using namespace std;
+
+string resource_dir = "";
+string party_args[2];
+string trainer_args[2];
+unsigned int battles = 10000;
+unsigned int threads = 0;
+unsigned int seed = 1;
+unsigned char ai_difficulty[2] = { 0, 0 };
+unsigned int ai_budget = AI_DEFAULT_BUDGET;
+
+void PrintOptions();
+bool ParseArgs(int count, char** args);
+unsigned char MakeParty(unsigned char side, Pokemon* party);
+unsigned char ParseParty(const string& s, Pokemon* party);
+unsigned char ParseTrainer(const string& s, Pokemon* party);
+unsigned char FindSpecies(const string& name);
+string ToAscii(const string& s);
+
+int main(int count, char** args)
+{
+	cout << "Pokemon Multiplayer Red Battle Simulator v1.00\n\n";
+	if (!ParseArgs(count, args))
+		return 1;
+
+	GameData::LoadAll(resource_dir);
+	if (!GameData::GetAsciiTable())
+	{
+		cout << "Couldn't load the game data from " << resource_dir << ".\n";
+		return 1;
+	}
+
+	//the pokemon's DVs are random too, so the parties are the same for the same seed
+	Random::Seed(seed);
+	Pokemon parties[2][6];
+	unsigned char counts[2];
+	for (unsigned char side = 0; side < 2; side++)
+	{
+		counts[side] = MakeParty(side, parties[side]);
+		if (counts[side] == 0)
+			return 1;
+		cout << "Side " << side + 1 << ":";
+		for (int i = 0; i < counts[side]; i++)
+			cout << (i ? ", " : " ") << ToAscii(parties[side][i].GetName()) << " L" << (int)parties[side][i].level;
+		cout << "\n";
+	}
+	cout << "\n";
+
+	if (threads == 0)
+		threads = thread::hardware_concurrency() ? thread::hardware_concurrency() : 1;
+	Simulator sim(parties[0], counts[0], parties[1], counts[1]);
+	for (unsigned char side = 0; side < 2; side++)
+		sim.SetAI(side, ai_difficulty[side], ai_budget);
+	sim.Run(battles, threads, seed);
+	sim.PrintResults(cout);
+
+	GameData::Release();
+	return 0;
+}
+
+void PrintOptions()
+{
+	cout << "Argument options:\n";
+	cout << "-p1	Sets side 1's party, eg. -p1 PIKACHU:25,SQUIRTLE:20. Species can also be pokedex numbers.\n";
+	cout << "-p2	Sets side 2's party.\n";
+	cout << "-t1	Uses a trainer's party for side 1, eg. -t1 201:3 for trainer class 201's third party (pokemon_set in the map data).\n";
+	cout << "-t2	Uses a trainer's party for side 2.\n";
+	cout << "-a1	Sets side 1's AI difficulty, 0-" << AI_MAX_DIFFICULTY << " (default 0, random moves).\n";
+	cout << "-a2	Sets side 2's AI difficulty.\n";
+	cout << "-b	Sets the AI's time budget per decision in microseconds (default " << AI_DEFAULT_BUDGET << ", 0 for none).\n";
+	cout << "-n	Sets how many battles to simulate (default 10000).\n";
+	cout << "-j	Sets how many threads to use (default one per core).\n";
+	cout << "-s	Sets the random seed (default 1). The same seed gives the same results.\n\n";
+}
+
+bool ParseArgs(int count, char** args)
+{
+	if (count < 2)
+	{
+		cout << "Usage: <resource directory> [options]\n";
+		PrintOptions();
+		return false;
+	}
+	resource_dir = args[1];
+	if (resource_dir.back() != '/' && resource_dir.back() != '\\')
+		resource_dir.append("/");
+	for (int i = 2; i < count; i++)
+	{
+		string s = args[i];
+		if (i + 1 == count)
+		{
+			cout << s << " needs a value.\n";
+			PrintOptions();
+			return false;
+		}
+		if (s == "-p1" || s == "-p2")
+			party_args[s[2] - '1'] = args[++i];
+		else if (s == "-t1" || s == "-t2")
+			trainer_args[s[2] - '1'] = args[++i];
+		else if (s == "-a1" || s == "-a2")
+			ai_difficulty[s[2] - '1'] = (unsigned char)min(strtoul(args[++i], 0, 10), (unsigned long)AI_MAX_DIFFICULTY);
+		else if (s == "-b")
+			ai_budget = strtoul(args[++i], 0, 10);
+		else if (s == "-n")
+			battles = strtoul(args[++i], 0, 10);
+		else if (s == "-j")
+			threads = strtoul(args[++i], 0, 10);
+		else if (s == "-s")
+			seed = strtoul(args[++i], 0, 10);
+		else
+		{
+			cout << "Unknown option " << s << ".\n";
+			PrintOptions();
+			return false;
+		}
+	}
+	return true;
+}
+
+unsigned char MakeParty(unsigned char side, Pokemon* party)
+{
+	unsigned char count = 0;
+	if (!trainer_args[side].empty())
+		count = ParseTrainer(trainer_args[side], party);
+	else if (!party_args[side].empty())
+		count = ParseParty(party_args[side], party);
+	else
+		cout << "Side " << side + 1 << " needs a party (-p" << side + 1 << " or -t" << side + 1 << ").\n";
+	return count;
+}
+
+unsigned char ParseParty(const string& s, Pokemon* party)
+{
+	//SPECIES:LEVEL pairs separated by commas
+	unsigned char count = 0;
+	size_t start = 0;
+	while (start < s.length() && count < 6)
+	{
+		size_t end = s.find(',', start);
+		if (end == string::npos)
+			end = s.length();
+		string entry = s.substr(start, end - start);
+		start = end + 1;
+
+		size_t colon = entry.find(':');
+		unsigned char species = FindSpecies(entry.substr(0, colon));
+		int level = colon == string::npos ? 0 : atoi(entry.c_str() + colon + 1);
+		if (species == 0 || level < 1 || level > 100)
+		{
+			cout << "Couldn't read \"" << entry << "\", use SPECIES:LEVEL.\n";
+			return 0;
+		}
+		party[count++] = Pokemon(species, level);
+	}
+	return count;
+}
+
+unsigned char ParseTrainer(const string& s, Pokemon* party)
+{
+	size_t colon = s.find(':');
+	unsigned char trainer_class = atoi(s.c_str());
+	unsigned char pokemon_set = colon == string::npos ? 0 : atoi(s.c_str() + colon + 1);
+	unsigned char species[6];
+	unsigned char levels[6];
+	unsigned char count = GameData::GetTrainerParty(trainer_class, pokemon_set, species, levels);
+	if (count == 0)
+	{
+		cout << "Trainer class " << (int)trainer_class << " has no party " << (int)pokemon_set << ".\n";
+		return 0;
+	}
+	for (int i = 0; i < count; i++)
+	{
+		party[i] = Pokemon(species[i], levels[i]);
+		party[i].SetTrainerDVs();
+	}
+	return count;
+}
+
+unsigned char FindSpecies(const string& name)
+{
+	//pokedex numbers or names, returns the species id or 0
+	if (name.empty())
+		return 0;
+	if (name.find_first_not_of("0123456789") == string::npos)
+	{
+		int dex = atoi(name.c_str());
+		for (int i = 0; i < 255; i++)
+		{
+			if (dex > 0 && GameData::GetPokedexIndex(i) == dex)
+				return i + 1;
+		}
+		return 0;
+	}
+
+	string upper = name;
+	for (unsigned int i = 0; i < upper.length(); i++)
+		upper[i] = toupper(upper[i]);
+	pokestring(upper);
+	for (int i = 0; i < 255; i++)
+	{
+		if (GameData::GetPokemonName(i) == upper)
+			return i + 1;
+	}
+	return 0;
+}
+
+string ToAscii(const string& s)
+{
+	//the reverse of pokestring, for printing names
+	DataBlock* table = GameData::GetAsciiTable();
+	string out;
+	for (unsigned int i = 0; i < s.length(); i++)
+	{
+		char c = '?';
+		for (int k = ' '; k < 0x7F; k++)
+		{
+			if (table->data[k] == (unsigned char)s[i])
+			{
+				c = (char)k;
+				break;
+			}
+		}
+		out += c;
+	}
+	return out;
+}
@@ -1,4 +1,5 @@
 #include "CommandParser.h"
+#include <cmath>
 
 map<string, unsigned int> CommandParser::labels;
 map<string, unsigned int> CommandParser::variables;
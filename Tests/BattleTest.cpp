@@ -0,0 +1,242 @@
+#include <iostream>
+#include <cstring>
+#include <chrono>
+
+#include "Battle.h"
+#include "GameData.h"
+#include "TestData.h"
+
+using namespace std;
+
+//Checks that Battle is deterministic: the same parties and streams always give the same battles, and a copy of a
+//battle made halfway through finishes the same way as the original. The battles are 6v6 at level 50 with random
+//moves on both sides, using the made up data from TestData.h, and their results are hashed against a recorded value
+//so any change to the rules or the damage formula shows up. It also checks the odds of running from a wild pokemon.
+//With -b it times Battle::RunTurn and CalculateDamage.
+
+#define DATA_DIR "battle_test_data/"
+#define BATTLE_COUNT 2000
+#define MAX_TURNS 1000
+#define EXPECTED_HASH 0x14BAEEE5D02032E5ULL
+#define BENCH_BATTLES 20000
+#define BENCH_CALLS 1000000
+#define BENCH_RUNS 5
+
+Pokemon parties[2][6];
+
+//plays a battle out with both sides picking random moves, side 0 first since both use the battle's generator
+void Finish(Battle& battle)
+{
+	while (!battle.IsOver() && battle.GetTurn() < MAX_TURNS)
+	{
+		BattleAction action0 = battle.ChooseRandomMove(0);
+		BattleAction action1 = battle.ChooseRandomMove(1);
+		battle.RunTurn(action0, action1);
+	}
+}
+
+//FNV-1a over the winner, the turn count and what's left of both parties
+unsigned long long Hash(Battle& battle, unsigned long long hash)
+{
+	unsigned int values[3] = { battle.GetWinner(), battle.GetTurn(), battle.IsOver() };
+	for (int i = 0; i < 3; i++)
+		hash = (hash ^ values[i]) * 1099511628211ULL;
+	for (int side = 0; side < 2; side++)
+	{
+		for (int i = 0; i < 6; i++)
+		{
+			Pokemon& p = battle.GetSide(side).party[i];
+			hash = (hash ^ p.hp) * 1099511628211ULL;
+			hash = (hash ^ p.status) * 1099511628211ULL;
+			for (int m = 0; m < 4; m++)
+				hash = (hash ^ p.moves[m].pp) * 1099511628211ULL;
+		}
+	}
+	return hash;
+}
+
+unsigned long long RunBattles(unsigned int seed, unsigned int& turns, unsigned int& unfinished)
+{
+	unsigned long long hash = 14695981039346656037ULL;
+	turns = 0;
+	unfinished = 0;
+	Battle battle;
+	for (unsigned int i = 0; i < BATTLE_COUNT; i++)
+	{
+		battle.Start(parties[0], 6, parties[1], 6, RandomStream(seed, i));
+		Finish(battle);
+		hash = Hash(battle, hash);
+		turns += battle.GetTurn();
+		unfinished += !battle.IsOver();
+	}
+	return hash;
+}
+
+bool CheckCopies(unsigned int seed)
+{
+	//stop each battle at a different turn, then finish both it and a copy of it
+	unsigned int different = 0;
+	Battle battle;
+	for (unsigned int i = 0; i < 200; i++)
+	{
+		battle.Start(parties[0], 6, parties[1], 6, RandomStream(seed, i));
+		for (unsigned int turn = 0; turn < i % 20 && !battle.IsOver(); turn++)
+		{
+			BattleAction action0 = battle.ChooseRandomMove(0);
+			BattleAction action1 = battle.ChooseRandomMove(1);
+			battle.RunTurn(action0, action1);
+		}
+		Battle copy = battle;
+		Finish(battle);
+		Finish(copy);
+		different += Hash(battle, 0) != Hash(copy, 0);
+	}
+	cout << "Copies made during a battle: " << (different ? "DIFFERENT" : "same") << "\n";
+	return different == 0;
+}
+
+//runs from a wild pokemon until it works, the wild one switching to itself so it does nothing, returns the tries it took
+unsigned int Escape(Battle& battle, unsigned int speed, unsigned int other_speed, unsigned int seed)
+{
+	battle.Start(&parties[0][0], 1, &parties[1][0], 1, RandomStream(seed), true);
+	battle.GetActive(0).speed = speed;
+	battle.GetActive(1).speed = other_speed;
+	BattleAction run = { BattleActions::RUN, 0 };
+	BattleAction wait = { BattleActions::SWITCH, 0 };
+	while (!battle.IsOver() && battle.GetTurn() < MAX_TURNS)
+		battle.RunTurn(run, wait);
+	return battle.IsOver() && battle.GetWinner() == BATTLE_NO_WINNER ? battle.GetTurn() : 0;
+}
+
+bool CheckEscapes()
+{
+	//as fast or faster always gets away on the first try
+	Battle battle;
+	unsigned int wrong = 0;
+	for (unsigned int seed = 0; seed < 200; seed++)
+		wrong += Escape(battle, 100, 100, seed) != 1 || Escape(battle, 101, 100, seed) != 1;
+	cout << "Escaping as fast or faster: " << (wrong ? "WRONG" : "first try") << "\n";
+
+	//20 against 200 starts at 12/256 and gains 30/256 a try, so the share of those still trying who get away goes up
+	unsigned int tries[10] = {};
+	unsigned int escapes[10] = {};
+	unsigned int never = 0;
+	for (unsigned int seed = 0; seed < 2000; seed++)
+	{
+		unsigned int attempts = Escape(battle, 20, 200, seed);
+		never += attempts == 0 || attempts > 10;
+		for (unsigned int i = 0; i < attempts && i < 10; i++)
+			tries[i]++;
+		if (attempts > 0 && attempts <= 10)
+			escapes[attempts - 1]++;
+	}
+	bool better = never == 0 && escapes[9] == tries[9];
+	for (int i = 1; i < 4; i++)
+		better &= escapes[i] * tries[i - 1] > escapes[i - 1] * tries[i];
+	cout << "Escaping when slower: ";
+	for (int i = 0; i < 4; i++)
+		cout << escapes[i] << "/" << tries[i] << " ";
+	cout << (better ? "better each try" : "WRONG") << "\n";
+	return wrong == 0 && better;
+}
+
+double TimeTurns(unsigned int& turns)
+{
+	double best = 0;
+	for (int run = 0; run < BENCH_RUNS; run++)
+	{
+		Battle battle;
+		turns = 0;
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		for (unsigned int i = 0; i < BENCH_BATTLES; i++)
+		{
+			battle.Start(parties[0], 6, parties[1], 6, RandomStream(run + 1, i));
+			Finish(battle);
+			turns += battle.GetTurn();
+		}
+		double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+		if (run == 0 || seconds < best)
+			best = seconds;
+	}
+	return best;
+}
+
+double TimeDamage()
+{
+	//random attackers, defenders and moves from the parties, so the type lookups aren't always the same
+	static unsigned char attackers[BENCH_CALLS];
+	static unsigned char defenders[BENCH_CALLS];
+	static unsigned char slots[BENCH_CALLS];
+	static unsigned char rolls[BENCH_CALLS];
+	RandomStream random(1);
+	for (int i = 0; i < BENCH_CALLS; i++)
+	{
+		attackers[i] = random.Range(12);
+		defenders[i] = random.Range(12);
+		slots[i] = random.Range(4);
+		rolls[i] = 217 + random.Range(39);
+	}
+
+	double best = 0;
+	for (int run = 0; run < BENCH_RUNS; run++)
+	{
+		unsigned int sum = 0;
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		for (int i = 0; i < BENCH_CALLS; i++)
+		{
+			const Pokemon& attacker = parties[attackers[i] / 6][attackers[i] % 6];
+			const Pokemon& defender = parties[defenders[i] / 6][defenders[i] % 6];
+			sum += Battle::CalculateDamage(attacker, defender, GameData::GetMoveInfo(attacker.moves[slots[i]].index), false, rolls[i]);
+		}
+		double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+		volatile unsigned int keep = sum;
+		(void)keep;
+		if (run == 0 || seconds < best)
+			best = seconds;
+	}
+	return best * 1000000000 / BENCH_CALLS;
+}
+
+int main(int count, char** args)
+{
+	bool bench = count > 1 && strcmp(args[1], "-b") == 0;
+	if (!TestData::Make(DATA_DIR))
+	{
+		cout << "Couldn't write the test data to " << DATA_DIR << ".\nFAILED\n";
+		return 1;
+	}
+	GameData::LoadAll(DATA_DIR);
+
+	//one of each kind of species from TestData on each side, their DVs from a fixed seed
+	Random::Seed(1);
+	for (int side = 0; side < 2; side++)
+	{
+		for (int i = 0; i < 6; i++)
+			parties[side][i] = Pokemon((unsigned char)(side * 6 + i + 1), 50);
+	}
+
+	bool passed = true;
+	unsigned int turns, unfinished, turns2, unfinished2;
+	unsigned long long hash = RunBattles(1, turns, unfinished);
+	unsigned long long hash2 = RunBattles(1, turns2, unfinished2);
+	cout << BATTLE_COUNT << " battles, " << turns << " turns, " << unfinished << " unfinished: " << hex << hash << dec << "\n";
+	cout << "Running them again: " << (hash == hash2 ? "same" : "DIFFERENT") << "\n";
+	cout << "Against the recorded results: " << (hash == EXPECTED_HASH ? "same" : "DIFFERENT") << "\n";
+	passed &= hash == hash2 && hash == EXPECTED_HASH && unfinished == 0;
+	passed &= CheckCopies(2);
+	passed &= CheckEscapes();
+
+	if (bench)
+	{
+		unsigned int bench_turns;
+		double seconds = TimeTurns(bench_turns);
+		cout.setf(ios::fixed);
+		cout.precision(2);
+		cout << BENCH_BATTLES << " battles on one thread: " << BENCH_BATTLES / seconds / 1000 << "k battles/s, " << bench_turns / seconds / 1000000 << "M turns/s, "
+			<< seconds * 1000000000 / bench_turns << "ns per RunTurn (" << (double)bench_turns / BENCH_BATTLES << " turns per battle)\n";
+		cout << "CalculateDamage: " << TimeDamage() << "ns\n";
+	}
+
+	cout << (passed ? "Passed\n" : "FAILED\n");
+	return passed ? 0 : 1;
+}
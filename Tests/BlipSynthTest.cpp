@@ -0,0 +1,105 @@
+#include <iostream>
+#include <cstring>
+#include <chrono>
+
+#include "Blip_Buffer.h"
+#include "TestGbs.h"
+
+using namespace std;
+
+//Checks that Blip_Synth adds impulses exactly like the original scalar code did, for each quality. The expected
+//hashes were made with the baseline Blip_Buffer, and both the SIMD build (test-blip) and the portable build
+//(test-blip-scalar) have to match them. With -b it also times offset_inline.
+
+#define FRAMES 200
+#define BENCH_FRAMES 2000
+#define TRANSITIONS 20000 //per synth per frame
+#define BENCH_RUNS 5
+
+const unsigned long long expected_hashes[] = { 0x34C018B9C2424CDBULL, 0x81CC8A4EC0F936E7ULL, 0xC77BA421F4BEDCB4ULL };
+
+template<int quality> unsigned long long Run(int frames, double* seconds)
+{
+	Blip_Buffer buffer;
+	buffer.set_sample_rate(44100, 1000);
+	buffer.clock_rate(4194304);
+
+	//small deltas like an APU's, and huge ones to make sure the products wrap the same way
+	Blip_Synth<quality, 15> apu;
+	apu.volume(0.7);
+	apu.output(&buffer);
+	Blip_Synth<quality, 1> wide;
+	wide.volume(0.3);
+	wide.output(&buffer);
+
+	static int times[TRANSITIONS];
+	static int small_deltas[TRANSITIONS];
+	static int big_deltas[TRANSITIONS];
+	RandomStream random(quality);
+	for (int i = 0; i < TRANSITIONS; i++)
+	{
+		times[i] = i * 3 + random.Range(2);
+		small_deltas[i] = (int)random.Range(31) - 15;
+		big_deltas[i] = (int)random.Range(131071) - 65535;
+	}
+
+	static short out[8192];
+	unsigned long long hash = 14695981039346656037ULL;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for (int frame = 0; frame < frames; frame++)
+	{
+		//changing the eq or volume rebuilds the impulses, which the SIMD path keeps its own copy of
+		if (frame % 50 == 25)
+		{
+			apu.treble_eq(blip_eq_t(-(double)(frame % 40)));
+			wide.volume(0.1 + (frame % 7) * 0.1);
+		}
+		for (int i = 0; i < TRANSITIONS; i++)
+		{
+			apu.offset_inline(times[i], small_deltas[i]);
+			wide.offset_inline(times[i], big_deltas[i]);
+		}
+		buffer.end_frame(TRANSITIONS * 3);
+		long count = buffer.read_samples(out, 8192);
+		hash = TestGbs::Hash(out, count, hash);
+	}
+	*seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	return hash;
+}
+
+template<int quality> bool Check(unsigned long long expected, bool bench)
+{
+	double seconds;
+	unsigned long long hash = Run<quality>(FRAMES, &seconds);
+	cout << "Quality " << quality << ": " << hex << hash << dec << (hash == expected ? "" : " (expected a different hash)") << "\n";
+	if (bench)
+	{
+		//the best of a few runs, since anything else running only ever makes it slower
+		double best = 0;
+		for (int run = 0; run < BENCH_RUNS; run++)
+		{
+			Run<quality>(BENCH_FRAMES, &seconds);
+			if (run == 0 || seconds < best)
+				best = seconds;
+		}
+		cout << "  " << 2.0 * TRANSITIONS * BENCH_FRAMES / best / 1000000 << "M offsets/s\n";
+	}
+	return hash == expected;
+}
+
+int main(int count, char** args)
+{
+	bool bench = count > 1 && strcmp(args[1], "-b") == 0;
+#if BLIP_BUFFER_SIMD
+	cout << "SIMD build\n";
+#else
+	cout << "Portable build\n";
+#endif
+	cout.setf(ios::fixed);
+	cout.precision(1);
+	bool passed = Check<blip_med_quality>(expected_hashes[0], bench);
+	passed &= Check<blip_good_quality>(expected_hashes[1], bench);
+	passed &= Check<blip_high_quality>(expected_hashes[2], bench);
+	cout << (passed ? "Passed\n" : "FAILED\n");
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,97 @@
+#include <iostream>
+
+#include "EncounterTable.h"
+
+using namespace std;
+
+//Checks RandomStream against the reference PCG32 output, EncounterTable::GetSlot against the scan over the chances
+//the game does on every step, for every roll, and Steps against calling Step the same number of times on a stream
+//seeded the same way.
+
+#define STEPS 10000
+
+//pcg32-demo's first six numbers for seed 42, stream 54
+const unsigned int pcg32_reference[] = { 0xa15c02b7, 0x7b47f409, 0xba1d3330, 0x83d2f293, 0xbfa4784b, 0xcbed606e };
+
+//the game's slot chances, each one the highest roll that gets that slot, and one that runs out before 255
+const unsigned char game_chances[ENCOUNTER_SLOTS] = { 50, 101, 140, 165, 190, 215, 228, 241, 252, 255 };
+const unsigned char short_chances[ENCOUNTER_SLOTS] = { 0, 0, 10, 10, 10, 99, 100, 180, 200, 230 };
+
+unsigned char ScanChances(const unsigned char* chances, unsigned char roll)
+{
+	for (int i = 0; i < ENCOUNTER_SLOTS; i++)
+	{
+		if (roll <= chances[i])
+			return i;
+	}
+	return ENCOUNTER_NONE;
+}
+
+bool CheckSlots(const char* name, const unsigned char* chances)
+{
+	WildEncounter encounters[ENCOUNTER_SLOTS];
+	for (int i = 0; i < ENCOUNTER_SLOTS; i++)
+		encounters[i] = WildEncounter(i + 1, i + 2);
+	EncounterTable table;
+	table.Build(encounters, 25, chances);
+
+	unsigned int wrong = 0;
+	unsigned char rolls[256];
+	unsigned char slots[256];
+	for (int roll = 0; roll < 256; roll++)
+	{
+		wrong += table.GetSlot(roll) != ScanChances(chances, roll);
+		rolls[roll] = roll;
+	}
+	table.GetSlots(rolls, 256, slots);
+	for (int roll = 0; roll < 256; roll++)
+		wrong += slots[roll] != ScanChances(chances, roll);
+	cout << name << ", every roll: " << (wrong ? "WRONG" : "same as the scan") << "\n";
+	return wrong == 0;
+}
+
+bool CheckSteps(unsigned char rate)
+{
+	WildEncounter encounters[ENCOUNTER_SLOTS];
+	EncounterTable table;
+	table.Build(encounters, rate, game_chances);
+
+	static unsigned char batch[STEPS];
+	RandomStream batch_random(rate, RandomStreams::ENCOUNTERS);
+	RandomStream step_random(rate, RandomStreams::ENCOUNTERS);
+	unsigned int found = table.Steps(batch_random, STEPS, batch);
+	unsigned int step_found = 0;
+	unsigned int wrong = 0;
+	for (int i = 0; i < STEPS; i++)
+	{
+		unsigned char slot = table.Step(step_random);
+		step_found += slot != ENCOUNTER_NONE;
+		wrong += slot != batch[i];
+	}
+	//both have to leave their stream in the same place too
+	bool same = wrong == 0 && found == step_found && batch_random.Next() == step_random.Next();
+	cout << "Steps(" << STEPS << ") at rate " << (int)rate << ", " << found << " found: " << (same ? "same as one step at a time" : "DIFFERENT") << "\n";
+	return same;
+}
+
+int main()
+{
+	bool passed = true;
+
+	RandomStream pcg(42, 54);
+	bool same = true;
+	for (int i = 0; i < 6; i++)
+		same &= pcg.Next() == pcg32_reference[i];
+	cout << "PCG32, seed 42, stream 54: " << (same ? "same as the reference" : "DIFFERENT") << "\n";
+	passed &= same;
+
+	passed &= CheckSlots("The game's chances", game_chances);
+	passed &= CheckSlots("Chances that stop short of 255", short_chances);
+
+	const unsigned char rates[] = { 0, 1, 25, 128, 255 };
+	for (int i = 0; i < 5; i++)
+		passed &= CheckSteps(rates[i]);
+
+	cout << (passed ? "Passed\n" : "FAILED\n");
+	return passed ? 0 : 1;
+}
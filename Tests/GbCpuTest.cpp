@@ -0,0 +1,80 @@
+#include <iostream>
+#include <cstring>
+#include <chrono>
+
+#include "Gbs_Emu.h"
+#include "TestGbs.h"
+
+using namespace std;
+
+//Checks that the GBS player's CPU core still plays TestGbs images exactly like the original switch based core did.
+//The expected hashes were made with the baseline Gb_Cpu.cpp, and both the computed goto build (test-gbcpu) and the
+//switch build (test-gbcpu-switch) have to match them. With -b it also times the core.
+
+#define SAMPLE_RATE 44100
+#define TEST_SECONDS 4
+#define BENCH_SECONDS 60
+#define BENCH_RUNS 7
+#define GB_CLOCK_RATE 4194304.0
+
+const unsigned long long expected_hashes[] = { 0x644030C3FD61A183ULL, 0xFA9AC871104AAD3DULL, 0x4C9EE80803655A7BULL, 0x2A713874D1750D31ULL };
+
+unsigned long long PlayImage(unsigned long long seed, long seconds, double* wall_seconds)
+{
+	vector<unsigned char> image = TestGbs::Make(seed);
+	Gbs_Emu emu;
+	emu.set_sample_rate(SAMPLE_RATE);
+	emu.ignore_silence(); //otherwise quiet stretches would end the track early
+	if (emu.load_mem(&image[0], (long)image.size()) || emu.start_track(0))
+	{
+		cout << "Couldn't load the test image for seed " << seed << ".\n";
+		return 0;
+	}
+	emu.set_fade(10000000); //the default fade start overflows where long is 64 bits, so give it one far away
+
+	static short buffer[4096];
+	unsigned long long hash = 14695981039346656037ULL;
+	long remaining = seconds * SAMPLE_RATE * 2;
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	while (remaining > 0)
+	{
+		long count = remaining < 4096 ? remaining : 4096;
+		emu.play(count, buffer);
+		hash = TestGbs::Hash(buffer, count, hash);
+		remaining -= count;
+	}
+	*wall_seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	return hash;
+}
+
+int main(int count, char** args)
+{
+	bool bench = count > 1 && strcmp(args[1], "-b") == 0;
+	bool passed = true;
+	for (unsigned int i = 0; i < sizeof(expected_hashes) / sizeof(expected_hashes[0]); i++)
+	{
+		double seconds;
+		unsigned long long hash = PlayImage(i + 1, TEST_SECONDS, &seconds);
+		cout << "Seed " << i + 1 << ": " << hex << hash << dec << (hash == expected_hashes[i] ? "" : " (expected a different hash)") << "\n";
+		passed &= hash == expected_hashes[i];
+	}
+
+	if (bench)
+	{
+		//the best of a few runs, since anything else running only ever makes it slower
+		double seconds = 0;
+		for (int run = 0; run < BENCH_RUNS; run++)
+		{
+			double run_seconds;
+			PlayImage(1, BENCH_SECONDS, &run_seconds);
+			if (run == 0 || run_seconds < seconds)
+				seconds = run_seconds;
+		}
+		cout.setf(ios::fixed);
+		cout.precision(2);
+		cout << "Played " << BENCH_SECONDS << "s of audio in " << seconds << "s, " << BENCH_SECONDS * GB_CLOCK_RATE / seconds / 1000000 << "M emulated cycles/s\n";
+	}
+
+	cout << (passed ? "Passed\n" : "FAILED\n");
+	return passed ? 0 : 1;
+}
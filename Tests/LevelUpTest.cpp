@@ -0,0 +1,138 @@
+#include <iostream>
+
+#include "Battle.h"
+#include "GameData.h"
+#include "TestData.h"
+
+using namespace std;
+
+//Checks Pokemon::AddXP against levelling up one level at a time, for every growth rate, starting level and amount
+//that lands on or just short of each level above it, including past 100. After a jump the learnset and evolution
+//lookups have to cover every level skipped. It also checks that beating a pokemon in a Battle awards the game's
+//xp to whoever is out, and logs the level-ups that come with it.
+
+#define DATA_DIR "levelup_test_data/"
+
+bool passed = true;
+
+void Expect(const char* name, bool same)
+{
+	cout << name << ": " << (same ? "right" : "WRONG") << "\n";
+	passed &= same;
+}
+
+//what AddXP replaced: add the xp, then check for the next level until it isn't reached
+unsigned char LevelUpSlowly(Pokemon& p, unsigned int amount)
+{
+	unsigned int max_xp = Pokemon::GetXPAt(100, p.Species().growth_rate);
+	p.xp = p.xp + amount < max_xp ? p.xp + amount : max_xp;
+	unsigned char gained = 0;
+	while (p.level < 100 && p.xp >= Pokemon::GetXPAt(p.level + 1, p.Species().growth_rate))
+	{
+		p.level++;
+		gained++;
+	}
+	return gained;
+}
+
+//attacks a one hp pokemon until it faints, returns side 0's active pokemon
+Pokemon& Beat(Battle& battle, Pokemon& winner, Pokemon& loser, bool wild)
+{
+	loser.hp = 1;
+	battle.Start(&winner, 1, &loser, 1, RandomStream(1), wild);
+	BattleAction attack = { BattleActions::FIGHT, 0 };
+	while (GameData::GetMoveInfo(winner.moves[attack.index].index).power <= 1)
+		attack.index++;
+	BattleAction wait = { BattleActions::FIGHT, 0 };
+	while (!battle.IsOver())
+		battle.RunTurn(attack, wait);
+	return battle.GetActive(0);
+}
+
+bool Logged(Battle& battle, unsigned char type, unsigned char value, unsigned short amount)
+{
+	for (unsigned int i = 0; i < battle.GetEventCount(); i++)
+	{
+		BattleEvent& e = battle.GetEvents()[i];
+		if (e.type == type && e.side == 0 && e.value == value && e.amount == amount)
+			return true;
+	}
+	return false;
+}
+
+int main()
+{
+	if (!TestData::Make(DATA_DIR))
+	{
+		cout << "Couldn't write the test data to " << DATA_DIR << ".\nFAILED\n";
+		return 1;
+	}
+	GameData::LoadAll(DATA_DIR);
+	Random::Seed(1);
+
+	//species 1, 4, 5 and 6 cover all four growth rates TestData uses
+	unsigned int wrong = 0;
+	unsigned int cases = 0;
+	const unsigned char species[] = { 1, 4, 5, 6 };
+	for (int s = 0; s < 4; s++)
+	{
+		Pokemon fresh(species[s], 1);
+		for (unsigned char start = 1; start <= 100; start++)
+		{
+			for (unsigned char target = start; target <= 100; target++)
+			{
+				for (unsigned int short_by = 0; short_by <= 1; short_by++)
+				{
+					Pokemon p = fresh;
+					p.level = start;
+					p.xp = Pokemon::GetXPAt(start, p.Species().growth_rate);
+					p.RecalculateStats();
+					p.hp = p.max_hp - 1;
+					unsigned int amount = Pokemon::GetXPAt(target, p.Species().growth_rate) - p.xp - (target > start ? short_by : 0);
+					if (target == 100 && short_by)
+						amount += 1000000; //everything past 100 is thrown away
+					Pokemon slow = p;
+					unsigned char gained = p.AddXP(amount);
+					unsigned char slow_gained = LevelUpSlowly(slow, amount);
+					slow.RecalculateStats();
+					wrong += gained != slow_gained || p.level != slow.level || p.xp != slow.xp || p.max_hp != slow.max_hp || p.attack != slow.attack || p.special != slow.special || p.hp != p.max_hp - 1;
+					cases++;
+				}
+			}
+		}
+	}
+	cout << cases << " level-ups: " << (wrong ? "WRONG" : "same as one level at a time") << "\n";
+	passed &= wrong == 0;
+
+	//a jump from 5 to 17 goes past the move learned at 10 and the evolution at TEST_EVOLUTION_LEVEL
+	Pokemon p(1, 5);
+	const unsigned char* learned;
+	unsigned char from = p.level;
+	Expect("Levels from 5 to 17", p.AddXP(Pokemon::GetXPAt(17, p.Species().growth_rate) - p.xp) == 12 && p.level == 17);
+	unsigned char learned_count = p.Species().GetMovesLearned(from, p.level, &learned);
+	Expect("Moves learned on the way", learned_count == 1 && learned[0] == 0x21);
+	Expect("Evolution at 17", p.Species().GetLevelEvolution(p.level) == 2);
+	Pokemon before(1, 14);
+	before.AddXP(Pokemon::GetXPAt(TEST_EVOLUTION_LEVEL, before.Species().growth_rate) - 1 - before.xp);
+	Expect("No evolution just short of it", before.level == TEST_EVOLUTION_LEVEL - 1 && before.Species().GetLevelEvolution(before.level) == 0);
+	from = p.level;
+	p.AddXP(Pokemon::GetXPAt(25, p.Species().growth_rate) - p.xp);
+	Expect("Moves learned from 17 to 25", p.Species().GetMovesLearned(from, p.level, &learned) == 1 && learned[0] == 0x22);
+	Pokemon top(1, 100);
+	Expect("Nothing at 100", top.AddXP(100000) == 0 && top.level == 100);
+
+	//beating a level 30 pokemon is worth its species' xp * 30 / 7, and half again from a trainer
+	Battle battle;
+	Pokemon winner(1, 20);
+	Pokemon loser(7, 30);
+	unsigned int xp = GameData::GetSpeciesInfo(6).xp_yield * 30 / 7;
+	Expect("Battle::CalculateXP, wild and trainer", Battle::CalculateXP(loser, true) == xp && Battle::CalculateXP(loser, false) == xp + xp / 2);
+	Pokemon& wild_winner = Beat(battle, winner, loser, true);
+	Expect("XP from a wild pokemon", wild_winner.xp == winner.xp + xp && Logged(battle, BattleEvents::XP_GAINED, 0, xp));
+	winner.xp = Pokemon::GetXPAt(22, winner.Species().growth_rate) - 1;
+	Pokemon& trainer_winner = Beat(battle, winner, loser, false);
+	Expect("Level-ups from a trainer's pokemon", trainer_winner.level == 22 && Logged(battle, BattleEvents::XP_GAINED, 0, xp + xp / 2) && Logged(battle, BattleEvents::LEVEL_UP, 22, 0));
+
+	cout << (passed ? "Passed\n" : "FAILED\n");
+	return passed ? 0 : 1;
+}
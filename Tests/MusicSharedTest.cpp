@@ -0,0 +1,96 @@
+#include <iostream>
+#include <cstring>
+
+#include "gme.h"
+#include "Music_Emu.h"
+#include "TestGbs.h"
+
+using namespace std;
+
+//Checks gme_open_shared, which the game doesn't use yet: an emulator sharing another's rom image has to play exactly
+//what the one it came from plays, and what one with its own copy plays. The image is reference counted, so the
+//shared one has to keep playing the same after the emulator it came from is deleted and its memory reused.
+
+#define SAMPLE_RATE 44100
+#define STEREO_SECOND (SAMPLE_RATE * 2)
+
+bool Start(Music_Emu* emu)
+{
+	emu->ignore_silence(true);
+	if (emu->start_track(0))
+		return false;
+	emu->set_fade(10000000); //the default fade start overflows where long is 64 bits, so give it one far away
+	return true;
+}
+
+void Play(Music_Emu* emu, long count, short* samples)
+{
+	while (count > 0)
+	{
+		long n = count < 4096 ? count : 4096;
+		emu->play(n, samples);
+		samples += n;
+		count -= n;
+	}
+}
+
+bool CheckShared(const char* name, const vector<unsigned char>& image)
+{
+	Music_Emu* source = 0;
+	Music_Emu* own = 0;
+	Music_Emu* shared = 0;
+	Music_Emu* shared_again = 0;
+	bool opened = !gme_open_data(&image[0], (long)image.size(), &source, SAMPLE_RATE) && !gme_open_data(&image[0], (long)image.size(), &own, SAMPLE_RATE)
+		&& !gme_open_shared(source, &shared, SAMPLE_RATE) && !gme_open_shared(shared, &shared_again, SAMPLE_RATE)
+		&& Start(source) && Start(own) && Start(shared) && Start(shared_again);
+	bool same = opened;
+	bool audible = false; //silence would match whatever the rom was
+	bool same_after_delete = opened;
+	if (opened)
+	{
+		static short from_source[STEREO_SECOND];
+		static short from_own[STEREO_SECOND];
+		static short from_shared[STEREO_SECOND];
+		Play(source, STEREO_SECOND, from_source);
+		Play(own, STEREO_SECOND, from_own);
+		Play(shared, STEREO_SECOND, from_shared);
+		same = memcmp(from_shared, from_source, sizeof(from_shared)) == 0 && memcmp(from_shared, from_own, sizeof(from_shared)) == 0;
+		for (int i = 0; i < STEREO_SECOND; i++)
+			audible |= from_own[i] != 0;
+
+		//scribble over whatever the source's memory gets reused for
+		delete source;
+		source = 0;
+		vector<unsigned char> junk(image.size() * 4, 0xFF);
+		Play(own, STEREO_SECOND, from_own);
+		Play(shared, STEREO_SECOND, from_shared);
+		same_after_delete = memcmp(from_shared, from_own, sizeof(from_shared)) == 0;
+		//one shared from the shared one, with both before it gone; its second second is the one own just played
+		delete shared;
+		shared = 0;
+		Play(shared_again, STEREO_SECOND, from_shared);
+		Play(shared_again, STEREO_SECOND, from_shared);
+		same_after_delete &= memcmp(from_shared, from_own, sizeof(from_shared)) == 0;
+	}
+	cout << name << ": " << (!opened ? "COULDN'T OPEN" : !audible ? "SILENT" : same ? "same as the source" : "DIFFERENT")
+		<< ", after deleting the source: " << (same_after_delete ? "same" : "DIFFERENT") << "\n";
+	delete source;
+	delete own;
+	delete shared;
+	delete shared_again;
+	return opened && audible && same && same_after_delete;
+}
+
+int main()
+{
+	bool passed = true;
+	for (int seed = 1; seed <= 3; seed++)
+	{
+		cout << "Seed " << seed << " ";
+		passed &= CheckShared("song", TestGbs::MakeSong(seed, 0));
+		cout << "Seed " << seed << " ";
+		passed &= CheckShared("cpu test", TestGbs::Make(seed));
+	}
+	cout << (passed ? "Passed\n" : "FAILED\n");
+	return passed ? 0 : 1;
+}
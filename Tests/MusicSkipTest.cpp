@@ -0,0 +1,152 @@
+#include <iostream>
+#include <cstring>
+#include <chrono>
+
+#include "Gbs_Emu.h"
+#include "TestGbs.h"
+
+using namespace std;
+
+//Checks that Music_Emu::skip() leaves the GBS player exactly where playing the same number of samples and throwing
+//them away would: the second after a skip has to be bit-identical. Long skips take Gb_Apu's fast-forward path and
+//short ones play normally. It's also checked after start_track()'s silence scan has skipped a song's intro. With -b
+//it also times skipping against playing, and the silence scan against a skip over the same intro.
+
+#define SAMPLE_RATE 44100
+#define STEREO_SECOND (SAMPLE_RATE * 2)
+#define INTRO_FRAMES 240 //about 4 seconds, which start_track has to scan through
+#define BENCH_SECONDS 60
+#define BENCH_RUNS 5
+
+//counts are in samples, so they have to be even
+const long skip_counts[] = { 1000, 30002, STEREO_SECOND * 10 + 18, STEREO_SECOND * 45 };
+
+bool Start(Gbs_Emu& emu, const vector<unsigned char>& image, bool ignore_silence)
+{
+	emu.set_sample_rate(SAMPLE_RATE);
+	emu.ignore_silence(ignore_silence);
+	if (emu.load_mem(&image[0], (long)image.size()) || emu.start_track(0))
+		return false;
+	emu.set_fade(10000000); //the default fade start overflows where long is 64 bits, so give it one far away
+	return true;
+}
+
+void Play(Gbs_Emu& emu, long count, short* samples = 0)
+{
+	static short buffer[4096];
+	while (count > 0)
+	{
+		long n = count < 4096 ? count : 4096;
+		emu.play(n, samples ? samples : buffer);
+		if (samples)
+			samples += n;
+		count -= n;
+	}
+}
+
+bool CheckSkip(const char* name, const vector<unsigned char>& image, long skip, bool ignore_silence)
+{
+	Gbs_Emu skipped, played;
+	if (!Start(skipped, image, ignore_silence) || !Start(played, image, ignore_silence))
+	{
+		cout << name << ": couldn't load the test image.\n";
+		return false;
+	}
+	skipped.skip(skip);
+	Play(played, skip);
+
+	static short after_skip[STEREO_SECOND];
+	static short after_play[STEREO_SECOND];
+	Play(skipped, STEREO_SECOND, after_skip);
+	Play(played, STEREO_SECOND, after_play);
+	bool same = skipped.tell() == played.tell() && memcmp(after_skip, after_play, sizeof(after_skip)) == 0;
+	bool audible = false; //two silent seconds would match whatever state the apu was in
+	for (int i = 0; i < STEREO_SECOND; i++)
+		audible |= after_play[i] != 0;
+	cout << name << ", skipping " << skip << " samples: " << (!audible ? "SILENT" : same ? "same" : "DIFFERENT") << "\n";
+	return same && audible;
+}
+
+double TimeSkip(const vector<unsigned char>& image, long count, bool skip)
+{
+	double best = 0;
+	for (int run = 0; run < BENCH_RUNS; run++)
+	{
+		Gbs_Emu emu;
+		Start(emu, image, true);
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		if (skip)
+			emu.skip(count);
+		else
+			Play(emu, count);
+		double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+		if (run == 0 || seconds < best)
+			best = seconds;
+	}
+	return best;
+}
+
+double TimeIntro(const vector<unsigned char>& image, bool scan)
+{
+	double best = 0;
+	for (int run = 0; run < BENCH_RUNS; run++)
+	{
+		Gbs_Emu emu;
+		emu.set_sample_rate(SAMPLE_RATE);
+		emu.ignore_silence(!scan);
+		emu.load_mem(&image[0], (long)image.size());
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		emu.start_track(0);
+		if (!scan)
+			emu.skip(INTRO_FRAMES * STEREO_SECOND / 60);
+		double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+		if (run == 0 || seconds < best)
+			best = seconds;
+	}
+	return best;
+}
+
+int main(int count, char** args)
+{
+	bool bench = count > 1 && strcmp(args[1], "-b") == 0;
+	bool passed = true;
+	for (int seed = 1; seed <= 3; seed++)
+	{
+		vector<unsigned char> song = TestGbs::MakeSong(seed, 0);
+		vector<unsigned char> cpu = TestGbs::Make(seed);
+		vector<unsigned char> intro = TestGbs::MakeSong(seed, INTRO_FRAMES);
+		for (unsigned int i = 0; i < sizeof(skip_counts) / sizeof(skip_counts[0]); i++)
+		{
+			cout << "Seed " << seed << " ";
+			passed &= CheckSkip("song", song, skip_counts[i], true);
+			cout << "Seed " << seed << " ";
+			passed &= CheckSkip("cpu test", cpu, skip_counts[i], true);
+			cout << "Seed " << seed << " ";
+			passed &= CheckSkip("song after its intro", intro, skip_counts[i], false);
+		}
+
+		//the silence scan has to have found where the song starts
+		Gbs_Emu emu;
+		static short first[STEREO_SECOND / 10];
+		bool started = Start(emu, intro, false);
+		Play(emu, STEREO_SECOND / 10, first);
+		bool heard = false;
+		for (int i = 0; i < STEREO_SECOND / 10; i++)
+			heard |= first[i] != 0;
+		cout << "Seed " << seed << " intro: " << (started && heard ? "skipped" : "NOT SKIPPED") << "\n";
+		passed &= started && heard;
+	}
+
+	if (bench)
+	{
+		vector<unsigned char> song = TestGbs::MakeSong(1, 0);
+		vector<unsigned char> intro = TestGbs::MakeSong(1, INTRO_FRAMES);
+		cout.setf(ios::fixed);
+		cout.precision(2);
+		cout << "Skipping " << BENCH_SECONDS << "s: " << TimeSkip(song, BENCH_SECONDS * STEREO_SECOND, true) * 1000 << "ms, playing it: " << TimeSkip(song, BENCH_SECONDS * STEREO_SECOND, false) * 1000 << "ms\n";
+		cout << "Scanning a " << INTRO_FRAMES << " frame intro: " << TimeIntro(intro, true) * 1000 << "ms, skipping it: " << TimeIntro(intro, false) * 1000 << "ms\n";
+	}
+
+	cout << (passed ? "Passed\n" : "FAILED\n");
+	return passed ? 0 : 1;
+}
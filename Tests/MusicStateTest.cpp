@@ -0,0 +1,117 @@
+#include <iostream>
+#include <cstring>
+
+#include "gme.h"
+#include "Gbs_Emu.h"
+#include "TestGbs.h"
+
+using namespace std;
+
+//Checks Music_Emu::save_state and load_state on the GBS player: after a save, another track is started and seeked,
+//then the state is loaded back and the next second has to be bit-identical to the one that followed the save. That
+//covers Gbs_Emu::sync_state_ with Classic_Emu's own Stereo_Buffer, and with the Effects_Buffer gme_new_emu sets up,
+//both plain and with its echo and reverb on. A state from a different file and a truncated one have to be refused.
+
+#define SAMPLE_RATE 44100
+#define STEREO_SECOND (SAMPLE_RATE * 2)
+
+enum Buffers { STEREO_BUFFER, EFFECTS_BUFFER, EFFECTS_BUFFER_ECHO };
+const char* buffer_names[] = { "Stereo_Buffer", "Effects_Buffer", "Effects_Buffer with echo" };
+
+//the test images only have one track, so claim a second one; init doesn't look at which track it was asked for
+vector<unsigned char> TwoTracks(const vector<unsigned char>& image)
+{
+	vector<unsigned char> two = image;
+	two[4] = 2;
+	return two;
+}
+
+Music_Emu* Open(const vector<unsigned char>& image, int buffers)
+{
+	Music_Emu* emu = buffers == STEREO_BUFFER ? new Gbs_Emu : gme_new_emu(gme_gbs_type, SAMPLE_RATE);
+	if (buffers == STEREO_BUFFER)
+		emu->set_sample_rate(SAMPLE_RATE);
+	if (buffers == EFFECTS_BUFFER_ECHO)
+		gme_set_stereo_depth(emu, 0.5);
+	emu->ignore_silence(true);
+	if (emu->load_mem(&image[0], (long)image.size()) || emu->start_track(0))
+	{
+		delete emu;
+		return 0;
+	}
+	emu->set_fade(10000000); //the default fade start overflows where long is 64 bits, so give it one far away
+	return emu;
+}
+
+void Play(Music_Emu* emu, long count, short* samples = 0)
+{
+	static short buffer[4096];
+	while (count > 0)
+	{
+		long n = count < 4096 ? count : 4096;
+		emu->play(n, samples ? samples : buffer);
+		if (samples)
+			samples += n;
+		count -= n;
+	}
+}
+
+bool CheckState(int seed, int buffers)
+{
+	vector<unsigned char> image = TwoTracks(TestGbs::MakeSong(seed, 0));
+	Music_Emu* emu = Open(image, buffers);
+	Music_Emu* other = Open(TwoTracks(TestGbs::Make(seed)), buffers);
+	cout << "Seed " << seed << ", " << buffer_names[buffers] << ": ";
+	if (!emu || !other)
+	{
+		cout << "couldn't load the test image.\n";
+		delete emu;
+		delete other;
+		return false;
+	}
+
+	static short after_save[STEREO_SECOND];
+	static short after_load[STEREO_SECOND];
+	Music_Emu::state_t state;
+	Play(emu, STEREO_SECOND + seed * 1002);
+	blargg_err_t saved = emu->save_state(&state);
+	long saved_at = emu->tell();
+	Play(emu, STEREO_SECOND, after_save);
+
+	emu->start_track(1);
+	emu->set_fade(10000000);
+	emu->seek(20000);
+	Play(emu, STEREO_SECOND / 2);
+	blargg_err_t loaded = emu->load_state(state);
+	bool resumed = !saved && !loaded && emu->current_track() == 0 && emu->tell() == saved_at;
+	Play(emu, STEREO_SECOND, after_load);
+	bool same = memcmp(after_save, after_load, sizeof(after_save)) == 0;
+	bool audible = false; //a silent second would match whatever state the apu was in
+	for (int i = 0; i < STEREO_SECOND; i++)
+		audible |= after_save[i] != 0;
+	cout << (!resumed ? "NOT RESUMED" : !audible ? "SILENT" : same ? "same after loading" : "DIFFERENT") << ", " << state.size() << " bytes\n";
+
+	//only the header is compared, and every song image has the same one, so the other file is a cpu test image
+	bool other_refused = other->load_state(state) != 0;
+	state.truncate(state.size() - 1);
+	bool truncated_refused = emu->load_state(state) != 0;
+	state.truncate(state.size() / 2);
+	truncated_refused &= emu->load_state(state) != 0;
+	cout << "Seed " << seed << ", " << buffer_names[buffers] << ", state from another file: " << (other_refused ? "refused" : "LOADED") << ", truncated state: " << (truncated_refused ? "refused" : "LOADED") << "\n";
+
+	delete emu;
+	delete other;
+	return resumed && audible && same && other_refused && truncated_refused;
+}
+
+int main()
+{
+	bool passed = true;
+	for (int seed = 1; seed <= 3; seed++)
+	{
+		for (int buffers = STEREO_BUFFER; buffers <= EFFECTS_BUFFER_ECHO; buffers++)
+			passed &= CheckState(seed, buffers);
+	}
+	cout << (passed ? "Passed\n" : "FAILED\n");
+	return passed ? 0 : 1;
+}
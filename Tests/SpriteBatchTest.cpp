@@ -0,0 +1,71 @@
+#include <iostream>
+
+#include "SpriteBatch.h"
+
+using namespace std;
+
+//Checks that SpriteBatch only merges quads into one draw when that can't change what ends up on top, and that the
+//batch order comes from the current frame rather than from whichever texture was seen first in an earlier one.
+
+PaletteTexture a;
+PaletteTexture b;
+bool passed = true;
+
+void Expect(const char* name, SpriteBatch& batch, unsigned int quads, PaletteTexture* order0, PaletteTexture* order1, PaletteTexture* order2 = 0)
+{
+	PaletteTexture* order[] = { order0, order1, order2 };
+	unsigned int count = order2 ? 3 : 2;
+	bool same = batch.GetBatchCount() == count && batch.GetQuadCount() == quads;
+	for (unsigned int i = 0; i < count && same; i++)
+		same = batch.GetBatchTexture(i) == order[i];
+
+	cout << name << ": ";
+	for (unsigned int i = 0; i < batch.GetBatchCount(); i++)
+		cout << (batch.GetBatchTexture(i) == &a ? "a " : batch.GetBatchTexture(i) == &b ? "b " : "? ");
+	cout << (same ? "" : "(wrong)") << "\n";
+	passed &= same;
+	batch.Clear();
+}
+
+int main()
+{
+	SpriteBatch batch;
+	sf::IntRect tile(0, 0, 8, 8);
+
+	batch.Add(0, 0, &a, tile);
+	batch.Add(4, 4, &b, tile);
+	Expect("a under b", batch, 2, &a, &b);
+
+	//a's batch is left over from the last frame, but b was added first this time
+	batch.Add(0, 0, &b, tile);
+	batch.Add(4, 4, &a, tile);
+	Expect("b under a", batch, 2, &b, &a);
+
+	//the second a quad is on top of b, so it can't go in the first a batch
+	batch.Add(0, 0, &a, tile);
+	batch.Add(20, 0, &b, tile);
+	batch.Add(24, 4, &a, tile);
+	Expect("a, b, then a over b", batch, 3, &a, &b, &a);
+
+	//nothing overlaps, so both a quads share a batch
+	batch.Add(0, 0, &a, tile);
+	batch.Add(20, 0, &b, tile);
+	batch.Add(40, 0, &a, tile);
+	Expect("a, b and a apart", batch, 3, &a, &b);
+
+	//quads that only share an edge or a corner don't overlap either
+	batch.Add(0, 0, &a, tile);
+	batch.Add(8, 0, &b, tile);
+	batch.Add(16, 0, &a, tile);
+	batch.Add(16, 8, &a, tile);
+	Expect("a, b and a touching", batch, 4, &a, &b);
+
+	//flipped quads cover the same area as unflipped ones
+	batch.Add(0, 0, &a, tile, TileFlags::FLIP_X | TileFlags::FLIP_Y);
+	batch.Add(4, 4, &b, tile, TileFlags::FLIP_X);
+	batch.Add(6, 6, &a, tile, TileFlags::FLIP_Y);
+	Expect("flipped a, b, then a over b", batch, 3, &a, &b, &a);
+
+	cout << (passed ? "Passed\n" : "FAILED\n");
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,184 @@
+#include <iostream>
+#include <cstring>
+#include <chrono>
+
+#include "Pokemon.h"
+#include "Random.h"
+
+using namespace std;
+
+//Checks Pokemon::CalculateStat, CalculateHP and CalculateStatXP against the game's CalcStat, written out the slow way
+//with its square root counting loop. Every base, dv and level is tried with every stat xp value that gives a
+//different bonus. It also pins down how they differ from the float formulas the engine used before: hp is the same
+//and everything else is lower by exactly the level, since the old formula added it twice. Pokemon::GetXPAt is checked
+//against the old pow formulas for every growth rate and level. With -b it times both stat formulas.
+
+#define BENCH_CALLS 1000000
+#define BENCH_RUNS 9
+
+//the game counts up until the square is at least the stat xp, and gives up at 255
+unsigned int GameRoot(unsigned int stat_xp)
+{
+	unsigned int root = 0;
+	while (root < 255 && root * root < stat_xp)
+		root++;
+	return root;
+}
+unsigned int GameStat(unsigned int base, unsigned int dv, unsigned int root, unsigned int level, bool hp)
+{
+	return ((base + dv) * 2 + root / 4) * level / 100 + (hp ? level + 10 : 5);
+}
+
+//what Pokemon.cpp did before the stats were switched to integers
+float OldStatXP(unsigned int xp, unsigned char level)
+{
+	if (xp == 0)
+		return 0;
+	return (float)((sqrt((double)xp - 1.0) + 1.0) * (double)level / 400.0);
+}
+unsigned int OldCalculateStat(unsigned char base, unsigned char dv, unsigned int ev, unsigned char level)
+{
+	return (unsigned int)((float)(base + dv + 50) * (float)level / 50.0f + 5.0f + OldStatXP(ev, level));
+}
+unsigned int OldCalculateHP(unsigned char base, unsigned char dv, unsigned int ev, unsigned char level)
+{
+	return (unsigned int)((float)(base + dv + 50) * (float)level / 50.0f + 10.0f + (float)OldStatXP(ev, level));
+}
+
+//what GetXPAt did before the table, without the cast so the negative medium slow values can be told apart
+double OldXPAt(unsigned char level, unsigned char exp_type)
+{
+	switch (exp_type)
+	{
+	default:
+		return level * level * level;
+	case 3:
+		return ((1.2 * pow(level, 3u)) - (15.0 * pow(level, 2u)) + (100.0 * (double)level - 140.0));
+	case 4:
+		return (unsigned int)(pow(level, 3u) * .8);
+	case 5:
+		return (unsigned int)(pow(level, 3u) * 1.25);
+	}
+}
+
+template<typename F> double Time(F calculate, const unsigned char* bases, const unsigned char* dvs, const unsigned int* stat_xps, const unsigned char* levels)
+{
+	double best = 0;
+	for (int run = 0; run < BENCH_RUNS; run++)
+	{
+		unsigned int sum = 0;
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		for (int i = 0; i < BENCH_CALLS; i++)
+			sum += calculate(bases[i], dvs[i], stat_xps[i], levels[i]);
+		double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+		volatile unsigned int keep = sum;
+		(void)keep;
+		if (run == 0 || seconds < best)
+			best = seconds;
+	}
+	return best * 1000000000 / BENCH_CALLS;
+}
+
+int main(int count, char** args)
+{
+	bool bench = count > 1 && strcmp(args[1], "-b") == 0;
+	bool passed = true;
+
+	//the bonus only changes 64 times over all of stat xp, so the first and last value of each step cover it
+	unsigned int stat_xps[128];
+	unsigned int roots[128];
+	unsigned int stat_xp_count = 0;
+	unsigned int wrong = 0;
+	for (unsigned int stat_xp = 0; stat_xp <= 65535; stat_xp++)
+	{
+		unsigned int bonus = GameRoot(stat_xp) / 4;
+		if (Pokemon::CalculateStatXP(stat_xp) != bonus)
+			wrong++;
+		bool first = stat_xp == 0 || GameRoot(stat_xp - 1) / 4 != bonus;
+		bool last = stat_xp == 65535 || GameRoot(stat_xp + 1) / 4 != bonus;
+		if (first && stat_xp_count < 128)
+		{
+			roots[stat_xp_count] = GameRoot(stat_xp);
+			stat_xps[stat_xp_count++] = stat_xp;
+		}
+		if (last && stat_xp_count < 128)
+		{
+			roots[stat_xp_count] = GameRoot(stat_xp);
+			stat_xps[stat_xp_count++] = stat_xp;
+		}
+	}
+	cout << "Stat xp bonus, 0-65535: " << (wrong ? "WRONG" : "same as the game") << "\n";
+	passed &= wrong == 0 && stat_xp_count == 128;
+
+	static_assert(Pokemon::CalculateStatXP(0) == 0 && Pokemon::CalculateStatXP(1) == 0 && Pokemon::CalculateStatXP(10) == 1 && Pokemon::CalculateStatXP(65535) == 63, "CalculateStatXP has to work at compile time");
+
+	//medium slow goes below zero at levels 0 and 1, which the old cast turned into garbage and the table makes 0
+	unsigned int wrong_xp = 0;
+	unsigned int negative_xp = 0;
+	for (unsigned char exp_type = 0; exp_type < 6; exp_type++)
+	{
+		for (unsigned char level = 0; level <= 100; level++)
+		{
+			double old = OldXPAt(level, exp_type);
+			if (old < 0)
+			{
+				negative_xp++;
+				wrong_xp += exp_type != 3 || level > 1 || Pokemon::GetXPAt(level, exp_type) != 0;
+			}
+			else
+				wrong_xp += Pokemon::GetXPAt(level, exp_type) != (unsigned int)old;
+		}
+	}
+	cout << "XP for every growth rate and level: " << (wrong_xp ? "WRONG" : "same as the old formulas") << ", " << negative_xp << " negative ones now 0\n";
+	passed &= wrong_xp == 0 && negative_xp == 2;
+
+	unsigned int wrong_stats = 0;
+	unsigned int wrong_hp = 0;
+	unsigned int not_old_stats = 0;
+	unsigned int not_old_hp = 0;
+	for (unsigned int base = 0; base < 256; base++)
+	{
+		for (unsigned int dv = 0; dv < 16; dv++)
+		{
+			for (unsigned int level = 1; level <= 100; level++)
+			{
+				for (unsigned int i = 0; i < stat_xp_count; i++)
+				{
+					wrong_stats += Pokemon::CalculateStat(base, dv, stat_xps[i], level) != GameStat(base, dv, roots[i], level, false);
+					wrong_hp += Pokemon::CalculateHP(base, dv, stat_xps[i], level) != GameStat(base, dv, roots[i], level, true);
+				}
+				//without stat xp the old formulas had no float rounding to worry about
+				not_old_stats += Pokemon::CalculateStat(base, dv, 0, level) != OldCalculateStat(base, dv, 0, level) - level;
+				not_old_hp += Pokemon::CalculateHP(base, dv, 0, level) != OldCalculateHP(base, dv, 0, level);
+			}
+		}
+	}
+	cout << "Stats, every base, dv, level and stat xp step: " << (wrong_stats ? "WRONG" : "same as the game") << "\n";
+	cout << "HP, every base, dv, level and stat xp step: " << (wrong_hp ? "WRONG" : "same as the game") << "\n";
+	cout << "Stats without stat xp: " << (not_old_stats ? "NOT" : "exactly") << " the old formula minus the level\n";
+	cout << "HP without stat xp: " << (not_old_hp ? "NOT" : "exactly") << " the old formula\n";
+	passed &= wrong_stats == 0 && wrong_hp == 0 && not_old_stats == 0 && not_old_hp == 0;
+
+	if (bench)
+	{
+		static unsigned char bases[BENCH_CALLS];
+		static unsigned char dvs[BENCH_CALLS];
+		static unsigned int bench_stat_xps[BENCH_CALLS];
+		static unsigned char levels[BENCH_CALLS];
+		RandomStream random(1);
+		for (int i = 0; i < BENCH_CALLS; i++)
+		{
+			bases[i] = random.NextByte();
+			dvs[i] = random.Range(16);
+			bench_stat_xps[i] = random.Range(65536);
+			levels[i] = 1 + random.Range(100);
+		}
+		cout.setf(ios::fixed);
+		cout.precision(2);
+		cout << "CalculateStat: " << Time(Pokemon::CalculateStat, bases, dvs, bench_stat_xps, levels) << "ns, old float version: " << Time(OldCalculateStat, bases, dvs, bench_stat_xps, levels) << "ns\n";
+		cout << "CalculateHP: " << Time(Pokemon::CalculateHP, bases, dvs, bench_stat_xps, levels) << "ns, old float version: " << Time(OldCalculateHP, bases, dvs, bench_stat_xps, levels) << "ns\n";
+	}
+
+	cout << (passed ? "Passed\n" : "FAILED\n");
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <string>
+#include <fstream>
+#include <vector>
+#include <initializer_list>
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+#include "Constants.h"
+#include "TypeChart.h"
+#include "Random.h"
+
+//Writes a small resource directory in the game's file formats, with made up species, moves and trainers, so the
+//battle code can be tested and timed without the dumped resources. GameData::LoadAll(directory) loads it.
+//Every species evolves into the next one at TEST_EVOLUTION_LEVEL, and learns tackle at 10 and body slam at 20.
+#define TEST_EVOLUTION_LEVEL 16
+#define TEST_TRAINER_CLASS 200 //has TEST_TRAINER_PARTIES parties, see Make
+#define TEST_TRAINER_PARTIES 2
+
+class TestData
+{
+public:
+	static bool Make(const std::string& directory)
+	{
+		const char* folders[] = { "", "misc", "pokemon", "pokemon/stats", "pokemon/leveling", "moves", "trainers", "trainers/parties" };
+		for (int i = 0; i < 8; i++)
+			MakeFolder(std::string(directory).append(folders[i]));
+
+		std::vector<unsigned char> ascii;
+		for (int i = 0; i < 256; i++)
+			ascii.push_back(i);
+		bool written = Write(directory + "misc/ascii_table.dat", ascii);
+
+		//created index i is pokedex number i % 151 + 1, and its stats file is named after the pokedex number - 1
+		std::vector<unsigned char> dex_indexes;
+		for (int i = 0; i < 256; i++)
+			dex_indexes.push_back(i % 151 + 1);
+		written &= Write(directory + "pokemon/dex_indexes.dat", dex_indexes);
+		written &= Write(directory + "pokemon/names.dat", Names("MON", 0));
+		written &= Write(directory + "moves/names.dat", Names("MOVE", 1));
+
+		//a type pair and four moves for each kind of species
+		const unsigned char types[12][2] = { { Types::GRASS, Types::POISON }, { Types::FIRE, Types::FIRE }, { Types::WATER, Types::WATER }, { Types::ELECTRIC, Types::ELECTRIC },
+			{ Types::PSYCHIC, Types::PSYCHIC }, { Types::GROUND, Types::ROCK }, { Types::NORMAL, Types::NORMAL }, { Types::GHOST, Types::POISON }, { Types::ICE, Types::FLYING },
+			{ Types::FIGHTING, Types::FIGHTING }, { Types::BUG, Types::FLYING }, { Types::DRAGON, Types::DRAGON } };
+		const unsigned char moves[12][4] = { { 0x4B, 0x4F, 0x21, 0x28 }, { 0x35, 0x21, 0x62, 0xA3 }, { 0x39, 0x3A, 0x21, 0x22 }, { 0x55, 0x56, 0x62, 0x21 },
+			{ 0x5E, 0x56, 0x21, 0x45 }, { 0x59, 0x22, 0x21, 0 }, { 0x22, 0xA3, 0x62, 0x45 }, { 0x7A, 0x5E, 0x28, 0 }, { 0x3A, 0x21, 0x62, 0 },
+			{ 0x45, 0x22, 0x59, 0 }, { 0x8D, 0x21, 0x28, 0 }, { 0x21, 0x22, 0x35, 0x39 } };
+		RandomStream random(1);
+		for (int dex = 0; dex < 256; dex++)
+		{
+			int kind = dex % 12;
+			std::vector<unsigned char> stats;
+			Append(stats, { (unsigned char)(dex + 1) });
+			for (int i = 0; i < 5; i++)
+				stats.push_back((unsigned char)(40 + random.Range(91)));
+			Append(stats, { types[kind][0], types[kind][1], 45, 64, 0x55, moves[kind][0], moves[kind][1], moves[kind][2], moves[kind][3], (unsigned char)(dex % 6 == 1 || dex % 6 == 2 ? 0 : dex % 6) });
+			written &= Write(directory + "pokemon/stats/" + std::to_string(dex) + ".dat", stats);
+		}
+
+		//evolve into the next species, then learn tackle at 10 and body slam at 20
+		for (int i = 0; i < 256; i++)
+		{
+			std::vector<unsigned char> leveling;
+			Append(leveling, { EVOLUTION_LEVEL, TEST_EVOLUTION_LEVEL, (unsigned char)(i + 2 < 256 ? i + 2 : 1), 0, 10, 0x21, 20, 0x22, 0 });
+			written &= Write(directory + "pokemon/leveling/" + std::to_string(i) + ".dat", leveling);
+		}
+
+		//the real effect, power, type, accuracy and pp for the moves the species use, plain 40 power moves for the rest
+		const unsigned char real_moves[][6] = { //id, effect, power, type, accuracy in percent, pp
+			{ 0x21, 0x00, 35, Types::NORMAL, 95, 35 }, { 0x4B, 0x00, 55, Types::GRASS, 95, 25 }, { 0x35, 0x04, 95, Types::FIRE, 100, 15 },
+			{ 0x39, 0x00, 95, Types::WATER, 100, 15 }, { 0x55, 0x06, 95, Types::ELECTRIC, 100, 15 }, { 0x3A, 0x05, 95, Types::ICE, 100, 10 },
+			{ 0x59, 0x00, 100, Types::GROUND, 100, 10 }, { 0x5E, 0x00, 90, Types::PSYCHIC, 100, 10 }, { 0x22, 0x24, 85, Types::NORMAL, 100, 15 },
+			{ 0x56, 0x43, 0, Types::ELECTRIC, 100, 20 }, { 0x4F, 0x20, 0, Types::GRASS, 75, 15 }, { 0x45, 0x29, 1, Types::FIGHTING, 100, 20 },
+			{ 0x62, 0x00, 40, Types::NORMAL, 100, 30 }, { 0xA3, 0x00, 70, Types::NORMAL, 100, 20 }, { 0xA5, 0x30, 50, Types::NORMAL, 100, 10 },
+			{ 0x8D, 0x03, 20, Types::BUG, 100, 15 }, { 0x7A, 0x06, 20, Types::GHOST, 100, 30 }, { 0x28, 0x21, 15, Types::POISON, 100, 35 } };
+		std::vector<unsigned char> move_data;
+		for (int id = 1; id < 256; id++)
+		{
+			unsigned char effect = 0, power = 40, type = (unsigned char)(id % 9 == 6 ? 0 : id % 9), accuracy = 100, pp = 20;
+			for (unsigned int i = 0; i < sizeof(real_moves) / sizeof(real_moves[0]); i++)
+			{
+				if (real_moves[i][0] != id)
+					continue;
+				effect = real_moves[i][1];
+				power = real_moves[i][2];
+				type = real_moves[i][3];
+				accuracy = real_moves[i][4];
+				pp = real_moves[i][5];
+			}
+			Append(move_data, { (unsigned char)id, effect, power, type, (unsigned char)(accuracy * 255 / 100), pp });
+		}
+		written &= Write(directory + "moves/moves.dat", move_data);
+
+		//one party with a shared level, one with a level per pokemon
+		std::vector<unsigned char> parties;
+		Append(parties, { 12, 4, 7, 0, 0xFF, 20, 25, 22, 26, 24, 28, 0 });
+		written &= Write(directory + "trainers/parties/" + std::to_string(TEST_TRAINER_CLASS) + ".dat", parties);
+		return written;
+	}
+
+private:
+	static void MakeFolder(const std::string& path)
+	{
+#ifdef _WIN32
+		_mkdir(path.c_str());
+#else
+		mkdir(path.c_str(), 0755);
+#endif
+	}
+	static bool Write(const std::string& filename, const std::vector<unsigned char>& data)
+	{
+		std::ofstream f(filename.c_str(), std::ios::binary);
+		f.write((const char*)&data[0], data.size());
+		return f.good();
+	}
+	static void Append(std::vector<unsigned char>& data, std::initializer_list<unsigned char> bytes) { data.insert(data.end(), bytes.begin(), bytes.end()); }
+	static std::vector<unsigned char> Names(const char* prefix, int first) //256 names, each ended by MESSAGE_ENDNAME
+	{
+		std::vector<unsigned char> names;
+		for (int i = first; i < first + 256; i++)
+		{
+			std::string name = std::string(prefix) + std::to_string(i);
+			names.insert(names.end(), name.begin(), name.end());
+			names.push_back(MESSAGE_ENDNAME);
+		}
+		return names;
+	}
+};
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <vector>
+#include <initializer_list>
+#include "Random.h"
+
+//Builds a GBS file in memory whose play routine runs a few thousand random but legal instructions: loads, ALU ops,
+//CB ops, the stack and branches, with the results written to the sound registers. Anything the CPU gets wrong ends
+//up in the audio, so the audio can be hashed to compare two builds. The same seed always gives the same file.
+class TestGbs
+{
+public:
+	static std::vector<unsigned char> Make(unsigned long long seed)
+	{
+		RandomStream random(seed);
+		std::vector<unsigned char> code;
+		const unsigned short load = 0x400;
+
+		//init: turn the sound on and start both square channels
+		Emit(code, { 0x3E, 0x80, 0xE0, 0x26, 0x3E, 0x77, 0xE0, 0x24, 0x3E, 0xFF, 0xE0, 0x25 });
+		const unsigned char init_regs[8][2] = { { 0x11, 0x80 }, { 0x12, 0xF0 }, { 0x13, 0x00 }, { 0x14, 0x87 }, { 0x16, 0x80 }, { 0x17, 0xF0 }, { 0x18, 0x40 }, { 0x19, 0x86 } };
+		for (int i = 0; i < 8; i++)
+			Emit(code, { 0x3E, init_regs[i][1], 0xE0, init_regs[i][0] });
+		Emit(code, { 0xC9 });
+
+		unsigned short play = load + (unsigned short)code.size();
+		std::vector<unsigned char> simple; //one byte instructions that can't jump, halt or move the stack
+		for (int op = 0x40; op < 0xC0; op++)
+		{
+			if (op != 0x76 && op != 0xBF)
+				simple.push_back(op);
+		}
+		const unsigned char others[] = { 0x04, 0x05, 0x0C, 0x0D, 0x14, 0x15, 0x1C, 0x1D, 0x24, 0x25, 0x2C, 0x2D, 0x3C, 0x3D, 0x03, 0x13, 0x23, 0x0B, 0x1B, 0x2B,
+			0x07, 0x0F, 0x17, 0x1F, 0x2F, 0x37, 0x3F, 0x09, 0x19, 0x29, 0x39, 0x34, 0x35, 0x22, 0x2A, 0x32, 0x3A, 0x02, 0x0A, 0x12, 0x1A, 0x00, 0xF3, 0xFB };
+		simple.insert(simple.end(), others, others + sizeof(others));
+		const unsigned char immediates[] = { 0x06, 0x0E, 0x16, 0x1E, 0x26, 0x2E, 0x36, 0x3E, 0xC6, 0xCE, 0xD6, 0xDE, 0xE6, 0xEE, 0xF6, 0xFE, 0xF8 };
+
+		for (int block = 0; block < 40; block++)
+		{
+			//point HL, BC and DE at ram before anything reads or writes through them
+			Emit(code, { 0x21, 0x00, RamPage(random) });
+			Emit(code, { 0x01, random.NextByte(), RamPage(random) });
+			Emit(code, { 0x11, random.NextByte(), RamPage(random) });
+			unsigned int count = 10 + random.Range(20);
+			for (unsigned int i = 0; i < count; i++)
+			{
+				unsigned int kind = random.Range(10);
+				unsigned char op;
+				unsigned char operand = random.NextByte();
+				bool has_operand = true;
+				if (kind < 6)
+				{
+					op = simple[random.Range((unsigned int)simple.size())];
+					has_operand = false;
+				}
+				else if (kind < 8)
+					op = immediates[random.Range(sizeof(immediates))];
+				else
+					op = 0xCB;
+
+				bool uses_hl = op == 0x34 || op == 0x35 || op == 0x36 || op == 0x22 || op == 0x32 || op == 0x2A || op == 0x3A || (op >= 0x70 && op <= 0x77) || (op == 0xCB && (operand & 7) == 6);
+				if (uses_hl)
+					Emit(code, { 0x21, random.NextByte(), RamPage(random) });
+				if (op == 0x02)
+					Emit(code, { 0x01, random.NextByte(), RamPage(random) });
+				if (op == 0x12)
+					Emit(code, { 0x11, random.NextByte(), RamPage(random) });
+				code.push_back(op);
+				if (has_operand)
+					code.push_back(operand);
+			}
+
+			//play whatever ended up in A on one of the square channels
+			unsigned char reg = random.Range(2) ? 0x13 : 0x18;
+			Emit(code, { 0xE0, reg, 0x3E, 0x86, 0xE0, (unsigned char)(reg + 1) });
+			//a short loop through jr, push and pop
+			Emit(code, { 0x06, (unsigned char)(1 + random.Range(7)), 0xC5, 0xD5, 0xE5, 0xF5, 0xF1, 0xE1, 0xD1, 0xC1, 0x05, 0x20, 0xF5 });
+		}
+		//run the whole thing 256 times per play call, counting down in D000
+		Emit(code, { 0x21, 0x00, 0xD0, 0x35, 0xC2, (unsigned char)(play & 0xFF), (unsigned char)(play >> 8) });
+		Emit(code, { 0x3E, 0x87, 0xE0, 0x14, 0x3E, 0x87, 0xE0, 0x19, 0xC9 });
+
+		return Header(load, play, code);
+	}
+
+	//Builds a GBS file that plays like a music driver: after intro_frames of silence, every 32 frames it writes the next
+	//of 64 random rows to the registers of all four channels, usually retriggering them. The rows use every duty,
+	//envelope, wave volume and noise mode, so the whole APU gets exercised. Rows are far enough apart that a retrigger
+	//can't hide a wrong wave position or noise shift register in the output.
+	static std::vector<unsigned char> MakeSong(unsigned long long seed, unsigned char intro_frames)
+	{
+		RandomStream random(seed);
+		std::vector<unsigned char> code;
+		const unsigned short load = 0x400;
+		const unsigned char row_regs[15] = { 0x10, 0x11, 0x12, 0x13, 0x14, 0x16, 0x17, 0x18, 0x19, 0x1C, 0x1D, 0x1E, 0x21, 0x22, 0x23 };
+
+		//init: turn the sound on, fill wave ram, turn the wave channel's dac on and set up the counters in C000-C002
+		Emit(code, { 0x3E, 0x80, 0xE0, 0x26, 0x3E, 0x77, 0xE0, 0x24, 0x3E, 0xFF, 0xE0, 0x25 });
+		for (unsigned char i = 0; i < 16; i++)
+			Emit(code, { 0x3E, random.NextByte(), 0xE0, (unsigned char)(0x30 + i) });
+		Emit(code, { 0x3E, 0x80, 0xE0, 0x1A });
+		Emit(code, { 0xAF, 0xEA, 0x00, 0xC0, 0xEA, 0x02, 0xC0, 0x3E, intro_frames, 0xEA, 0x01, 0xC0, 0xC9 });
+
+		unsigned short play = load + (unsigned short)code.size();
+		//count down the intro in C001, then count frames in C000 and only go on every 32nd one
+		Emit(code, { 0x21, 0x01, 0xC0, 0x7E, 0xA7, 0x28, 0x02, 0x35, 0xC9 });
+		Emit(code, { 0x21, 0x00, 0xC0, 0x34, 0x7E, 0xE6, 0x1F, 0xC0 });
+		//hl = rows + (row in C002 & 63) * 16
+		unsigned short rows_fixup = (unsigned short)code.size() + 17;
+		Emit(code, { 0x2C, 0x2C, 0x7E, 0x34, 0xE6, 0x3F, 0x6F, 0x26, 0x00, 0x29, 0x29, 0x29, 0x29, 0x11, 0x00, 0x00, 0x19 });
+		for (int i = 0; i < 15; i++)
+			Emit(code, { 0x2A, 0xE0, row_regs[i] });
+		Emit(code, { 0xC9 });
+
+		unsigned short rows = load + (unsigned short)code.size();
+		code[rows_fixup - 3] = rows & 0xFF;
+		code[rows_fixup - 2] = rows >> 8;
+		for (int row = 0; row < 64; row++)
+		{
+			unsigned char trigger1 = (unsigned char)(0x80 | random.Range(2) << 6 | random.Range(8));
+			unsigned char trigger2 = (unsigned char)(0x80 | random.Range(2) << 6 | random.Range(8));
+			unsigned char trigger3 = (unsigned char)((random.Range(4) ? 0x80 : 0) | random.Range(2) << 6 | random.Range(8));
+			unsigned char trigger4 = (unsigned char)(random.Range(4) ? 0x80 : 0);
+			unsigned char noise_envelope = (unsigned char)(0x80 | random.Range(16) << 3); //no envelope, so the noise is still going when a skip ends
+			Emit(code, { (unsigned char)(random.Range(4) ? 0 : random.NextByte() & 0x7F), random.NextByte(), (unsigned char)(0x80 + random.Range(128)), random.NextByte(), trigger1,
+				random.NextByte(), (unsigned char)(0x80 + random.Range(128)), random.NextByte(), trigger2,
+				(unsigned char)(random.Range(4) << 5), random.NextByte(), trigger3,
+				noise_envelope, random.NextByte(), trigger4, 0 });
+		}
+		return Header(load, play, code);
+	}
+
+	//FNV-1a over a buffer of samples
+	static unsigned long long Hash(const short* samples, long count, unsigned long long hash = 14695981039346656037ULL)
+	{
+		for (long i = 0; i < count; i++)
+			hash = (hash ^ (unsigned short)samples[i]) * 1099511628211ULL;
+		return hash;
+	}
+
+private:
+	static void Emit(std::vector<unsigned char>& code, std::initializer_list<unsigned char> bytes) { code.insert(code.end(), bytes.begin(), bytes.end()); }
+	static unsigned char RamPage(RandomStream& random) { return (unsigned char)(0xC0 + random.Range(16)); }
+	static std::vector<unsigned char> Header(unsigned short load, unsigned short play, const std::vector<unsigned char>& code)
+	{
+		std::vector<unsigned char> file(112, 0);
+		file[0] = 'G';
+		file[1] = 'B';
+		file[2] = 'S';
+		file[3] = 1; //version
+		file[4] = 1; //track count
+		file[5] = 1; //first track
+		SetWord(file, 6, load);
+		SetWord(file, 8, load); //init
+		SetWord(file, 10, play);
+		SetWord(file, 12, 0xFFFE); //stack
+		file.insert(file.end(), code.begin(), code.end());
+		return file;
+	}
+	static void SetWord(std::vector<unsigned char>& file, int offset, unsigned short value)
+	{
+		file[offset] = value & 0xFF;
+		file[offset + 1] = value >> 8;
+	}
+};
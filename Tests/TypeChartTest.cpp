@@ -0,0 +1,89 @@
+#include <iostream>
+
+#include "TypeChart.h"
+
+using namespace std;
+
+//Checks the type tables in TypeChart.h against the chart scan the battle code used before them, which went through
+//its own copy of the chart in order and applied every entry whose attacking type matched and whose defending type
+//was either of the defender's. type_effectiveness is checked for every pair of type bytes, and GetTypeMultipliers for
+//every move type against every pair of defending types, applied to every damage the formula can give before its
+//type step.
+
+#define MAX_DAMAGE 1500 //999 + 2, then half again for the same type bonus
+
+//the chart and the scan from Battle.cpp before the tables, on type ids rather than type indexes
+const TypeMatchup baseline_chart[] =
+{
+	{ WATER, FIRE, 20 }, { FIRE, GRASS, 20 }, { FIRE, ICE, 20 }, { GRASS, WATER, 20 }, { ELECTRIC, WATER, 20 }, { WATER, ROCK, 20 },
+	{ GROUND, FLYING, 0 }, { WATER, WATER, 5 }, { FIRE, FIRE, 5 }, { ELECTRIC, ELECTRIC, 5 }, { ICE, ICE, 5 }, { GRASS, GRASS, 5 },
+	{ PSYCHIC, PSYCHIC, 5 }, { FIRE, WATER, 5 }, { GRASS, FIRE, 5 }, { WATER, GRASS, 5 }, { ELECTRIC, GRASS, 5 }, { NORMAL, ROCK, 5 },
+	{ NORMAL, GHOST, 0 }, { GHOST, GHOST, 20 }, { FIRE, BUG, 20 }, { FIRE, ROCK, 5 }, { WATER, GROUND, 20 }, { ELECTRIC, GROUND, 0 },
+	{ ELECTRIC, FLYING, 20 }, { GRASS, GROUND, 20 }, { GRASS, BUG, 5 }, { GRASS, POISON, 5 }, { GRASS, ROCK, 20 }, { GRASS, FLYING, 5 },
+	{ ICE, WATER, 5 }, { ICE, GRASS, 20 }, { ICE, GROUND, 20 }, { ICE, FLYING, 20 }, { FIGHTING, NORMAL, 20 }, { FIGHTING, POISON, 5 },
+	{ FIGHTING, FLYING, 5 }, { FIGHTING, PSYCHIC, 5 }, { FIGHTING, BUG, 5 }, { FIGHTING, ROCK, 20 }, { FIGHTING, ICE, 20 }, { FIGHTING, GHOST, 0 },
+	{ POISON, GRASS, 20 }, { POISON, POISON, 5 }, { POISON, GROUND, 5 }, { POISON, BUG, 20 }, { POISON, ROCK, 5 }, { POISON, GHOST, 5 },
+	{ GROUND, FIRE, 20 }, { GROUND, ELECTRIC, 20 }, { GROUND, GRASS, 5 }, { GROUND, BUG, 5 }, { GROUND, ROCK, 20 }, { GROUND, POISON, 20 },
+	{ FLYING, ELECTRIC, 5 }, { FLYING, FIGHTING, 20 }, { FLYING, BUG, 20 }, { FLYING, GRASS, 20 }, { FLYING, ROCK, 5 }, { PSYCHIC, FIGHTING, 20 },
+	{ PSYCHIC, POISON, 20 }, { BUG, FIRE, 5 }, { BUG, GRASS, 20 }, { BUG, FIGHTING, 5 }, { BUG, FLYING, 5 }, { BUG, PSYCHIC, 20 },
+	{ BUG, GHOST, 5 }, { BUG, POISON, 20 }, { ROCK, FIRE, 20 }, { ROCK, FIGHTING, 5 }, { ROCK, GROUND, 5 }, { ROCK, FLYING, 20 },
+	{ ROCK, BUG, 20 }, { ROCK, ICE, 20 }, { GHOST, NORMAL, 0 }, { GHOST, PSYCHIC, 0 }, { FIRE, DRAGON, 5 }, { WATER, DRAGON, 5 },
+	{ ELECTRIC, DRAGON, 5 }, { GRASS, DRAGON, 5 }, { ICE, DRAGON, 20 }, { DRAGON, DRAGON, 20 },
+};
+
+unsigned int ScanChart(unsigned char attacking, unsigned char type1, unsigned char type2, unsigned int damage)
+{
+	for (unsigned int i = 0; i < sizeof(baseline_chart) / sizeof(TypeMatchup); i++)
+	{
+		const TypeMatchup& t = baseline_chart[i];
+		if (t.attacking == attacking && (t.defending == type1 || t.defending == type2))
+			damage = damage * t.multiplier / 10;
+	}
+	return damage;
+}
+
+int main()
+{
+	bool passed = true;
+
+	//every byte a move or species type could be, which covers all 15x15 real pairs and everything mapped to TYPE_COUNT
+	unsigned int wrong = 0;
+	for (unsigned int attacking = 0; attacking < 256; attacking++)
+	{
+		for (unsigned int defending = 0; defending < 256; defending++)
+			wrong += type_effectiveness[GetTypeIndex(attacking)][GetTypeIndex(defending)] != ScanChart(attacking, defending, defending, TYPE_NEUTRAL);
+	}
+	cout << "type_effectiveness, every attacking and defending byte: " << (wrong ? "WRONG" : "same as the chart") << "\n";
+	passed &= wrong == 0;
+
+	//the real types, plus ids that aren't types: the gaps, the unused bird type and one past the end
+	unsigned char types[] = { NORMAL, FIGHTING, FLYING, POISON, GROUND, ROCK, BUG, GHOST, FIRE, WATER, GRASS, ELECTRIC, PSYCHIC, ICE, DRAGON, 6, 9, 0x13, 0x1B, 0xFF };
+	unsigned int type_count = sizeof(types) / sizeof(types[0]);
+	unsigned int wrong_products = 0;
+	unsigned int wrong_damage = 0;
+	unsigned int cases = 0;
+	for (unsigned int a = 0; a < type_count; a++)
+	{
+		for (unsigned int t1 = 0; t1 < type_count; t1++)
+		{
+			for (unsigned int t2 = 0; t2 < type_count; t2++)
+			{
+				unsigned char multipliers[2];
+				GetTypeMultipliers(GetTypeIndex(types[a]), types[t1], types[t2], multipliers);
+				wrong_products += (unsigned int)multipliers[0] * multipliers[1] != ScanChart(types[a], types[t1], types[t2], 100);
+
+				//the game rounds down after each multiplier, so the order they come back in matters too
+				for (unsigned int damage = 0; damage <= MAX_DAMAGE; damage++)
+					wrong_damage += damage * multipliers[0] / TYPE_NEUTRAL * multipliers[1] / TYPE_NEUTRAL != ScanChart(types[a], types[t1], types[t2], damage);
+				cases += MAX_DAMAGE + 2;
+			}
+		}
+	}
+	cout << "GetTypeMultipliers products, every move type against every pair: " << (wrong_products ? "WRONG" : "same as the chart") << "\n";
+	cout << "GetTypeMultipliers applied in order to damage 0-" << MAX_DAMAGE << ": " << (wrong_damage ? "WRONG" : "same as the chart") << "\n";
+	cout << cases + 65536 << " cases\n";
+	passed &= wrong_products == 0 && wrong_damage == 0;
+
+	cout << (passed ? "Passed\n" : "FAILED\n");
+	return passed ? 0 : 1;
+}
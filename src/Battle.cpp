@@ -0,0 +1,517 @@
+#include "Battle.h"
+#include <cstring>
+#include <algorithm>
+
+//moves that get special treatment
+#define MOVE_KARATE_CHOP	0x02
+#define MOVE_SONIC_BOOM		0x31
+#define MOVE_COUNTER		0x44
+#define MOVE_RAZOR_LEAF		0x4B
+#define MOVE_DRAGON_RAGE	0x52
+#define MOVE_QUICK_ATTACK	0x62
+#define MOVE_PSYWAVE		0x95
+#define MOVE_CRABHAMMER		0x98
+#define MOVE_SLASH			0xA3
+#define MOVE_STRUGGLE		0xA5
+
+void Battle::Start(const Pokemon* party0, unsigned char count0, const Pokemon* party1, unsigned char count1, const RandomStream& random, bool wild)
+{
+	const Pokemon* parties[2] = { party0, party1 };
+	unsigned char counts[2] = { std::min(count0, (unsigned char)6), std::min(count1, (unsigned char)6) };
+
+	this->random = random;
+	event_count = 0;
+	this->wild = wild;
+	over = false;
+	winner = BATTLE_NO_WINNER;
+	escape_attempts = 0;
+	turn = 0;
+
+	for (int s = 0; s < 2; s++)
+	{
+		BattleSide& side = sides[s];
+		memcpy(side.party, parties[s], counts[s] * sizeof(Pokemon));
+		side.party_count = counts[s];
+		side.active = 0;
+		for (int i = 0; i < 6; i++)
+			side.sleep_turns[i] = i < counts[s] && side.party[i].status == Statuses::SLEEPING ? Random() % 7 + 1 : 0;
+	}
+
+	if (!HasHealthyPokemon(0) || !HasHealthyPokemon(1))
+	{
+		over = true;
+		winner = HasHealthyPokemon(0) ? 0 : 1;
+		Log(BattleEvents::WON, winner);
+		return;
+	}
+	for (int s = 0; s < 2; s++)
+	{
+		while (sides[s].party[sides[s].active].hp == 0)
+			sides[s].active++;
+		Log(BattleEvents::SENT_OUT, s, sides[s].active);
+	}
+}
+
+void Battle::RunTurn(BattleAction action0, BattleAction action1)
+{
+	event_count = 0;
+	if (over)
+		return;
+	turn++;
+
+	BattleAction actions[2] = { action0, action1 };
+	unsigned char first = MovesFirst(0, actions) ? 0 : 1;
+	for (int i = 0; i < 2 && !over; i++)
+	{
+		unsigned char side = i == 0 ? first : first ^ 1;
+		switch (actions[side].type)
+		{
+		case BattleActions::FIGHT:
+			UseMove(side, actions[side].index);
+			break;
+		case BattleActions::SWITCH:
+			SwitchTo(side, actions[side].index);
+			break;
+		case BattleActions::RUN:
+			TryEscape(side);
+			break;
+		}
+	}
+
+	if (!over)
+		EndTurn();
+}
+
+void Battle::Reseed(unsigned int seed)
+{
+	random.Seed(seed);
+}
+
+BattleAction Battle::ChooseRandomMove(unsigned char side)
+{
+	BattleAction action = { BattleActions::FIGHT, 0 };
+	if (!HasUsableMove(side))
+		return action; //struggle
+	do
+		action.index = Random() & 3;
+	while (!CanUseMove(side, action.index));
+	return action;
+}
+
+bool Battle::CanUseMove(unsigned char side, unsigned char slot)
+{
+	Move& m = GetActive(side).moves[slot & 3];
+	return m.index != 0 && m.pp > 0;
+}
+
+bool Battle::HasUsableMove(unsigned char side)
+{
+	for (int i = 0; i < 4; i++)
+	{
+		if (CanUseMove(side, i))
+			return true;
+	}
+	return false;
+}
+
+unsigned int Battle::CalculateDamage(const Pokemon& attacker, const Pokemon& defender, const MoveInfo& move, bool critical, unsigned char roll)
+{
+	SpeciesInfo& attacker_species = GameData::GetSpeciesInfo(attacker.id - 1);
+	SpeciesInfo& defender_species = GameData::GetSpeciesInfo(defender.id - 1);
+
+	bool special = IsSpecialType(move.type);
+	unsigned int a = special ? attacker.special : attacker.attack;
+	unsigned int d = special ? defender.special : defender.defense;
+	if (!critical && !special && attacker.status == Statuses::BURNED)
+		a /= 2;
+	if (move.effect == MoveEffects::EXPLODE)
+		d /= 2;
+	//the game only has a byte for each, so big stats get scaled down together
+	if (a > 255 || d > 255)
+	{
+		a /= 4;
+		d /= 4;
+	}
+	a = std::max(a, 1u);
+	d = std::max(d, 1u);
+
+	unsigned int level = critical ? attacker.level * 2 : attacker.level;
+	unsigned int damage = (level * 2 / 5 + 2) * move.power * a / d / 50;
+	damage = std::min(damage, 997u) + 2;
+
+	if (move.type == attacker_species.type1 || move.type == attacker_species.type2)
+		damage += damage / 2;
+	const unsigned char* multipliers = defender_species.type_multipliers[GetTypeIndex(move.type)];
+	damage = damage * multipliers[0] / TYPE_NEUTRAL;
+	damage = damage * multipliers[1] / TYPE_NEUTRAL;
+
+	if (damage > 1)
+		damage = damage * roll / 255;
+	return damage;
+}
+
+unsigned int Battle::CalculateXP(const Pokemon& defeated, bool wild)
+{
+	unsigned int xp = GameData::GetSpeciesInfo(defeated.id - 1).xp_yield * defeated.level / 7;
+	return wild ? xp : xp + xp / 2;
+}
+
+unsigned char Battle::Random()
+{
+	return random.NextByte();
+}
+
+void Battle::Log(unsigned char type, unsigned char side, unsigned char value, unsigned short amount)
+{
+	if (event_count >= BATTLE_MAX_EVENTS)
+		return;
+	BattleEvent& e = events[event_count++];
+	e.type = type;
+	e.side = side;
+	e.value = value;
+	e.amount = amount;
+}
+
+bool Battle::MovesFirst(unsigned char side, BattleAction* actions)
+{
+	unsigned char other = side ^ 1;
+	//switching and running always happen before moves
+	if (actions[side].type != BattleActions::FIGHT || actions[other].type != BattleActions::FIGHT)
+		return actions[side].type != BattleActions::FIGHT;
+
+	int priority[2];
+	for (int s = 0; s < 2; s++)
+	{
+		unsigned char id = GetActive(s).moves[actions[s].index & 3].index;
+		priority[s] = id == MOVE_QUICK_ATTACK ? 1 : (id == MOVE_COUNTER ? -1 : 0);
+	}
+	if (priority[side] != priority[other])
+		return priority[side] > priority[other];
+
+	unsigned int speed = GetSpeed(GetActive(side));
+	unsigned int other_speed = GetSpeed(GetActive(other));
+	if (speed != other_speed)
+		return speed > other_speed;
+	return Random() < 128;
+}
+
+bool Battle::CanAct(unsigned char side)
+{
+	Pokemon& p = GetActive(side);
+	unsigned char& sleep = sides[side].sleep_turns[sides[side].active];
+	switch (p.status)
+	{
+	case Statuses::SLEEPING:
+		//waking up takes the whole turn
+		if (sleep > 0)
+			sleep--;
+		if (sleep == 0)
+		{
+			p.status = Statuses::OK;
+			Log(BattleEvents::WOKE_UP, side);
+		}
+		else
+			Log(BattleEvents::FAST_ASLEEP, side);
+		return false;
+	case Statuses::FROZEN:
+		Log(BattleEvents::FROZEN_SOLID, side);
+		return false;
+	case Statuses::PARALYZED:
+		if (Random() < 64)
+		{
+			Log(BattleEvents::FULLY_PARALYZED, side);
+			return false;
+		}
+		break;
+	}
+	return true;
+}
+
+void Battle::UseMove(unsigned char side, unsigned char slot)
+{
+	unsigned char target = side ^ 1;
+	Pokemon& attacker = GetActive(side);
+	Pokemon& defender = GetActive(target);
+	//nobody moves once someone has fainted this turn
+	if (attacker.hp == 0 || defender.hp == 0 || !CanAct(side))
+		return;
+
+	//struggle when every move is out of pp
+	unsigned char id = MOVE_STRUGGLE;
+	if (HasUsableMove(side))
+	{
+		Move& m = attacker.moves[slot & 3];
+		if (m.index == 0 || m.pp == 0)
+		{
+			Log(BattleEvents::NO_PP, side);
+			return;
+		}
+		m.pp--;
+		id = m.index;
+	}
+	const MoveInfo& move = GameData::GetMoveInfo(id);
+	Log(BattleEvents::USED_MOVE, side, id);
+
+	HitWithMove(side, id, move);
+
+	//the user faints even if it missed
+	if (move.effect == MoveEffects::EXPLODE && attacker.hp > 0)
+		DealDamage(side, attacker.hp);
+}
+
+void Battle::HitWithMove(unsigned char side, unsigned char id, const MoveInfo& move)
+{
+	unsigned char target = side ^ 1;
+	Pokemon& attacker = GetActive(side);
+	Pokemon& defender = GetActive(target);
+	SpeciesInfo& species = defender.Species();
+	const unsigned char* multipliers = species.type_multipliers[GetTypeIndex(move.type)];
+	unsigned int effectiveness = multipliers[0] * multipliers[1];
+
+	bool attacks = move.power > 0 || move.effect == MoveEffects::SPECIAL_DAMAGE;
+	if ((attacks || move.effect == MoveEffects::PARALYZE) && effectiveness == 0 && move.effect != MoveEffects::SPECIAL_DAMAGE)
+	{
+		Log(BattleEvents::NO_EFFECT, target);
+		return;
+	}
+	if (move.effect == MoveEffects::DREAM_EATER && defender.status != Statuses::SLEEPING)
+	{
+		Log(BattleEvents::FAILED, side);
+		return;
+	}
+	if (move.effect != MoveEffects::SWIFT && Random() >= move.accuracy)
+	{
+		Log(BattleEvents::MISSED, side);
+		return;
+	}
+
+	switch (move.effect)
+	{
+	case MoveEffects::SPECIAL_DAMAGE:
+		switch (id)
+		{
+		case MOVE_SONIC_BOOM:
+			DealDamage(target, 20);
+			break;
+		case MOVE_DRAGON_RAGE:
+			DealDamage(target, 40);
+			break;
+		case MOVE_PSYWAVE:
+			DealDamage(target, std::max(1, Random() % (attacker.level * 3 / 2 + 1)));
+			break;
+		default: //seismic toss, night shade
+			DealDamage(target, attacker.level);
+			break;
+		}
+		return;
+	case MoveEffects::SUPER_FANG:
+		DealDamage(target, std::max(1, defender.hp / 2));
+		return;
+	case MoveEffects::OHKO:
+		if (GetSpeed(attacker) < GetSpeed(defender))
+			Log(BattleEvents::FAILED, side);
+		else
+			DealDamage(target, defender.hp);
+		return;
+	}
+
+	if (move.power == 0)
+	{
+		switch (move.effect)
+		{
+		case MoveEffects::SLEEP:
+		case MoveEffects::POISON:
+		case MoveEffects::PARALYZE:
+			if (defender.status != Statuses::OK || (move.effect == MoveEffects::POISON && (species.type1 == POISON || species.type2 == POISON)))
+				Log(BattleEvents::FAILED, side);
+			else
+				SetStatus(target, move.effect == MoveEffects::SLEEP ? Statuses::SLEEPING : (move.effect == MoveEffects::POISON ? Statuses::POISONED : Statuses::PARALYZED));
+			break;
+		default:
+			Log(BattleEvents::FAILED, side);
+			break;
+		}
+		return;
+	}
+
+	//high critical hit moves get 8 times the chance
+	unsigned int base_speed = attacker.Species().base_speed;
+	bool high_critical = id == MOVE_KARATE_CHOP || id == MOVE_RAZOR_LEAF || id == MOVE_CRABHAMMER || id == MOVE_SLASH;
+	bool critical = Random() < (high_critical ? std::min(base_speed * 4, 255u) : base_speed / 2);
+	unsigned char roll = 217 + Random() % 39;
+	unsigned int damage = CalculateDamage(attacker, defender, move, critical, roll);
+	if (damage == 0)
+	{
+		Log(BattleEvents::MISSED, side);
+		return;
+	}
+
+	unsigned int dealt = DealDamage(target, damage);
+	if (critical)
+		Log(BattleEvents::CRITICAL_HIT, target);
+	if (effectiveness != 100)
+		Log(BattleEvents::EFFECTIVENESS, target, (unsigned char)std::min(effectiveness, 255u));
+
+	switch (move.effect)
+	{
+	case MoveEffects::DRAIN_HP:
+	case MoveEffects::DREAM_EATER:
+	{
+		unsigned short healed = (unsigned short)std::min(std::max(dealt / 2, 1u), (unsigned int)(attacker.max_hp - attacker.hp));
+		attacker.hp += healed;
+		Log(BattleEvents::HEALED, side, 0, healed);
+		break;
+	}
+	case MoveEffects::RECOIL:
+		DealDamage(side, std::max(dealt / (id == MOVE_STRUGGLE ? 2 : 4), 1u));
+		break;
+	default:
+		if (defender.hp > 0)
+			ApplySideEffect(target, move);
+		break;
+	}
+
+	//fire moves thaw the target out
+	if (move.type == FIRE && defender.hp > 0 && defender.status == Statuses::FROZEN)
+	{
+		defender.status = Statuses::OK;
+		Log(BattleEvents::THAWED, target);
+	}
+}
+
+unsigned int Battle::DealDamage(unsigned char side, unsigned int damage, unsigned char event)
+{
+	Pokemon& p = GetActive(side);
+	unsigned short lost = (unsigned short)std::min(damage, (unsigned int)p.hp);
+	p.hp -= lost;
+	Log(event, side, p.status, lost);
+	if (p.hp == 0)
+	{
+		p.status = Statuses::FAINTED;
+		Log(BattleEvents::FAINTED, side);
+		if (side == 1)
+			AwardXP(p);
+	}
+	return lost;
+}
+
+void Battle::AwardXP(const Pokemon& defeated)
+{
+	//the game splits it between everyone that was sent out against the defeated pokemon, here whoever is out gets it all
+	Pokemon& p = GetActive(0);
+	if (p.hp == 0)
+		return;
+	unsigned int xp = CalculateXP(defeated, wild);
+	Log(BattleEvents::XP_GAINED, 0, sides[0].active, (unsigned short)xp);
+	if (p.AddXP(xp))
+		Log(BattleEvents::LEVEL_UP, 0, p.level);
+}
+
+void Battle::ApplySideEffect(unsigned char side, const MoveInfo& move)
+{
+	//chances out of 256
+	unsigned char status;
+	unsigned char chance;
+	switch (move.effect)
+	{
+	case MoveEffects::POISON_SIDE_EFFECT1: status = Statuses::POISONED; chance = 52; break;
+	case MoveEffects::POISON_SIDE_EFFECT2: status = Statuses::POISONED; chance = 103; break;
+	case MoveEffects::BURN_SIDE_EFFECT1: status = Statuses::BURNED; chance = 26; break;
+	case MoveEffects::BURN_SIDE_EFFECT2: status = Statuses::BURNED; chance = 77; break;
+	case MoveEffects::FREEZE_SIDE_EFFECT: status = Statuses::FROZEN; chance = 26; break;
+	case MoveEffects::PARALYZE_SIDE_EFFECT1: status = Statuses::PARALYZED; chance = 26; break;
+	case MoveEffects::PARALYZE_SIDE_EFFECT2: status = Statuses::PARALYZED; chance = 77; break;
+	default:
+		return;
+	}
+
+	//a pokemon can't get a status from a move of its own type, eg. fire types don't get burned
+	Pokemon& p = GetActive(side);
+	SpeciesInfo& species = p.Species();
+	if (p.status != Statuses::OK || move.type == species.type1 || move.type == species.type2)
+		return;
+	if (Random() < chance)
+		SetStatus(side, status);
+}
+
+void Battle::SetStatus(unsigned char side, unsigned char status)
+{
+	GetActive(side).status = status;
+	if (status == Statuses::SLEEPING)
+		sides[side].sleep_turns[sides[side].active] = Random() % 7 + 1;
+	Log(BattleEvents::STATUS, side, status);
+}
+
+void Battle::TryEscape(unsigned char side)
+{
+	if (!wild)
+	{
+		Log(BattleEvents::CANT_ESCAPE, side);
+		return;
+	}
+
+	//the game's formula: faster pokemon always get away, slower ones get better odds with each try
+	unsigned int speed = GetActive(side).speed;
+	unsigned int other_speed = (GetActive(side ^ 1).speed / 4) & 0xFF;
+	escape_attempts++;
+	if (speed >= GetActive(side ^ 1).speed || other_speed == 0 || speed * 32 / other_speed + 30 * (escape_attempts - 1) > 255 || Random() < speed * 32 / other_speed + 30 * (escape_attempts - 1))
+	{
+		over = true;
+		winner = BATTLE_NO_WINNER;
+		Log(BattleEvents::ESCAPED, side);
+		return;
+	}
+	Log(BattleEvents::CANT_ESCAPE, side);
+}
+
+void Battle::SwitchTo(unsigned char side, unsigned char slot)
+{
+	BattleSide& s = sides[side];
+	if (slot >= s.party_count || slot == s.active || s.party[slot].hp == 0)
+		return;
+	s.active = slot;
+	Log(BattleEvents::SENT_OUT, side, slot);
+}
+
+void Battle::EndTurn()
+{
+	for (int s = 0; s < 2; s++)
+	{
+		Pokemon& p = GetActive(s);
+		if (p.hp > 0 && (p.status == Statuses::POISONED || p.status == Statuses::BURNED))
+			DealDamage(s, std::max(p.max_hp / 16, 1), BattleEvents::STATUS_DAMAGE);
+	}
+
+	bool healthy[2] = { HasHealthyPokemon(0), HasHealthyPokemon(1) };
+	if (!healthy[0] || !healthy[1])
+	{
+		over = true;
+		winner = healthy[0] ? 0 : 1;
+		Log(BattleEvents::WON, winner);
+		return;
+	}
+
+	for (int s = 0; s < 2; s++)
+	{
+		if (GetActive(s).hp > 0)
+			continue;
+		for (unsigned char i = 0; i < sides[s].party_count; i++)
+		{
+			if (sides[s].party[i].hp > 0)
+			{
+				SwitchTo(s, i);
+				break;
+			}
+		}
+	}
+}
+
+bool Battle::HasHealthyPokemon(unsigned char side)
+{
+	for (int i = 0; i < sides[side].party_count; i++)
+	{
+		if (sides[side].party[i].hp > 0)
+			return true;
+	}
+	return false;
+}
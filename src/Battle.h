@@ -0,0 +1,154 @@
+#pragma once
+
+#include "Pokemon.h"
+#include "Random.h"
+
+#define BATTLE_MAX_EVENTS 64 //more than a turn can ever log
+#define BATTLE_NO_WINNER 0xFF
+
+namespace BattleActions
+{
+	enum
+	{
+		FIGHT, //index is the move slot
+		SWITCH, //index is the party slot
+		RUN,
+	};
+}
+
+struct BattleAction
+{
+	unsigned char type;
+	unsigned char index;
+};
+
+//what happened during a turn, in order. BattleScene turns these into messages and animations
+namespace BattleEvents
+{
+	enum
+	{
+		SENT_OUT, //value is the party slot
+		USED_MOVE, //value is the move id
+		NO_PP,
+		MISSED,
+		NO_EFFECT, //the move's type doesn't affect the target
+		FAILED, //the move did nothing (or does something we don't handle yet)
+		CRITICAL_HIT,
+		EFFECTIVENESS, //value is the type multiplier in percent, only logged when it isn't 100
+		DAMAGE, //amount is the hp lost
+		HEALED, //amount is the hp gained
+		STATUS, //value is the new status
+		FULLY_PARALYZED,
+		FAST_ASLEEP,
+		WOKE_UP,
+		FROZEN_SOLID,
+		THAWED,
+		STATUS_DAMAGE, //hurt by poison or burn, value is the status and amount is the hp lost
+		FAINTED,
+		XP_GAINED, //by side 0's active pokemon, value is its party slot and amount is the xp
+		LEVEL_UP, //value is the new level
+		ESCAPED,
+		CANT_ESCAPE,
+		WON, //side is the winner
+	};
+}
+
+struct BattleEvent
+{
+	unsigned char type;
+	unsigned char side; //the side the event happened to
+	unsigned char value;
+	unsigned short amount;
+};
+
+//move effects from moves.dat that the battle engine knows about
+namespace MoveEffects
+{
+	enum
+	{
+		NONE = 0x00,
+		POISON_SIDE_EFFECT1 = 0x02,
+		DRAIN_HP = 0x03,
+		BURN_SIDE_EFFECT1 = 0x04,
+		FREEZE_SIDE_EFFECT = 0x05,
+		PARALYZE_SIDE_EFFECT1 = 0x06,
+		EXPLODE = 0x07,
+		DREAM_EATER = 0x08,
+		SWIFT = 0x11,
+		SLEEP = 0x20,
+		POISON_SIDE_EFFECT2 = 0x21,
+		BURN_SIDE_EFFECT2 = 0x22,
+		PARALYZE_SIDE_EFFECT2 = 0x24,
+		OHKO = 0x26,
+		SUPER_FANG = 0x28,
+		SPECIAL_DAMAGE = 0x29,
+		RECOIL = 0x30,
+		POISON = 0x42,
+		PARALYZE = 0x43,
+	};
+}
+
+struct BattleSide
+{
+	Pokemon party[6];
+	unsigned char party_count;
+	unsigned char active;
+	unsigned char sleep_turns[6];
+};
+
+//The rules of a battle without any of the presentation: damage, the type chart, accuracy, PP, statuses and
+//turn order. The parties are copies, so a Battle can be copied, run on any thread, or thrown away freely.
+//Everything random comes from the battle's own stream, so the same stream and actions give the same battle.
+//Fainted pokemon are replaced with the next healthy one in the party at the end of the turn.
+class Battle
+{
+public:
+	void Start(const Pokemon* party0, unsigned char count0, const Pokemon* party1, unsigned char count1, const RandomStream& random, bool wild = false);
+	void RunTurn(BattleAction action0, BattleAction action1); //side 0 is the player
+	void Reseed(unsigned int seed); //gives a copy different luck, so lookahead can't see what the real battle will roll
+
+	BattleAction ChooseRandomMove(unsigned char side); //what wild pokemon do
+	bool CanUseMove(unsigned char side, unsigned char slot);
+	bool HasUsableMove(unsigned char side); //if not, fighting uses struggle
+
+	BattleSide& GetSide(unsigned char side) { return sides[side & 1]; }
+	Pokemon& GetActive(unsigned char side) { return sides[side & 1].party[sides[side & 1].active]; }
+	BattleEvent* GetEvents() { return events; } //the events from Start or the last turn
+	unsigned char GetEventCount() { return event_count; }
+	bool IsOver() { return over; }
+	unsigned char GetWinner() { return winner; } //BATTLE_NO_WINNER if someone ran
+	unsigned int GetTurn() { return turn; }
+
+	//the game's damage formula. roll is the random factor, 217-255
+	static unsigned int CalculateDamage(const Pokemon& attacker, const Pokemon& defender, const MoveInfo& move, bool critical, unsigned char roll);
+	static unsigned int CalculateXP(const Pokemon& defeated, bool wild); //what beating a pokemon is worth, trainers' give half again
+	static bool IsSpecialType(unsigned char type) { return type >= Types::FIRE; }
+
+private:
+	BattleSide sides[2];
+	BattleEvent events[BATTLE_MAX_EVENTS];
+	unsigned char event_count;
+	bool wild;
+	bool over;
+	unsigned char winner;
+	unsigned char escape_attempts;
+	unsigned int turn;
+	RandomStream random;
+
+	unsigned char Random(); //0-255
+	void Log(unsigned char type, unsigned char side, unsigned char value = 0, unsigned short amount = 0);
+
+	bool MovesFirst(unsigned char side, BattleAction* actions);
+	unsigned int GetSpeed(Pokemon& p) { return p.status == Statuses::PARALYZED ? p.speed / 4 : p.speed; }
+	bool CanAct(unsigned char side);
+	void UseMove(unsigned char side, unsigned char slot);
+	void HitWithMove(unsigned char side, unsigned char id, const MoveInfo& move); //everything after the move is announced
+	unsigned int DealDamage(unsigned char side, unsigned int damage, unsigned char event = BattleEvents::DAMAGE); //returns the hp lost
+	void AwardXP(const Pokemon& defeated);
+	void ApplySideEffect(unsigned char side, const MoveInfo& move);
+	void SetStatus(unsigned char side, unsigned char status);
+	void TryEscape(unsigned char side);
+	void SwitchTo(unsigned char side, unsigned char slot);
+	void EndTurn();
+	bool HasHealthyPokemon(unsigned char side);
+};
@@ -0,0 +1,261 @@
+#include "BattleAI.h"
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <algorithm>
+
+//one random key for every value each part of a battle can have; a state's hash is the keys of its values xor'd together.
+//filled in before main runs, so every thread sees the same keys
+static struct ZobristKeys
+{
+	unsigned long long hp[2][6][1024];
+	unsigned long long status[2][6][8];
+	unsigned long long sleep[2][6][8];
+	unsigned long long pp[2][6][4][64];
+	unsigned long long active[2][6];
+
+	ZobristKeys()
+	{
+		//splitmix64 from a fixed seed, so hashes are the same every run
+		unsigned long long x = 0x5DEECE66DULL;
+		unsigned long long* keys = &hp[0][0][0];
+		for (unsigned int i = 0; i < sizeof(ZobristKeys) / sizeof(unsigned long long); i++)
+		{
+			x += 0x9E3779B97F4A7C15ULL;
+			unsigned long long z = x;
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+			keys[i] = z ^ (z >> 31);
+		}
+	}
+} zobrist;
+
+BattleAI::BattleAI(unsigned char difficulty, unsigned int budget)
+{
+	SetDifficulty(difficulty);
+	this->budget = budget;
+	table = new TableEntry[AI_TABLE_SIZE];
+	memset(table, 0, AI_TABLE_SIZE * sizeof(TableEntry));
+	generation = 1;
+	deadline = 0;
+	nodes = 0;
+	aborted = false;
+	ClearLatencies();
+}
+
+BattleAI::~BattleAI()
+{
+	delete[] table;
+}
+
+void BattleAI::Reset()
+{
+	if (++generation == 0)
+	{
+		memset(table, 0, AI_TABLE_SIZE * sizeof(TableEntry));
+		generation = 1;
+	}
+}
+
+BattleAction BattleAI::ChooseAction(Battle& battle, unsigned char side)
+{
+	long long start = Now();
+	BattleAction action = { BattleActions::FIGHT, 0 };
+	if (difficulty == 0)
+		action = battle.ChooseRandomMove(side);
+	else
+	{
+		unsigned char moves[4];
+		GetMoves(battle, side, moves);
+		action.index = moves[0];
+		deadline = start + budget;
+		nodes = 0;
+		aborted = false;
+
+		//look one more turn ahead each time, keeping the answer from the last search that finished in time
+		for (unsigned char depth = 1; depth <= difficulty; depth++)
+		{
+			unsigned char best = action.index;
+			Search(battle, side, depth, &best);
+			if (aborted)
+				break;
+			action.index = best;
+		}
+	}
+
+	long long elapsed = Now() - start;
+	latency_counts[elapsed < AI_LATENCY_BUCKETS ? elapsed : AI_LATENCY_BUCKETS - 1]++;
+	decisions++;
+	return action;
+}
+
+int BattleAI::Search(Battle& battle, unsigned char side, unsigned char depth, unsigned char* best_move)
+{
+	if (battle.IsOver() || depth == 0)
+	{
+		//winning sooner is better than winning later, and losing later is better than losing sooner
+		int value = Evaluate(battle, side);
+		return value >= AI_WIN ? value + depth : value <= -AI_WIN ? value - depth : value;
+	}
+	if (OutOfTime())
+		return 0;
+
+	unsigned long long key = Hash(battle);
+	TableEntry& entry = table[key & (AI_TABLE_SIZE - 1)];
+	bool known = entry.key == key && entry.generation == generation;
+	if (known && entry.depth >= depth)
+	{
+		if (best_move)
+			*best_move = entry.best;
+		return entry.value;
+	}
+
+	unsigned char moves[4];
+	unsigned char replies[4];
+	unsigned char move_count = GetMoves(battle, side, moves);
+	unsigned char reply_count = GetMoves(battle, side ^ 1, replies);
+	//trying the move that was best last time first lets more of the others get cut off early
+	for (int i = 1; i < move_count && known; i++)
+	{
+		if (moves[i] == entry.best)
+			std::swap(moves[0], moves[i]);
+	}
+
+	int best = INT_MIN;
+	unsigned char best_slot = moves[0];
+	for (int i = 0; i < move_count; i++)
+	{
+		//the opponent answers with whatever is worst for us. once that's no better than a move we already have,
+		//the rest of the answers can't make this move the best one
+		int worst = INT_MAX;
+		for (int k = 0; k < reply_count && worst > best; k++)
+		{
+			BattleAction mine = { BattleActions::FIGHT, moves[i] };
+			BattleAction theirs = { BattleActions::FIGHT, replies[k] };
+			int total = 0;
+			for (int s = 0; s < AI_SAMPLES; s++)
+			{
+				//the luck only depends on the state and the moves, so the same position always searches the same way
+				Battle next = battle;
+				next.Reseed((unsigned int)(key >> 32) ^ (unsigned int)key ^ ((moves[i] * 16 + replies[k] * 4 + s + 1) * 0x9E3779B9));
+				if (side == 0)
+					next.RunTurn(mine, theirs);
+				else
+					next.RunTurn(theirs, mine);
+				total += Search(next, side, depth - 1, 0);
+			}
+			worst = std::min(worst, total / AI_SAMPLES);
+		}
+		if (worst > best)
+		{
+			best = worst;
+			best_slot = moves[i];
+		}
+	}
+	if (aborted)
+		return 0;
+
+	entry.key = key;
+	entry.value = best;
+	entry.generation = generation;
+	entry.depth = depth;
+	entry.best = best_slot;
+	if (best_move)
+		*best_move = best_slot;
+	return best;
+}
+
+unsigned char BattleAI::GetMoves(Battle& battle, unsigned char side, unsigned char* moves)
+{
+	if (!battle.HasUsableMove(side))
+	{
+		moves[0] = 0; //struggle
+		return 1;
+	}
+	unsigned char count = 0;
+	for (unsigned char i = 0; i < 4; i++)
+	{
+		if (battle.CanUseMove(side, i))
+			moves[count++] = i;
+	}
+	return count;
+}
+
+bool BattleAI::OutOfTime()
+{
+	//reading the clock costs more than a node, so only check every so often
+	if (budget == 0 || aborted)
+		return aborted;
+	if ((++nodes & 7) == 0 && Now() > deadline)
+		aborted = true;
+	return aborted;
+}
+
+long long BattleAI::Now()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+unsigned long long BattleAI::Hash(Battle& battle)
+{
+	unsigned long long h = 0;
+	for (int s = 0; s < 2; s++)
+	{
+		BattleSide& side = battle.GetSide(s);
+		for (int i = 0; i < side.party_count; i++)
+		{
+			Pokemon& p = side.party[i];
+			h ^= zobrist.hp[s][i][p.hp & 0x3FF] ^ zobrist.status[s][i][p.status & 7] ^ zobrist.sleep[s][i][side.sleep_turns[i] & 7];
+			for (int m = 0; m < 4; m++)
+				h ^= zobrist.pp[s][i][m][p.moves[m].pp & 0x3F];
+		}
+		h ^= zobrist.active[s][side.active % 6];
+	}
+	return h;
+}
+
+int BattleAI::Evaluate(Battle& battle, unsigned char side)
+{
+	if (battle.IsOver())
+		return battle.GetWinner() == side ? AI_WIN : battle.GetWinner() == (side ^ 1) ? -AI_WIN : 0;
+
+	int score = 0;
+	for (int s = 0; s < 2; s++)
+	{
+		BattleSide& b = battle.GetSide(s);
+		int total = 0;
+		for (int i = 0; i < b.party_count; i++)
+		{
+			Pokemon& p = b.party[i];
+			if (p.hp == 0)
+				continue;
+			//every pokemon left is worth something on top of its hp, since it still gets to attack
+			total += 500 + 1000 * p.hp / std::max(p.max_hp, (unsigned short)1);
+			if (p.status == Statuses::SLEEPING || p.status == Statuses::FROZEN)
+				total -= 300;
+			else if (p.status != Statuses::OK)
+				total -= 150;
+		}
+		score += s == side ? total : -total;
+	}
+	return score;
+}
+
+unsigned int BattleAI::GetLatencyPercentile(unsigned int percent)
+{
+	unsigned long long needed = ((unsigned long long)decisions * percent + 99) / 100;
+	unsigned long long seen = 0;
+	for (unsigned int i = 0; i < AI_LATENCY_BUCKETS; i++)
+	{
+		seen += latency_counts[i];
+		if (seen >= needed && seen > 0)
+			return i;
+	}
+	return AI_LATENCY_BUCKETS - 1;
+}
+
+void BattleAI::ClearLatencies()
+{
+	decisions = 0;
+	memset(latency_counts, 0, sizeof(latency_counts));
+}
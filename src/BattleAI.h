@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Battle.h"
+
+#define AI_MAX_DIFFICULTY 4 //difficulty is how many turns ahead the AI looks, 0 picks moves at random like wild pokemon
+#define AI_DEFAULT_DIFFICULTY 2
+#define AI_DEFAULT_BUDGET 2000 //microseconds per decision, well under a frame. 0 means no limit
+#define AI_SAMPLES 2 //how many different rolls each pair of moves is tried with
+#define AI_TABLE_SIZE 16384 //transposition table entries, has to be a power of 2
+#define AI_LATENCY_BUCKETS 5000 //decision times are counted per microsecond, anything slower goes in the last one
+#define AI_WIN 1000000
+
+//Picks moves for a trainer by looking a few turns ahead: for each of its moves it assumes the opponent answers
+//with whatever hurts it most, and averages over a few rolls of the dice for hits, crits and damage (expectiminimax).
+//States that come up more than once are only searched once, using a Zobrist hash of everything a turn can change.
+//Deeper searches are tried one after another until the time budget runs out, so a decision never stalls a frame.
+//Only moves are considered, the AI never switches or runs.
+class BattleAI
+{
+public:
+	BattleAI(unsigned char difficulty = AI_DEFAULT_DIFFICULTY, unsigned int budget = AI_DEFAULT_BUDGET);
+	~BattleAI();
+
+	void SetDifficulty(unsigned char d) { difficulty = d < AI_MAX_DIFFICULTY ? d : AI_MAX_DIFFICULTY; }
+	void SetBudget(unsigned int microseconds) { budget = microseconds; }
+	void Reset(); //call when a new battle starts, forgets everything searched so far
+
+	BattleAction ChooseAction(Battle& battle, unsigned char side);
+
+	//how long ChooseAction has been taking
+	unsigned int GetDecisionCount() { return decisions; }
+	unsigned int GetLatencyPercentile(unsigned int percent); //in microseconds
+	const unsigned int* GetLatencyCounts() { return latency_counts; }
+	void ClearLatencies();
+
+	static unsigned long long Hash(Battle& battle);
+	static int Evaluate(Battle& battle, unsigned char side); //positive is good for side
+
+private:
+	struct TableEntry
+	{
+		unsigned long long key;
+		int value;
+		unsigned short generation; //entries from earlier battles don't count
+		unsigned char depth;
+		unsigned char best; //the best move slot, tried first next time
+	};
+
+	unsigned char difficulty;
+	unsigned int budget;
+	TableEntry* table;
+	unsigned short generation;
+
+	long long deadline; //in microseconds, see Now
+	unsigned int nodes;
+	bool aborted;
+
+	unsigned int decisions;
+	unsigned int latency_counts[AI_LATENCY_BUCKETS];
+
+	int Search(Battle& battle, unsigned char side, unsigned char depth, unsigned char* best_move);
+	unsigned char GetMoves(Battle& battle, unsigned char side, unsigned char* moves);
+	bool OutOfTime();
+	static long long Now();
+};
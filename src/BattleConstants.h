@@ -3,7 +3,8 @@
 enum BattleStages
 {
 	SCROLL = 0,
-	INTRO = 1
+	INTRO = 1,
+	FIGHT = 2
 };
 
 #define GRAYSCALE_PALETTE	30
@@ -3,11 +3,12 @@
 
 BattleScene::BattleScene()
 {
-	for (int i = 0; i < 6; i++)
-		opponent[i] = 0;
 	stage = 0;
 	wild_battle = false;
 	opponent_image = 0;
+	scroll_timer = 0;
+	action_chosen = false;
+	messages_done = false;
 }
 
 BattleScene::~BattleScene()
@@ -18,26 +19,16 @@ BattleScene::~BattleScene()
 void BattleScene::CleanupBattle()
 {
 	stage = 0;
-
-	for (int i = 0; i < 6; i++)
-	{
-		if (opponent[i] != 0)
-		{
-			delete opponent[i];
-			opponent[i] = 0;
-		}
-	}
+	scroll_timer = 0;
+	action_chosen = false;
+	messages_done = false;
 
 	if (opponent_image)
 	{
 		//delete opponent_image;
 		//opponent_image = 0;
 	}
-	if (party_status)
-	{
-		delete party_status;
-		party_status = 0;
-	}
+	hud.ClearBackground();
 
 	CloseAll(); //close all textboxes
 }
@@ -52,10 +43,13 @@ void BattleScene::Update()
 	case BattleStages::INTRO: //1
 		UpdateIntro();
 		break;
+	case BattleStages::FIGHT: //2
+		UpdateFight();
+		break;
 	}
 }
 
-void BattleScene::Render(sf::RenderWindow* window)
+void BattleScene::Render(sf::RenderTarget* window)
 {
 	window->clear(ResourceCache::GetPalette(GRAYSCALE_PALETTE)[0]);
 	switch (stage)
@@ -64,6 +58,7 @@ void BattleScene::Render(sf::RenderWindow* window)
 		RenderScroll(window);
 		break;
 	case BattleStages::INTRO: //1
+	case BattleStages::FIGHT: //2
 		RenderIntro(window);
 		break;
 	}
@@ -74,14 +69,48 @@ void BattleScene::Render(sf::RenderWindow* window)
 
 void BattleScene::BeginWildBattle(unsigned char id, unsigned char level)
 {
-	wild_battle = 0;
-	opponent[0] = new Pokemon(id, level);
-	opponent_image = ResourceCache::GetPokemonFront(opponent[0]->pokedex_index);
+	wild_battle = true;
+	Pokemon wild(id, level);
+	StartBattle(&wild, 1);
+}
+
+bool BattleScene::BeginTrainerBattle(unsigned char trainer_class, unsigned char trainer_party)
+{
+	unsigned char species[6];
+	unsigned char levels[6];
+	unsigned char count = GameData::GetTrainerParty(trainer_class, trainer_party, species, levels);
+	if (count == 0)
+		return false;
+
+	wild_battle = false;
+	Pokemon opponents[6];
+	for (int i = 0; i < count; i++)
+	{
+		opponents[i] = Pokemon(species[i], levels[i]);
+		opponents[i].SetTrainerDVs();
+	}
+	StartBattle(opponents, count);
+	return true;
+}
+
+void BattleScene::StartBattle(Pokemon* opponents, unsigned char count)
+{
+	Pokemon party[6];
+	PlayerProperties* player = Players::GetPlayer1();
+	for (int i = 0; i < player->GetPartyCount(); i++)
+		party[i] = *player->GetParty()[i];
+	battle.Start(party, player->GetPartyCount(), opponents, count, Random::Split(RandomStreams::BATTLES), wild_battle);
+	shown_active[0] = battle.GetSide(0).active;
+	shown_active[1] = battle.GetSide(1).active;
+
+	opponent_image = ResourceCache::GetPokemonFront(battle.GetActive(1).GetPokedexIndex());
 	InitBattle();
 }
 
 void BattleScene::InitBattle()
 {
+	ai.Reset();
+
 	//set palettes
 	sf::Color bw_alpha[4];
 	memcpy(bw_alpha, ResourceCache::GetPalette(GRAYSCALE_PALETTE), sizeof(sf::Color) * 4);
@@ -91,7 +120,7 @@ void BattleScene::InitBattle()
 	ResourceCache::GetMenuTexture()->SetPalette(ResourceCache::GetPalette(GRAYSCALE_PALETTE));
 	ResourceCache::GetFontTexture()->SetPalette(ResourceCache::GetPalette(GRAYSCALE_PALETTE));
 
-	status_box = new Textbox();
+	status_box = Textbox::Create();
 	textboxes.push_back(status_box);
 }
 
@@ -108,30 +137,33 @@ void BattleScene::UpdateScroll()
 	{
 		stage++;
 		ResourceCache::GetRedBack()->SetPalette(ResourceCache::GetPalette(TRAINER_PALETTE));
-		opponent_image->SetPalette(ResourceCache::GetPalette(ResourceCache::GetPokemonPaletteIndex(opponent[0]->pokedex_index)));
-		status_box->SetText(new TextItem(status_box, nullptr, pokestring("Wild ").append(ResourceCache::GetPokemonName(opponent[0]->id - 1)).append(pokestring("\nappeared!\f"))));
+		opponent_image->SetPalette(ResourceCache::GetPalette(ResourceCache::GetPokemonPaletteIndex(battle.GetActive(1).GetPokedexIndex())));
+		string intro = wild_battle ? pokestring("Wild ").append(battle.GetActive(1).GetName()).append(pokestring("\nappeared!\f")) : pokestring("Enemy sent out\n").append(battle.GetActive(1).GetName()).append(pokestring("!\f"));
+		status_box->SetText(TextItem::Create(status_box, [this](TextItem* source) { this->stage = BattleStages::FIGHT; this->messages_done = true; }, intro));
 		UpdatePartyStatus();
-		Engine::GetCryPlayer().Play(opponent[0]->id);
+		Engine::GetCryPlayer().Play(battle.GetActive(1).id);
 	}
 }
 
-void BattleScene::RenderScroll(sf::RenderWindow* window)
+void BattleScene::RenderScroll(sf::RenderTarget* window)
 {
 	sf::Sprite s;
 	sf::IntRect rect(0, 0, 0, 0);
 	//draw opponent front
 	s.setTexture(*opponent_image);
-	rect.width = opponent[0]->size_x * 8;
-	rect.height = opponent[0]->size_y * 8;
+	rect.width = battle.GetActive(1).Species().size_x * 8;
+	rect.height = battle.GetActive(1).Species().size_y * 8;
 	s.setTextureRect(rect);
-	s.setPosition(-opponent[0]->size_x * 8 + scroll_timer - 8, 56 - opponent[0]->size_y * 8);
+	s.setPosition(-battle.GetActive(1).Species().size_x * 8 + scroll_timer - 8, 56 - battle.GetActive(1).Species().size_y * 8);
 	window->draw(s);
+	Profiler::CountDraw(s.getTexture());
 
 	//draw player back
 	s.setScale(2, 2);
 	s.setTexture(*ResourceCache::GetRedBack());
 	s.setPosition(160 - scroll_timer, 40);
 	window->draw(s);
+	Profiler::CountDraw(s.getTexture());
 }
 
 /*
@@ -143,39 +175,34 @@ void BattleScene::UpdateIntro()
 	UpdateTextboxes();
 }
 
-void BattleScene::RenderIntro(sf::RenderWindow* window)
+void BattleScene::RenderIntro(sf::RenderTarget* window)
 {
 	sf::Sprite s;
 	sf::IntRect rect(0, 0, 0, 0);
 	//draw opponent front
 	s.setTexture(*opponent_image);
-	rect.width = opponent[0]->size_x * 8;
-	rect.height = opponent[0]->size_y * 8;
+	rect.width = battle.GetActive(1).Species().size_x * 8;
+	rect.height = battle.GetActive(1).Species().size_y * 8;
 	s.setTextureRect(rect);
-	s.setPosition(144 - opponent[0]->size_x * 8, 56 - opponent[0]->size_y * 8);
+	s.setPosition(144 - battle.GetActive(1).Species().size_x * 8, 56 - battle.GetActive(1).Species().size_y * 8);
 	window->draw(s);
+	Profiler::CountDraw(s.getTexture());
 
 	//draw player back
 	s.setScale(2, 2);
 	s.setTexture(*ResourceCache::GetRedBack());
 	s.setPosition(8, 40);
 	window->draw(s);
+	Profiler::CountDraw(s.getTexture());
 
 	//draw status
-	party_status->Render(window, 0, 0, 0, 10, 2, 72, 80);
+	hud.Flush(window);
 
 }
 
 void BattleScene::UpdatePartyStatus()
 {
-	if (party_status == 0)
-	{
-		party_status = new TileMap(ResourceCache::GetStatusesTexture(3), 0, 16);
-		DataBlock* formation = new DataBlock(20);
-		party_status->SetFormation(formation);
-	}
-
-	unsigned char* f = party_status->GetFormation()->data_start;
+	unsigned char f[20]; //10x2 tiles starting at tile 9, 10
 	for (int x = 0; x < 10; x++)
 	{
 		f[x] = 0x3F; //blank
@@ -189,13 +216,13 @@ void BattleScene::UpdatePartyStatus()
 
 	for (int i = 0; i < 6; i++)
 	{
-		if (i >= Players::GetPlayer1()->GetPartyCount())
+		if (i >= battle.GetSide(0).party_count)
 		{
 			f[i + 2] = 0x33;
 		}
-		else if (Players::GetPlayer1()->GetParty()[i]->hp > 0)
+		else if (battle.GetSide(0).party[i].hp > 0)
 		{
-			if (Players::GetPlayer1()->GetParty()[i]->status != Statuses::OK)
+			if (battle.GetSide(0).party[i].status != Statuses::OK)
 				f[i + 2] = 0x31;
 			else
 				f[i + 2] = 0x30;
@@ -203,4 +230,205 @@ void BattleScene::UpdatePartyStatus()
 		else
 			f[i + 2] = 0x32;
 	}
+
+	PaletteTexture* statuses = ResourceCache::GetStatusesTexture(3);
+	for (int i = 0; i < 20; i++)
+		hud.SetTile(9 + i % 10, 10 + i / 10, statuses, f[i]);
+}
+
+/*
+ * Stage 2
+ */
+void BattleScene::UpdateFight()
+{
+	UpdateTextboxes();
+	if (action_chosen)
+	{
+		action_chosen = false;
+		CloseAll();
+		PlayTurn();
+	}
+	else if (messages_done)
+	{
+		messages_done = false;
+		if (battle.IsOver())
+			EndBattle();
+		else
+			ShowMainMenu();
+	}
+}
+
+void BattleScene::ShowMainMenu()
+{
+	Textbox* menu = Textbox::Create(8, 12, 12, 6);
+	menu->SetMenu(true, 2, sf::Vector2i(1, 1), sf::Vector2u(0, 2), nullptr, MenuFlags::FOCUSABLE);
+	menu->SetCloseCallback([menu](TextItem* source) { menu->CancelClose(); }); //there's nothing to back out to
+	menu->GetItems().push_back(TextItem::Create(menu, [this, menu](TextItem* source) { this->ShowMoveMenu(menu); }, pokestring("FIGHT"), 0));
+	menu->GetItems().push_back(TextItem::Create(menu, [this](TextItem* source) { this->ChooseAction(BattleActions::RUN, 0); }, pokestring("RUN"), 1));
+	menu->SetArrowState(ArrowStates::ACTIVE);
+	menu->UpdateMenu();
+	ShowTextbox(menu, false);
+}
+
+void BattleScene::ShowMoveMenu(Textbox* main_menu)
+{
+	Textbox* moves = Textbox::Create(4, 12, 16, 6);
+	moves->SetMenu(true, 4, sf::Vector2i(1, 0), sf::Vector2u(0, 1), nullptr, MenuFlags::FOCUSABLE);
+	std::function<void(TextItem* source)> move_select = [this, moves](TextItem* source)
+	{
+		//with no pp left at all the engine uses struggle, whichever move was picked
+		if (!battle.CanUseMove(0, source->index) && battle.HasUsableMove(0))
+		{
+			Textbox* f = Textbox::Create();
+			f->SetText(TextItem::Create(f, nullptr, pokestring("No PP left for\nthis move!\f")));
+			moves->ShowTextbox(f, false);
+			return;
+		}
+		this->ChooseAction(BattleActions::FIGHT, source->index);
+	};
+
+	Pokemon& p = battle.GetActive(0);
+	for (unsigned char i = 0; i < 4; i++)
+		moves->GetItems().push_back(TextItem::Create(moves, p.moves[i].index ? move_select : nullptr, p.moves[i].GetName(), i));
+	moves->SetArrowState(ArrowStates::ACTIVE);
+	moves->UpdateMenu();
+	main_menu->ShowTextbox(moves, false);
+}
+
+void BattleScene::ChooseAction(unsigned char type, unsigned char index)
+{
+	player_action.type = type;
+	player_action.index = index;
+	action_chosen = true;
+}
+
+void BattleScene::PlayTurn()
+{
+	battle.RunTurn(player_action, wild_battle ? battle.ChooseRandomMove(1) : ai.ChooseAction(battle, 1));
+
+	string text;
+	for (unsigned int i = 0; i < battle.GetEventCount(); i++)
+		AppendEventText(text, battle.GetEvents()[i]);
+	if (text.length() == 0)
+	{
+		messages_done = true;
+		return;
+	}
+	text.append(pokestring("\f"));
+
+	Textbox* t = Textbox::Create();
+	t->SetText(TextItem::Create(t, [this](TextItem* source) { this->messages_done = true; }, text));
+	ShowTextbox(t, false);
+	UpdatePartyStatus();
+}
+
+void BattleScene::AppendEventText(string& text, BattleEvent& e)
+{
+	Pokemon& p = battle.GetSide(e.side).party[shown_active[e.side & 1]];
+	string name = e.side == 0 ? string(p.nickname) : pokestring("Enemy ").append(p.nickname);
+	string message;
+	switch (e.type)
+	{
+	case BattleEvents::SENT_OUT:
+		shown_active[e.side & 1] = e.value;
+		name = battle.GetSide(e.side).party[e.value].nickname;
+		if (e.side == 0)
+			message = pokestring("Go! ").append(name).append(pokestring("!"));
+		else
+		{
+			message = pokestring("Enemy sent out\n").append(name).append(pokestring("!"));
+			opponent_image = ResourceCache::GetPokemonFront(battle.GetActive(1).GetPokedexIndex());
+			opponent_image->SetPalette(ResourceCache::GetPalette(ResourceCache::GetPokemonPaletteIndex(battle.GetActive(1).GetPokedexIndex())));
+		}
+		break;
+	case BattleEvents::USED_MOVE:
+		message = name.append(pokestring("\nused ")).append(GameData::GetMoveName(e.value - 1)).append(pokestring("!"));
+		break;
+	case BattleEvents::NO_PP:
+		message = pokestring("No PP left for\nthis move!");
+		break;
+	case BattleEvents::MISSED:
+		message = name.append(pokestring("'s\nattack missed!"));
+		break;
+	case BattleEvents::NO_EFFECT:
+		message = pokestring("It doesn't affect\n").append(name).append(pokestring("!"));
+		break;
+	case BattleEvents::FAILED:
+		message = pokestring("But, it failed!");
+		break;
+	case BattleEvents::CRITICAL_HIT:
+		message = pokestring("Critical hit!");
+		break;
+	case BattleEvents::EFFECTIVENESS:
+		message = pokestring(e.value > 100 ? "It's super\neffective!" : "It's not very\neffective...");
+		break;
+	case BattleEvents::HEALED:
+		message = name.append(pokestring("\nregained health!"));
+		break;
+	case BattleEvents::STATUS:
+		switch (e.value)
+		{
+		case Statuses::POISONED: message = name.append(pokestring("\nwas poisoned!")); break;
+		case Statuses::SLEEPING: message = name.append(pokestring("\nfell asleep!")); break;
+		case Statuses::PARALYZED: message = name.append(pokestring("'s\nparalyzed!")); break;
+		case Statuses::BURNED: message = name.append(pokestring("\nwas burned!")); break;
+		case Statuses::FROZEN: message = name.append(pokestring("\nwas frozen solid!")); break;
+		}
+		break;
+	case BattleEvents::FULLY_PARALYZED:
+		message = name.append(pokestring("'s\nfully paralyzed!"));
+		break;
+	case BattleEvents::FAST_ASLEEP:
+		message = name.append(pokestring("\nis fast asleep!"));
+		break;
+	case BattleEvents::WOKE_UP:
+		message = name.append(pokestring("\nwoke up!"));
+		break;
+	case BattleEvents::FROZEN_SOLID:
+		message = name.append(pokestring("\nis frozen solid!"));
+		break;
+	case BattleEvents::THAWED:
+		message = name.append(pokestring("\nwas defrosted!"));
+		break;
+	case BattleEvents::STATUS_DAMAGE:
+		message = name.append(pokestring(e.value == Statuses::BURNED ? "'s\nhurt by the burn!" : "'s\nhurt by poison!"));
+		break;
+	case BattleEvents::FAINTED:
+		message = name.append(pokestring("\nfainted!"));
+		break;
+	case BattleEvents::XP_GAINED:
+		message = name.append(pokestring(" gained\n")).append(pokestring(itos(e.amount).c_str())).append(pokestring(" EXP. Points!"));
+		break;
+	case BattleEvents::LEVEL_UP:
+		message = name.append(pokestring(" grew\nto level ")).append(pokestring(itos(e.value).c_str())).append(pokestring("!"));
+		break;
+	case BattleEvents::ESCAPED:
+		message = pokestring("Got away safely!");
+		break;
+	case BattleEvents::CANT_ESCAPE:
+		message = pokestring("Can't escape!");
+		break;
+	case BattleEvents::WON:
+		if (e.side != 0)
+			message = pokestring("You're out of\nuseable #MON!");
+		break;
+	}
+
+	if (message.length() == 0)
+		return;
+	if (text.length() > 0)
+		text.append(pokestring("\r"));
+	text.append(message);
+}
+
+void BattleScene::EndBattle()
+{
+	//hp, pp and statuses carry over to the player's party
+	PlayerProperties* player = Players::GetPlayer1();
+	BattleSide& side = battle.GetSide(0);
+	for (int i = 0; i < side.party_count && i < player->GetPartyCount(); i++)
+		*player->GetParty()[i] = side.party[i];
+
+	CleanupBattle();
+	Engine::SwitchState(States::OVERWORLD);
 }
@@ -8,6 +8,9 @@
 #include "ItemStorage.h"
 #include "AudioConstants.h"
 #include "Pokemon.h"
+#include "TileCompositor.h"
+#include "Battle.h"
+#include "BattleAI.h"
 
 class BattleScene : public Scene
 {
@@ -17,31 +20,49 @@ public:
 	void CleanupBattle();
 
 	virtual void Update() override;
-	virtual void Render(sf::RenderWindow* window) override;
+	virtual void Render(sf::RenderTarget* window) override;
 
 	void BeginWildBattle(unsigned char id, unsigned char level);
+	bool BeginTrainerBattle(unsigned char trainer_class, unsigned char trainer_party); //false if the class has no such party
 
 private:
 	bool wild_battle;
-	Pokemon* opponent[6];
+	Battle battle; //the rules live here, this scene only shows what happens
+	BattleAI ai; //picks the opponent's moves, except for wild pokemon which pick at random
 	unsigned char stage;
 	PaletteTexture* opponent_image;
 	Textbox* status_box;
 
+	void StartBattle(Pokemon* opponents, unsigned char count); //against the player's party
 	void InitBattle();
 
 	/*
 	 *STAGE 0 - scroll red/opponent
 	 */
 	void UpdateScroll();
-	void RenderScroll(sf::RenderWindow* window);
+	void RenderScroll(sf::RenderTarget* window);
 	unsigned char scroll_timer;
 
 	/*
 	*STAGE 1 - intro [x appeared or x would like to battle]
 	*/
-	TileMap* party_status; //the pokeballs displaying our party
+	TileCompositor hud; //the pokeballs displaying our party
 	void UpdateIntro();
-	void RenderIntro(sf::RenderWindow* window);
+	void RenderIntro(sf::RenderTarget* window);
 	void UpdatePartyStatus();
+
+	/*
+	*STAGE 2 - fight [pick an action, then show the turn's events]
+	*/
+	BattleAction player_action;
+	bool action_chosen; //set by the menus, the turn runs on the next update so the menus can be closed safely
+	bool messages_done; //set when the last message has been read
+	unsigned char shown_active[2]; //the pokemon each side had out as of the last message
+	void UpdateFight();
+	void ShowMainMenu();
+	void ShowMoveMenu(Textbox* main_menu);
+	void ChooseAction(unsigned char type, unsigned char index);
+	void PlayTurn();
+	void AppendEventText(string& text, BattleEvent& e);
+	void EndBattle();
 };
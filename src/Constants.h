@@ -32,6 +32,7 @@ enum ArrowStates
 
 #define VIEWPORT_WIDTH	10
 #define VIEWPORT_HEIGHT	9
+#define WINDOW_SCALE	3 //starting window size, in multiples of the 160x144 screen
 
 #define CONNECTION_NORTH	0
 #define CONNECTION_SOUTH	1
@@ -0,0 +1,56 @@
+#include "EncounterTable.h"
+#include <cstring>
+
+EncounterTable::EncounterTable()
+{
+	rate = 0;
+	memset(slots, ENCOUNTER_NONE, sizeof(slots));
+}
+
+void EncounterTable::Build(const WildEncounter* encounters, unsigned char rate, const unsigned char* chances)
+{
+	this->rate = rate;
+	for (int i = 0; i < ENCOUNTER_SLOTS; i++)
+		this->encounters[i] = encounters[i];
+
+	//the scan the game does on every step, done once for every roll
+	for (int roll = 0; roll < 256; roll++)
+	{
+		slots[roll] = ENCOUNTER_NONE;
+		for (int i = 0; i < ENCOUNTER_SLOTS; i++)
+		{
+			if (roll <= chances[i])
+			{
+				slots[roll] = i;
+				break;
+			}
+		}
+	}
+}
+
+unsigned char EncounterTable::Step(RandomStream& random)
+{
+	//one number is enough for both rolls: the top byte for the rate and the next one for the slot
+	unsigned int r = random.Next();
+	if ((r >> 24) >= rate)
+		return ENCOUNTER_NONE;
+	return slots[(r >> 16) & 0xFF];
+}
+
+void EncounterTable::GetSlots(const unsigned char* rolls, unsigned int count, unsigned char* out)
+{
+	for (unsigned int i = 0; i < count; i++)
+		out[i] = slots[rolls[i]];
+}
+
+unsigned int EncounterTable::Steps(RandomStream& random, unsigned int count, unsigned char* out)
+{
+	//the same rolls as calling Step count times, so a batch can be replayed one step at a time
+	unsigned int found = 0;
+	for (unsigned int i = 0; i < count; i++)
+	{
+		out[i] = Step(random);
+		found += out[i] != ENCOUNTER_NONE;
+	}
+	return found;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Events.h"
+#include "Random.h"
+
+#define ENCOUNTER_SLOTS 10
+#define ENCOUNTER_NONE 0xFF //no wild pokemon this step
+
+//A map's grass or water encounters. The game picks a slot by rolling a byte and taking the first slot whose
+//chance (from misc/wild_chances.dat) is at least the roll; since there are only 256 rolls, the slot for each
+//one is worked out when the map loads, so picking a pokemon is a single lookup.
+class EncounterTable
+{
+public:
+	EncounterTable();
+
+	void Build(const WildEncounter* encounters, unsigned char rate, const unsigned char* chances);
+	bool IsEmpty() { return rate == 0; }
+	unsigned char GetRate() { return rate; }
+
+	unsigned char GetSlot(unsigned char roll) { return slots[roll]; } //ENCOUNTER_NONE if the roll is past every chance
+	WildEncounter& GetEncounter(unsigned char slot) { return encounters[slot < ENCOUNTER_SLOTS ? slot : 0]; }
+
+	//one step in the grass: the rate decides if anything shows up, then the slot is picked. returns the slot or ENCOUNTER_NONE
+	unsigned char Step(RandomStream& random);
+
+	//many rolls at once, eg. for a server generating encounters for lots of players
+	void GetSlots(const unsigned char* rolls, unsigned int count, unsigned char* out);
+	unsigned int Steps(RandomStream& random, unsigned int count, unsigned char* out); //returns how many steps found something
+
+private:
+	WildEncounter encounters[ENCOUNTER_SLOTS];
+	unsigned char rate; //out of 256 per step
+	unsigned char slots[256];
+};
@@ -8,31 +8,60 @@ SFPlayer Engine::world_sounds;
 SFPlayer Engine::cry_player;
 
 unsigned char Engine::game_state = 0;
+sf::RenderTexture Engine::frame;
+bool Engine::frame_valid = false;
+#ifdef ALLOCATION_TEST
+unsigned int Engine::test_frame = 0;
+unsigned int Engine::test_checked_frames = 0;
+#endif
 
 void Engine::Initialize()
 {
+	Profiler::Initialize();
 	ResourceCache::LoadAll();
 	Players::Initialize();
 	InitializeAudio();
+	frame.create(VIEWPORT_WIDTH * 16, VIEWPORT_HEIGHT * 16);
 
 	//Initialize the scenes
 	map_scene = new MapScene();
 	battle_scene = new BattleScene();
 
+#ifdef ALLOCATION_TEST
+	SwitchState(States::OVERWORLD);
+#else
 	SwitchState(States::BATTLE);
 	battle_scene->BeginWildBattle(0xA9, 0);
+#endif
 }
 
 void Engine::Update()
 {
-	switch (game_state)
+#ifdef ALLOCATION_TEST
+	UpdateAllocationTest();
+#endif
+	Profiler::BeginFrame();
+	if (InputController::KeyDownOnce(sf::Keyboard::F3))
+		Profiler::ToggleOverlay();
+	if (InputController::KeyDownOnce(sf::Keyboard::F4))
 	{
-	case States::OVERWORLD:
-		active_scene->Update();
-		break;
-	case States::BATTLE:
-		battle_scene->Update();
-		break;
+		if (Profiler::Tracing())
+			Profiler::StopTrace();
+		else
+			Profiler::StartTrace();
+	}
+
+	{
+		ProfileScope profile(ProfileSections::SCENE_UPDATE);
+		switch (game_state)
+		{
+		case States::OVERWORLD:
+			active_scene->Update();
+			break;
+		case States::BATTLE:
+			battle_scene->Update();
+			break;
+		}
 	}
 	music_player.Update();
 	world_sounds.Update();
@@ -41,12 +70,45 @@ void Engine::Update()
 
 void Engine::Render(sf::RenderWindow* window)
 {
-	active_scene->Render(window);
+	//standing still in a menu shouldn't redraw the whole map every frame
+	if (!frame_valid || active_scene->NeedsRedraw())
+	{
+		frame.clear();
+		active_scene->Render(&frame);
+		frame.display();
+		frame_valid = true;
+	}
+
+	//blow the frame up by the biggest whole number that fits the window and center it, so pixels stay square
+	sf::Vector2u size = window->getSize();
+	unsigned int scale = max(1u, min(size.x / (VIEWPORT_WIDTH * 16), size.y / (VIEWPORT_HEIGHT * 16)));
+	sf::Sprite screen(frame.getTexture());
+	screen.setScale((float)scale, (float)scale);
+	screen.setPosition((float)(((int)size.x - VIEWPORT_WIDTH * 16 * (int)scale) / 2), (float)(((int)size.y - VIEWPORT_HEIGHT * 16 * (int)scale) / 2));
+	window->draw(screen);
+	Profiler::CountDraw(&frame.getTexture());
+	Profiler::EndFrame();
+
+	//the overlay isn't part of the frame, so it's drawn after the frame is measured
+	if (Profiler::OverlayVisible())
+	{
+		sf::View view = window->getView();
+		window->setView(sf::View(sf::FloatRect(-screen.getPosition().x / scale, -screen.getPosition().y / scale, (float)size.x / scale, (float)size.y / scale)));
+		Profiler::DrawOverlay(window);
+		window->setView(view);
+	}
 }
 
 void Engine::SwitchState(unsigned char s)
 {
+	//pause the overworld music during battles and pick it back up where it was afterwards
+	if (game_state == States::OVERWORLD && s != States::OVERWORLD)
+		music_player.SaveTrack();
+	else if (game_state != States::OVERWORLD && s == States::OVERWORLD)
+		music_player.ResumeTrack();
+
 	game_state = s;
+	frame_valid = false;
 	switch (game_state)
 	{
 	case States::OVERWORLD:
@@ -77,6 +139,38 @@ void Engine::Release()
 	cry_player.Close();
 }
 
+#ifdef ALLOCATION_TEST
+//Walks the player left and right and fails if a frame allocates once everything has warmed up.
+//Checks the frame that finished before this update, since its allocation counts are complete by now.
+void Engine::UpdateAllocationTest()
+{
+	static unsigned char last_map = 255;
+	unsigned char map = map_scene->GetMap() ? map_scene->GetMap()->index : 255;
+	bool walking = game_state == States::OVERWORLD && map == last_map && map_scene->GetTextboxes().size() == 0;
+	last_map = map;
+
+	if (test_frame >= ALLOCATION_TEST_WARMUP && walking)
+	{
+		if (Profiler::GetFrameAllocations() > 0)
+		{
+			std::cout << "Allocation test failed: frame " << test_frame << " allocated while walking\n";
+			Profiler::PrintFrameAllocations();
+			exit(EXIT_FAILURE);
+		}
+		if (++test_checked_frames >= ALLOCATION_TEST_FRAMES)
+		{
+			std::cout << "Allocation test passed: " << test_checked_frames << " walking frames without allocating\n";
+			exit(0);
+		}
+	}
+
+	//no wild battles, they would stop the walk
+	map_scene->SetRepel(255);
+	map_scene->SetForcedDirection((test_frame / ALLOCATION_TEST_TURN) % 2 == 0 ? ENTITY_LEFT : ENTITY_RIGHT);
+	test_frame++;
+}
+#endif
+
 void Engine::InitializeAudio()
 {
 	const char* err = music_player.Initialize(ResourceCache::GetResourceLocation(string("audio/music.gbs")).c_str());
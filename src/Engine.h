@@ -7,6 +7,13 @@
 #include "BattleScene.h"
 #include "Players.h"
 #include "SFPlayer.h"
+#include "Profiler.h"
+
+#ifdef ALLOCATION_TEST
+#define ALLOCATION_TEST_WARMUP 300 //frames to let caches and pools fill up before counting
+#define ALLOCATION_TEST_FRAMES 1200 //frames that have to walk without allocating to pass
+#define ALLOCATION_TEST_TURN 64 //frames between turning around
+#endif
 
 class Engine
 {
@@ -35,8 +42,17 @@ private:
 
 	static unsigned char game_state;
 
+	static sf::RenderTexture frame; //the last rendered frame at 160x144, shown again while the scene doesn't change
+	static bool frame_valid;
+
 	static SFPlayer music_player;
 	static SFPlayer world_sounds;
 	static SFPlayer cry_player;
 	static void InitializeAudio();
+
+#ifdef ALLOCATION_TEST
+	static unsigned int test_frame;
+	static unsigned int test_checked_frames;
+	static void UpdateAllocationTest();
+#endif
 };
\ No newline at end of file
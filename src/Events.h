@@ -1,5 +1,6 @@
 #pragma once
 #include "DataBlock.h"
+#include "TypeChart.h"
 #include <string>
 
 struct Warp
@@ -114,6 +115,63 @@ struct LearnsetMove
 	}
 };
 
+#define EVOLUTION_ITEM_SLOTS 8 //how many different evolution items there can be. the game has 5 stones
+
+//everything about a species that doesn't change per pokemon, parsed once from pokemon/stats and pokemon/leveling
+//the evolution and learnset lists end at the first entry with a 0 trigger/level
+struct SpeciesInfo
+{
+	unsigned char base_hp;
+	unsigned char base_attack;
+	unsigned char base_defense;
+	unsigned char base_speed;
+	unsigned char base_special;
+	unsigned char type1;
+	unsigned char type2;
+	unsigned char catch_rate;
+	unsigned char xp_yield;
+	unsigned char size_x; //front sprite size in tiles
+	unsigned char size_y;
+	unsigned char default_moves[4];
+	unsigned char growth_rate;
+	unsigned char type_multipliers[TYPE_COUNT + 1][2]; //what each attacking type (by type index) does against this species, see GetTypeMultipliers
+
+	Evolution evolutions[5];
+	LearnsetMove learnset[16];
+
+	//the lists above indexed by level and item when the species is loaded, so level-ups and stones don't search them
+	unsigned char learnset_moves[16]; //the learnset's moves in level order
+	unsigned char learnset_starts[102]; //for each level, where the moves learned at that level or later start in learnset_moves
+	unsigned char level_evolutions[101]; //what reaching each level evolves it into, 0 for nothing
+	unsigned char item_evolutions[EVOLUTION_ITEM_SLOTS]; //what each evolution item evolves it into, by item_slots
+
+	static unsigned char item_slots[256]; //where each item goes in item_evolutions, EVOLUTION_ITEM_SLOTS if it isn't an evolution item
+
+	unsigned char GetLevelEvolution(unsigned char level) { return level_evolutions[level < 100 ? level : 100]; }
+	unsigned char GetItemEvolution(unsigned char item) { return item_slots[item] < EVOLUTION_ITEM_SLOTS ? item_evolutions[item_slots[item]] : 0; }
+
+	//the moves learned going from one level to a higher one, eg. a single level-up or several at once from a big xp gain.
+	//points moves at them in level order and returns how many there are
+	unsigned char GetMovesLearned(unsigned char from_level, unsigned char to_level, const unsigned char** moves)
+	{
+		unsigned char first = learnset_starts[from_level < 100 ? from_level + 1 : 101];
+		unsigned char last = learnset_starts[to_level < 100 ? to_level + 1 : 101];
+		*moves = learnset_moves + first;
+		return last > first ? last - first : 0;
+	}
+};
+
+//a move's entry in moves/moves.dat, in the same order
+struct MoveInfo
+{
+	unsigned char animation;
+	unsigned char effect;
+	unsigned char power;
+	unsigned char type;
+	unsigned char accuracy;
+	unsigned char max_pp;
+};
+
 struct FlyPoint
 {
 	unsigned char map;
@@ -151,6 +209,7 @@ struct Transition
 {
 	unsigned char n_steps;
 	unsigned short tiles[64][64];
+	unsigned short covered[64]; //number of tiles covered once each step is done
 };
 
 struct TrainerHeader
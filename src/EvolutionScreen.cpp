@@ -7,18 +7,18 @@ EvolutionScreen::EvolutionScreen(Pokemon* p, unsigned char evolution)
 	pokemon_to = new Pokemon(evolution);
 	from_black = new PaletteTexture();
 	to_black = new PaletteTexture();
-	from_black->Copy(ResourceCache::GetPokemonFront(p->pokedex_index));
-	to_black->Copy(ResourceCache::GetPokemonFront(ResourceCache::GetPokedexIndex(evolution - 1)));
+	from_black->Copy(ResourceCache::GetPokemonFront(p->GetPokedexIndex()));
+	to_black->Copy(ResourceCache::GetPokemonFront(GameData::GetPokedexIndex(evolution - 1)));
 
 	sf::Color black[4] = { ResourceCache::GetMenuTexture()->GetPalette()[0], sf::Color(7 * 8, 7 * 8, 7 * 8, 255), sf::Color(2 * 8, 3 * 8, 3 * 8, 255), sf::Color(2 * 8, 1 * 8, 1 * 8, 255) };
 
 	from_black->SetPalette(black);
 	to_black->SetPalette(black);
 
-	main_frame = new Textbox(0, 0, 20, 12, true, true);
+	main_frame = Textbox::Create(0, 0, 20, 12, true, true);
 	main_frame->SetMenu(true, 0, sf::Vector2i(), sf::Vector2u(), [this](TextItem* s) {this->HitB(); }, MenuFlags::FOCUSABLE, 2147u, nullptr, true, sf::Vector2i(-100, 0));
 	main_frame->SetArrowState(ArrowStates::ACTIVE);
-	main_frame->SetRenderCallback([this](sf::RenderWindow* w) {this->Render(w); });
+	main_frame->SetRenderCallback([this](sf::RenderTarget* w) {this->Render(w); });
 
 	begin_timer = 60;
 }
@@ -44,7 +44,7 @@ void EvolutionScreen::Show(Textbox* src)
 	delay_left = 4;
 }
 
-void EvolutionScreen::Render(sf::RenderWindow* window)
+void EvolutionScreen::Render(sf::RenderTarget* window)
 {
 	if (begin_timer > 0)
 	{
@@ -53,8 +53,8 @@ void EvolutionScreen::Render(sf::RenderWindow* window)
 	}
 
 
-	unsigned char x = pokemon->size_x;
-	unsigned char y = pokemon->size_y;
+	unsigned char x = pokemon->Species().size_x;
+	unsigned char y = pokemon->Species().size_y;
 
 	sf::Sprite pokesprite;
 	if (color_timer > 0)
@@ -62,12 +62,12 @@ void EvolutionScreen::Render(sf::RenderWindow* window)
 		if (color_timer < 255)
 			color_timer--;
 		if (frames == 1)
-			pokesprite.setTexture(*ResourceCache::GetPokemonFront(pokemon->pokedex_index));
+			pokesprite.setTexture(*ResourceCache::GetPokemonFront(pokemon->GetPokedexIndex()));
 		else
 		{
 			pokesprite.setTexture(*to_black);
-			x = pokemon_to->size_x;
-			y = pokemon_to->size_y;
+			x = pokemon_to->Species().size_x;
+			y = pokemon_to->Species().size_y;
 			if (!color_timer)
 				delay = 255;
 		}
@@ -78,21 +78,21 @@ void EvolutionScreen::Render(sf::RenderWindow* window)
 		{
 			delay_left--;
 			pokesprite.setTexture(*from_black);
-			x = pokemon->size_x;
-			y = pokemon->size_y;
+			x = pokemon->Species().size_x;
+			y = pokemon->Species().size_y;
 		}
 		else if (frames_left > 0)
 		{
 			pokesprite.setTexture((frames_left % 6 > 2 ? *from_black : *to_black));
-			x = (frames_left % 6 > 2 ? pokemon->size_x : pokemon_to->size_x);
-			y = (frames_left % 6 > 2 ? pokemon->size_y : pokemon_to->size_y);
+			x = (frames_left % 6 > 2 ? pokemon->Species().size_x : pokemon_to->Species().size_x);
+			y = (frames_left % 6 > 2 ? pokemon->Species().size_y : pokemon_to->Species().size_y);
 			frames_left--;
 		}
 		else
 		{
 			if (delay == 255)
 			{
-				pokesprite.setTexture(*ResourceCache::GetPokemonFront(pokemon_to->pokedex_index));
+				pokesprite.setTexture(*ResourceCache::GetPokemonFront(pokemon_to->GetPokedexIndex()));
 				if (main_frame->GetTextboxes().size() == 0)
 					Finalize();
 			}
@@ -101,8 +101,8 @@ void EvolutionScreen::Render(sf::RenderWindow* window)
 				pokesprite.setTexture(*to_black);
 				color_timer = 50;
 			}
-			x = pokemon_to->size_x;
-			y = pokemon_to->size_y;
+			x = pokemon_to->Species().size_x;
+			y = pokemon_to->Species().size_y;
 		}
 		if (frames_left == 0 && delay_left == 0 && delay > 1 && delay != 255 && !color_timer)
 		{
@@ -119,31 +119,29 @@ void EvolutionScreen::Render(sf::RenderWindow* window)
 	pokesprite.setTextureRect(ir);
 	pokesprite.setPosition((float)(56), (float)(64 - ir.height + 16));
 	window->draw(pokesprite);
+	Profiler::CountDraw(pokesprite.getTexture());
 }
 
 void EvolutionScreen::Finalize()
 {
 	Textbox* main_frame = this->main_frame;
-	Textbox* evolved = new Textbox();
+	Textbox* evolved = Textbox::Create();
 
 	bool learned_move = false;
 	std::function<void(TextItem* s)> m_f = nullptr;
-	for (int i = 0; i < 16; i++)
+	const unsigned char* learned;
+	unsigned char learned_count = pokemon_to->Species().GetMovesLearned(pokemon->level - 1, pokemon->level, &learned);
+	if (learned_count > 0)
 	{
-		if (pokemon_to->learnset[i].level == 0)
-			break;
-		if (pokemon_to->learnset[i].level == pokemon->level)
-		{
-			m_f = PokemonUtils::LearnMove(evolved, pokemon, pokemon_to->learnset[i].move);
-			learned_move = true;
-		}
+		m_f = PokemonUtils::LearnMove(evolved, pokemon, learned[learned_count - 1]);
+		learned_move = true;
 	}
 
 	std::function<void(TextItem* s)> a = [m_f, evolved](TextItem* src) {
 		evolved->CancelClose(); 
 		m_f(src); 
 	};
-	evolved->SetText(new TextItem(evolved, (!m_f ? [main_frame, evolved](TextItem* src) {evolved->Close(); main_frame->Close(); } : a), string(pokemon->nickname).append(pokestring(" evolved\ninto ")).append(pokemon_to->original_name).append(pokestring("!\t\t\t\t\t\t\a"))));
+	evolved->SetText(TextItem::Create(evolved, (!m_f ? [main_frame, evolved](TextItem* src) {evolved->Close(); main_frame->Close(); } : a), string(pokemon->nickname).append(pokestring(" evolved\ninto ")).append(pokemon_to->GetName()).append(pokestring("!\t\t\t\t\t\t\a"))));
 	main_frame->ShowTextbox(evolved, false);
 	if (learned_move)
 	{
@@ -157,7 +155,6 @@ void EvolutionScreen::Finalize()
 	}
 
 	pokemon->id = pokemon_to->id;
-	pokemon->pokedex_index = pokemon_to->pokedex_index;
 	pokemon->LoadStats();
 	unsigned int hp = pokemon->max_hp;
 	pokemon->RecalculateStats();
@@ -176,7 +173,7 @@ void EvolutionScreen::HitB()
 	color_timer = 255;
 	frames = 1;
 	Textbox* frame = main_frame;
-	Textbox* canceled = new Textbox();
-	canceled->SetText(new TextItem(canceled, [frame](TextItem* src) {frame->Close(true); }, pokestring("Huh? ").append(pokemon->nickname).append(pokestring("\nstopped evolving!\f"))));
+	Textbox* canceled = Textbox::Create();
+	canceled->SetText(TextItem::Create(canceled, [frame](TextItem* src) {frame->Close(true); }, pokestring("Huh? ").append(pokemon->nickname).append(pokestring("\nstopped evolving!\f"))));
 	main_frame->ShowTextbox(canceled, false);
 }
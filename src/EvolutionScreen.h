@@ -11,7 +11,7 @@ public:
 	~EvolutionScreen();
 
 	void Show(Textbox* src);
-	void Render(sf::RenderWindow* window);
+	void Render(sf::RenderTarget* window);
 
 private:
 	Textbox* parent;
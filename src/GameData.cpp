@@ -0,0 +1,273 @@
+#include "GameData.h"
+#include <cstring>
+#include <algorithm>
+#include "Constants.h"
+#include "Utils.h"
+
+DataBlock* GameData::ascii_table = 0;
+
+SpeciesInfo GameData::species_info[256];
+unsigned char SpeciesInfo::item_slots[256];
+unsigned char GameData::evolution_item_count = 0;
+DataBlock* GameData::pokemon_indexes = 0;
+string GameData::pokemon_names[256];
+
+string GameData::move_names[256];
+MoveInfo GameData::move_info[256];
+
+DataBlock* GameData::trainer_parties[256];
+
+void GameData::LoadAll(const string& directory)
+{
+	LoadText(directory);
+	LoadPokemon(directory);
+	LoadMoves(directory);
+	LoadTrainerParties(directory);
+}
+
+void GameData::LoadText(const string& directory)
+{
+	ascii_table = ReadFile(string(directory).append("misc/ascii_table.dat"));
+}
+
+void GameData::LoadPokemon(const string& directory)
+{
+#ifdef _DEBUG
+	cout << "--Loading Pokemon data...";
+#endif
+	//stats are stored by pokedex number, everything else by the internal index
+	DataBlock* stats[256];
+	for (int i = 0; i < 256; i++)
+		stats[i] = ReadFile(string(directory).append("pokemon/stats/").append(itos(i)).append(".dat"));
+
+	pokemon_indexes = ReadFile(string(directory).append("pokemon/dex_indexes.dat"));
+	LoadNames(string(directory).append("pokemon/names.dat"), pokemon_names);
+
+	memset(SpeciesInfo::item_slots, EVOLUTION_ITEM_SLOTS, sizeof(SpeciesInfo::item_slots));
+	evolution_item_count = 0;
+	for (int i = 0; i < 256; i++)
+	{
+		DataBlock* leveling = ReadFile(string(directory).append("pokemon/leveling/").append(itos(i)).append(".dat"));
+		LoadSpecies(species_info[i], stats[(unsigned char)(GetPokedexIndex(i) - 1)], leveling);
+		if (leveling)
+			delete leveling;
+	}
+	for (int i = 0; i < 256; i++)
+	{
+		if (stats[i])
+			delete stats[i];
+	}
+
+#ifdef _DEBUG
+	cout << "Done\n";
+#endif
+}
+
+void GameData::LoadMoves(const string& directory)
+{
+#ifdef _DEBUG
+	cout << "--Loading moves...";
+#endif
+	LoadNames(string(directory).append("moves/names.dat"), move_names);
+
+	//move ids start at 1, so entry 0 stays empty
+	DataBlock* d = ReadFile(string(directory).append("moves/moves.dat"));
+	if (d)
+	{
+		unsigned int count = min(255u, d->size / (unsigned int)sizeof(MoveInfo));
+		memcpy(move_info + 1, d->data_start, count * sizeof(MoveInfo));
+		delete d;
+	}
+
+#ifdef _DEBUG
+	cout << "Done\n";
+#endif
+}
+
+void GameData::LoadTrainerParties(const string& directory)
+{
+#ifdef _DEBUG
+	cout << "--Loading trainer parties...";
+#endif
+	for (int i = 0; i < 256; i++)
+		trainer_parties[i] = ReadFile(string(directory).append("trainers/parties/").append(itos(i)).append(".dat"));
+
+#ifdef _DEBUG
+	cout << "Done\n";
+#endif
+}
+
+unsigned char GameData::GetTrainerParty(unsigned char trainer_class, unsigned char pokemon_set, unsigned char* species, unsigned char* levels)
+{
+	DataBlock* d = trainer_parties[trainer_class];
+	if (!d || pokemon_set == 0)
+		return 0;
+
+	//the parties are stored one after another, each ended by a 0. a party is either a level followed by the species
+	//that all share it, or 0xFF followed by level and species pairs
+	unsigned char* p = d->data_start;
+	unsigned char* end = d->data_start + d->size;
+	for (unsigned char i = 1; i < pokemon_set && p < end; i++)
+	{
+		bool pairs = *p == 0xFF;
+		p++;
+		while (p < end && *p != 0)
+			p += pairs ? 2 : 1;
+		p++;
+	}
+	if (p >= end)
+		return 0;
+
+	unsigned char count = 0;
+	if (*p == 0xFF)
+	{
+		for (p++; p + 1 < end && *p != 0 && count < 6; p += 2, count++)
+		{
+			levels[count] = p[0];
+			species[count] = p[1];
+		}
+	}
+	else
+	{
+		unsigned char level = *p++;
+		for (; p < end && *p != 0 && count < 6; p++, count++)
+		{
+			levels[count] = level;
+			species[count] = *p;
+		}
+	}
+	return count;
+}
+
+void GameData::Release()
+{
+	if (ascii_table)
+		delete ascii_table;
+	ascii_table = 0;
+	if (pokemon_indexes)
+		delete pokemon_indexes;
+	pokemon_indexes = 0;
+	for (int i = 0; i < 256; i++)
+	{
+		if (trainer_parties[i])
+			delete trainer_parties[i];
+		trainer_parties[i] = 0;
+	}
+}
+
+void GameData::LoadNames(const string& filename, string* names)
+{
+	DataBlock* d = ReadFile(filename);
+	if (!d)
+		return;
+	unsigned char* p = d->data;
+	for (int i = 0; i < 256; i++)
+	{
+		string s;
+		while ((unsigned int)(p - d->data_start) < d->size && *p != MESSAGE_ENDNAME)
+			s.insert(s.begin() + s.length(), (char)*p++);
+		p++;
+		names[i] = s;
+		//these names get reported as a memory leak
+		//however since theyre static not manually allocated, they will be deleted when the program terminates
+		//the leak reportings are false
+	}
+	delete d;
+}
+
+void GameData::LoadSpecies(SpeciesInfo& s, DataBlock* stats, DataBlock* leveling)
+{
+	s = SpeciesInfo();
+	if (stats)
+	{
+		stats->data = stats->data_start;
+		stats->getc(); //pokedex index; we don't use it because according to padz it's a leftover value
+		s.base_hp = stats->getc();
+		s.base_attack = stats->getc();
+		s.base_defense = stats->getc();
+		s.base_speed = stats->getc();
+		s.base_special = stats->getc();
+		s.type1 = stats->getc();
+		s.type2 = stats->getc();
+		s.catch_rate = stats->getc();
+		s.xp_yield = stats->getc();
+
+		unsigned char size = stats->getc();
+		s.size_x = size & 0xF;
+		s.size_y = (size >> 4) & 0xF;
+		for (int i = 0; i < 4; i++)
+			s.default_moves[i] = stats->getc();
+		s.growth_rate = stats->getc();
+	}
+	for (unsigned char t = 0; t <= TYPE_COUNT; t++)
+		GetTypeMultipliers(t, s.type1, s.type2, s.type_multipliers[t]);
+
+	if (leveling)
+	{
+		//both lists are 0 terminated, the learnset starts right after the evolutions
+		leveling->data = leveling->data_start;
+		for (int i = 0; i < 5; i++)
+		{
+			s.evolutions[i].Load(leveling);
+			if (s.evolutions[i].trigger == 0)
+				break;
+		}
+		for (int i = 0; i < 16; i++)
+		{
+			s.learnset[i].Load(leveling);
+			if (!s.learnset[i].level)
+				break;
+		}
+	}
+	IndexSpecies(s);
+}
+
+void GameData::IndexSpecies(SpeciesInfo& s)
+{
+	//the game's learnsets are already in level order, but sorting makes sure the moves for each level are together
+	LearnsetMove sorted[16];
+	unsigned char count = 0;
+	while (count < 16 && s.learnset[count].level)
+	{
+		sorted[count] = s.learnset[count];
+		count++;
+	}
+	std::stable_sort(sorted, sorted + count, [](const LearnsetMove& a, const LearnsetMove& b) { return a.level < b.level; });
+	unsigned char next = 0;
+	for (int level = 0; level <= 101; level++)
+	{
+		while (next < count && sorted[next].level < level)
+			next++;
+		s.learnset_starts[level] = next;
+	}
+	for (int i = 0; i < count; i++)
+		s.learnset_moves[i] = sorted[i].move;
+
+	//the first evolution in the list that applies wins, same as searching it
+	for (int level = 0; level <= 100; level++)
+	{
+		s.level_evolutions[level] = 0;
+		for (int i = 0; i < 5 && s.evolutions[i].trigger; i++)
+		{
+			if (s.evolutions[i].trigger == EVOLUTION_LEVEL && s.evolutions[i].level <= level)
+			{
+				s.level_evolutions[level] = s.evolutions[i].pokemon;
+				break;
+			}
+		}
+	}
+	for (int i = 0; i < 5 && s.evolutions[i].trigger; i++)
+	{
+		if (s.evolutions[i].trigger != EVOLUTION_ITEM)
+			continue;
+		unsigned char& slot = SpeciesInfo::item_slots[s.evolutions[i].item];
+		if (slot == EVOLUTION_ITEM_SLOTS && evolution_item_count < EVOLUTION_ITEM_SLOTS)
+			slot = evolution_item_count++;
+		if (slot < EVOLUTION_ITEM_SLOTS && !s.item_evolutions[slot])
+			s.item_evolutions[slot] = s.evolutions[i].pokemon;
+#ifdef _DEBUG
+		else if (slot == EVOLUTION_ITEM_SLOTS)
+			cout << "Too many evolution items, item " << (int)s.evolutions[i].item << " won't evolve anything\n";
+#endif
+	}
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <string>
+#include "DataBlock.h"
+#include "Events.h"
+
+using namespace std;
+
+//The game's data tables that don't need a window or SFML: the text encoding, names, and species and move data.
+//ResourceCache loads these along with everything else; tools like the battle simulator can load just these.
+class GameData
+{
+public:
+	static void LoadAll(const string& directory); //directory ends with a slash, eg. RESOURCE_DIR
+	static void LoadText(const string& directory);
+	static void LoadPokemon(const string& directory);
+	static void LoadMoves(const string& directory);
+	static void LoadTrainerParties(const string& directory);
+	static void Release();
+
+	inline static DataBlock* GetAsciiTable() { return ascii_table; }
+
+	inline static SpeciesInfo& GetSpeciesInfo(unsigned char created_index) { return species_info[created_index]; }
+	inline static unsigned char GetPokedexIndex(unsigned char created_index) { if (pokemon_indexes) return pokemon_indexes->data[created_index]; return 0; }
+	inline static string& GetPokemonName(unsigned char created_index) { return pokemon_names[created_index]; }
+
+	inline static string& GetMoveName(unsigned char index) { return move_names[index]; }
+	inline static MoveInfo& GetMoveInfo(unsigned char id) { return move_info[id]; } //indexed by move id, 0 is an empty entry
+
+	//fills in up to 6 species (the game ids Pokemon uses) and levels for one of a trainer class's parties (pokemon_set from the map data, starting at 1).
+	//returns the party size, 0 if there's no such party
+	static unsigned char GetTrainerParty(unsigned char trainer_class, unsigned char pokemon_set, unsigned char* species, unsigned char* levels);
+
+private:
+	static DataBlock* ascii_table;
+
+	static SpeciesInfo species_info[256];
+	static DataBlock* pokemon_indexes;
+	static string pokemon_names[256];
+
+	static string move_names[256];
+	static MoveInfo move_info[256];
+
+	static DataBlock* trainer_parties[256]; //each class's parties, in the game's format
+	static unsigned char evolution_item_count; //how many of SpeciesInfo::item_slots have been handed out
+
+	static void LoadNames(const string& filename, string* names); //256 names, each ended by MESSAGE_ENDNAME
+	static void LoadSpecies(SpeciesInfo& s, DataBlock* stats, DataBlock* leveling);
+	static void IndexSpecies(SpeciesInfo& s); //fills in the lookups for the evolution and learnset lists
+};
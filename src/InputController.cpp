@@ -0,0 +1,3 @@
+#include "InputController.h"
+
+bool InputController::last_keys[256];
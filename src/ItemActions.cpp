@@ -42,9 +42,9 @@ void ItemActions::UseItem(ItemStorage* inventory, TextItem* src, unsigned char i
 	switch (usage)
 	{
 	case 0:
-		t = new Textbox();
+		t = Textbox::Create();
 		s = string(pokestring("OAK: ")).append(inventory->GetOwner()->GetName()).append(pokestring("!\nThis isn't the\vtime to use that!\f"));
-		t->SetText(new TextItem(t, [inventory](TextItem* src)
+		t->SetText(TextItem::Create(t, [inventory](TextItem* src)
 		{
 			inventory->GetMenu()->GetTextboxes()[0]->Close();
 		}, s));
@@ -57,9 +57,9 @@ void ItemActions::UseItem(ItemStorage* inventory, TextItem* src, unsigned char i
 			map = ((MapScene*)Engine::GetActiveScene());
 			if (!ResourceCache::CanUseBicycle(map->GetMap()->tileset) && map->GetMap()->index != 34 && map->GetMap()->index != 9)
 			{
-				t = new Textbox();
+				t = Textbox::Create();
 				s = pokestring("No cycling\nallowed here.\f");
-				t->SetText(new TextItem(t, [inventory](TextItem* src)
+				t->SetText(TextItem::Create(t, [inventory](TextItem* src)
 				{
 					inventory->GetMenu()->GetTextboxes()[0]->Close();
 				}, s));
@@ -67,7 +67,7 @@ void ItemActions::UseItem(ItemStorage* inventory, TextItem* src, unsigned char i
 				break;
 			}
 
-			t = new Textbox();
+			t = Textbox::Create();
 			if (map->GetEntities()[0]->GetIndex() != 0)
 			{
 				s = string(inventory->GetOwner()->GetName()).append(pokestring(" got on the\nbicycle!\f"));
@@ -78,7 +78,7 @@ void ItemActions::UseItem(ItemStorage* inventory, TextItem* src, unsigned char i
 				s = string(inventory->GetOwner()->GetName()).append(pokestring(" got off the\nbicycle.\f"));
 				Engine::GetMusicPlayer().Play(ResourceCache::GetMusicIndex(map->GetMap()->index));
 			}
-			t->SetText(new TextItem(t, [inventory, map](TextItem* src)
+			t->SetText(TextItem::Create(t, [inventory, map](TextItem* src)
 			{
 				if (map->GetEntities()[0]->GetIndex() != 0)
 					map->GetEntities()[0]->SetSprite(0);
@@ -97,17 +97,8 @@ void ItemActions::UseItem(ItemStorage* inventory, TextItem* src, unsigned char i
 		{
 			if (!Players::GetPlayer1()->GetParty()[i])
 				break;
-			for (int e = 0; e < 5; e++)
-			{
-				if (!Players::GetPlayer1()->GetParty()[i]->evolutions[e].trigger)
-					break;
-				Pokemon* p = Players::GetPlayer1()->GetParty()[i];
-				if (p->evolutions[e].trigger == EVOLUTION_ITEM && Players::GetPlayer1()->GetParty()[i]->evolutions[e].item == id)
-				{
-					able[i] = true;
-					break;
-				}
-			}
+			if (Players::GetPlayer1()->GetParty()[i]->Species().GetItemEvolution(id))
+				able[i] = true;
 		}
 		MenuCache::PokemonMenu()->SetAbleNotAble(able);
 
@@ -121,9 +112,9 @@ void ItemActions::UseItem(ItemStorage* inventory, TextItem* src, unsigned char i
 			map = ((MapScene*)Engine::GetActiveScene());
 			if (map->GetMap()->index == 0xF7 || !ResourceCache::CanUseEscapeRope(map->GetMap()->tileset))
 			{
-				t = new Textbox();
+				t = Textbox::Create();
 				s = string(pokestring("OAK: ")).append(inventory->GetOwner()->GetName()).append(pokestring("!\nThis isn't the\vtime to use that!\f"));
-				t->SetText(new TextItem(t, [inventory](TextItem* src)
+				t->SetText(TextItem::Create(t, [inventory](TextItem* src)
 				{
 					inventory->GetMenu()->GetTextboxes()[0]->Close();
 				}, s));
@@ -150,9 +141,9 @@ void ItemActions::UseItem(ItemStorage* inventory, TextItem* src, unsigned char i
 
 		if (state == States::OVERWORLD) //we must check in case someone modifies the item usage to work in battle
 			((MapScene*)Engine::GetActiveScene())->SetRepel(v);
-		t = new Textbox();
+		t = Textbox::Create();
 		s = string(inventory->GetOwner()->GetName()).append(pokestring(" used\n")).append(ResourceCache::GetItemName(id)).append(pokestring("!\f"));
-		t->SetText(new TextItem(t, [inventory](TextItem* src) { inventory->GetMenu()->GetTextboxes()[0]->Close(); inventory->RemoveItemFromSlot(last_src->index, 1); }, s));
+		t->SetText(TextItem::Create(t, [inventory](TextItem* src) { inventory->GetMenu()->GetTextboxes()[0]->Close(); inventory->RemoveItemFromSlot(last_src->index, 1); }, s));
 		src->GetParent()->ShowTextbox(t, false);
 		break;
 
@@ -177,9 +168,9 @@ void ItemActions::UseItem(ItemStorage* inventory, TextItem* src, unsigned char i
 		break;
 
 	default:
-		t = new Textbox();
+		t = Textbox::Create();
 		s = pokestring("Sorry, that item\nhasn't been\vimplemented yet.");
-		t->SetText(new TextItem(t, [inventory](TextItem* src)
+		t->SetText(TextItem::Create(t, [inventory](TextItem* src)
 		{
 			inventory->GetMenu()->GetTextboxes()[0]->Close();
 		}, s));
@@ -344,8 +335,8 @@ void ItemActions::UseMedicine(TextItem* src)
 		return;
 	}
 
-	Textbox* t = new Textbox();
-	t->SetText(new TextItem(src->GetParent(), [items](TextItem* s){MenuCache::PokemonMenu()->GetMenu()->Close(); }, pokestring("It won't have any\n\neffect.")));
+	Textbox* t = Textbox::Create();
+	t->SetText(TextItem::Create(src->GetParent(), [items](TextItem* s){MenuCache::PokemonMenu()->GetMenu()->Close(); }, pokestring("It won't have any\n\neffect.")));
 	MenuCache::PokemonMenu()->GetMenu()->SetArrowState(ArrowStates::INACTIVE);
 	src->GetParent()->ShowTextbox(t, false);
 }
@@ -367,8 +358,8 @@ void ItemActions::UseVitamin(TextItem* src)
 		p->RecalculateStats();
 		p->hp += p->max_hp - stat;
 
-		t = new Textbox();
-		t->SetText(new TextItem(src->GetParent(), [items](TextItem* s){MenuCache::PokemonMenu()->GetMenu()->Close(); }, string(p->nickname).append(pokestring("'s\n\nHEALTH rose.\f"))));
+		t = Textbox::Create();
+		t->SetText(TextItem::Create(src->GetParent(), [items](TextItem* s){MenuCache::PokemonMenu()->GetMenu()->Close(); }, string(p->nickname).append(pokestring("'s\n\nHEALTH rose.\f"))));
 		MenuCache::PokemonMenu()->GetMenu()->SetArrowState(ArrowStates::INACTIVE);
 		src->GetParent()->ShowTextbox(t, false);
 		last_inventory->RemoveItemFromSlot(last_src->index, 1);
@@ -379,8 +370,8 @@ void ItemActions::UseVitamin(TextItem* src)
 			break;
 		p->ev_attack = min(p->ev_attack + EV_MAXVITAMIN / 10, EV_MAXVITAMIN);
 		p->RecalculateStats();
-		t = new Textbox();
-		t->SetText(new TextItem(src->GetParent(), [items](TextItem* s){MenuCache::PokemonMenu()->GetMenu()->Close(); }, string(p->nickname).append(pokestring("'s\n\nATTACK rose.\f"))));
+		t = Textbox::Create();
+		t->SetText(TextItem::Create(src->GetParent(), [items](TextItem* s){MenuCache::PokemonMenu()->GetMenu()->Close(); }, string(p->nickname).append(pokestring("'s\n\nATTACK rose.\f"))));
 		MenuCache::PokemonMenu()->GetMenu()->SetArrowState(ArrowStates::INACTIVE);
 		src->GetParent()->ShowTextbox(t, false);
 		last_inventory->RemoveItemFromSlot(last_src->index, 1);
@@ -391,8 +382,8 @@ void ItemActions::UseVitamin(TextItem* src)
 			break;
 		p->ev_defense = min(p->ev_defense + EV_MAXVITAMIN / 10, EV_MAXVITAMIN);
 		p->RecalculateStats();
-		t = new Textbox();
-		t->SetText(new TextItem(src->GetParent(), [items](TextItem* s){MenuCache::PokemonMenu()->GetMenu()->Close(); }, string(p->nickname).append(pokestring("'s\n\nDEFENSE rose.\f"))));
+		t = Textbox::Create();
+		t->SetText(TextItem::Create(src->GetParent(), [items](TextItem* s){MenuCache::PokemonMenu()->GetMenu()->Close(); }, string(p->nickname).append(pokestring("'s\n\nDEFENSE rose.\f"))));
 		MenuCache::PokemonMenu()->GetMenu()->SetArrowState(ArrowStates::INACTIVE);
 		src->GetParent()->ShowTextbox(t, false);
 		last_inventory->RemoveItemFromSlot(last_src->index, 1);
@@ -403,8 +394,8 @@ void ItemActions::UseVitamin(TextItem* src)
 			break;
 		p->ev_speed = min(p->ev_speed + EV_MAXVITAMIN / 10, EV_MAXVITAMIN);
 		p->RecalculateStats();
-		t = new Textbox();
-		t->SetText(new TextItem(src->GetParent(), [items](TextItem* s){MenuCache::PokemonMenu()->GetMenu()->Close(); }, string(p->nickname).append(pokestring("'s\n\nSPEED rose.\f"))));
+		t = Textbox::Create();
+		t->SetText(TextItem::Create(src->GetParent(), [items](TextItem* s){MenuCache::PokemonMenu()->GetMenu()->Close(); }, string(p->nickname).append(pokestring("'s\n\nSPEED rose.\f"))));
 		MenuCache::PokemonMenu()->GetMenu()->SetArrowState(ArrowStates::INACTIVE);
 		src->GetParent()->ShowTextbox(t, false);
 		last_inventory->RemoveItemFromSlot(last_src->index, 1);
@@ -415,8 +406,8 @@ void ItemActions::UseVitamin(TextItem* src)
 			break;
 		p->ev_special = min(p->ev_special + EV_MAXVITAMIN / 10, EV_MAXVITAMIN);
 		p->RecalculateStats();
-		t = new Textbox();
-		t->SetText(new TextItem(src->GetParent(), [items](TextItem* s){MenuCache::PokemonMenu()->GetMenu()->Close(); }, string(p->nickname).append(pokestring("'s\n\nSPECIAL rose.\f"))));
+		t = Textbox::Create();
+		t->SetText(TextItem::Create(src->GetParent(), [items](TextItem* s){MenuCache::PokemonMenu()->GetMenu()->Close(); }, string(p->nickname).append(pokestring("'s\n\nSPECIAL rose.\f"))));
 		MenuCache::PokemonMenu()->GetMenu()->SetArrowState(ArrowStates::INACTIVE);
 		src->GetParent()->ShowTextbox(t, false);
 		last_inventory->RemoveItemFromSlot(last_src->index, 1);
@@ -432,8 +423,8 @@ void ItemActions::UseVitamin(TextItem* src)
 		return;
 	}
 
-	t = new Textbox();
-	t->SetText(new TextItem(src->GetParent(), [items](TextItem* s){MenuCache::PokemonMenu()->GetMenu()->Close(); }, pokestring("It won't have any\n\neffect.")));
+	t = Textbox::Create();
+	t->SetText(TextItem::Create(src->GetParent(), [items](TextItem* s){MenuCache::PokemonMenu()->GetMenu()->Close(); }, pokestring("It won't have any\n\neffect.")));
 	MenuCache::PokemonMenu()->GetMenu()->SetArrowState(ArrowStates::INACTIVE);
 	src->GetParent()->ShowTextbox(t, false);
 }
@@ -443,17 +434,9 @@ void ItemActions::UseEvoStone(TextItem* src)
 	Pokemon* p = MenuCache::PokemonMenu()->GetParty()[src->index];
 	ItemStorage* items = last_inventory;
 
-	unsigned char p_into = p->id;
-	for (int e = 0; e < 5; e++)
-	{
-		if (!p->evolutions[e].trigger)
-			break;
-		if (p->evolutions[e].trigger == EVOLUTION_ITEM && p->evolutions[e].item == last_id)
-		{
-			p_into = p->evolutions[e].pokemon;
-			break;
-		}
-	}
+	unsigned char p_into = p->Species().GetItemEvolution(last_id);
+	if (!p_into)
+		p_into = p->id;
 
 	if (MenuCache::PokemonMenu()->GetAblility()[MenuCache::PokemonMenu()->GetMenu()->GetActiveIndex()])
 	{
@@ -462,8 +445,8 @@ void ItemActions::UseEvoStone(TextItem* src)
 		return;
 	}
 
-	Textbox* t = new Textbox();
-	t->SetText(new TextItem(src->GetParent(), [items](TextItem* s){MenuCache::PokemonMenu()->GetMenu()->Close(); }, pokestring("It won't have any\n\neffect.")));
+	Textbox* t = Textbox::Create();
+	t->SetText(TextItem::Create(src->GetParent(), [items](TextItem* s){MenuCache::PokemonMenu()->GetMenu()->Close(); }, pokestring("It won't have any\n\neffect.")));
 	MenuCache::PokemonMenu()->GetMenu()->SetArrowState(ArrowStates::INACTIVE);
 	src->GetParent()->ShowTextbox(t, false);
 }
@@ -473,14 +456,14 @@ void ItemActions::UseEther(TextItem* src)
 	Pokemon* p = MenuCache::PokemonMenu()->GetParty()[src->index];
 	ItemStorage* items = last_inventory;
 
-	Textbox* which = new Textbox();
+	Textbox* which = Textbox::Create();
 	MenuCache::PokemonMenu()->GetMenu()->SetArrowState(ArrowStates::INACTIVE);
 
 	auto show_which = [src, which, p](TextItem* s2)
 	{
 		which->CancelClose();
 		which->SetCloseCallback([](TextItem* s6) {MenuCache::PokemonMenu()->GetMenu()->Close(); });
-		Textbox* moves = new Textbox(4, 7, 16, 6);
+		Textbox* moves = Textbox::Create(4, 7, 16, 6);
 		moves->SetMenu(true, 4, sf::Vector2i(1, 0), sf::Vector2u(0, 1), nullptr, MenuFlags::FOCUSABLE);
 		moves->SetArrowState(ArrowStates::ACTIVE);
 
@@ -489,14 +472,14 @@ void ItemActions::UseEther(TextItem* src)
 			moves->SetCloseCallback([which](TextItem* s5){ which->Close(); });
 			if (p->moves[moves->GetActiveIndex()].pp == p->moves[moves->GetActiveIndex()].max_pp)
 			{
-				Textbox* f = new Textbox();
-				f->SetText(new TextItem(f, [moves](TextItem* s4) {moves->Close(); }, pokestring("It won't have any\neffect.\f")));
+				Textbox* f = Textbox::Create();
+				f->SetText(TextItem::Create(f, [moves](TextItem* s4) {moves->Close(); }, pokestring("It won't have any\neffect.\f")));
 				moves->ShowTextbox(f, false);
 			}
 			else
 			{
-				Textbox* f = new Textbox();
-				f->SetText(new TextItem(f, [moves](TextItem* s4) {moves->Close(); }, pokestring("PP was restored.\f")));
+				Textbox* f = Textbox::Create();
+				f->SetText(TextItem::Create(f, [moves](TextItem* s4) {moves->Close(); }, pokestring("PP was restored.\f")));
 				moves->ShowTextbox(f, false);
 				if (last_id == 0x50)
 					p->moves[moves->GetActiveIndex()].pp = min(p->moves[moves->GetActiveIndex()].pp + 10, (int)p->moves[moves->GetActiveIndex()].max_pp);
@@ -511,12 +494,12 @@ void ItemActions::UseEther(TextItem* src)
 		{
 			if (p->moves[i].index != 0)
 			{
-				moves->GetItems().push_back(new TextItem(moves, move_select, p->moves[i].name, i));
+				moves->GetItems().push_back(TextItem::Create(moves, move_select, p->moves[i].GetName(), i));
 				move_count++;
 			}
 			else
 			{
-				moves->GetItems().push_back(new TextItem(moves, move_select, pokestring("-"), i));
+				moves->GetItems().push_back(TextItem::Create(moves, move_select, pokestring("-"), i));
 			}
 		}
 		moves->SetMaxSelect(move_count);
@@ -530,7 +513,7 @@ void ItemActions::UseEther(TextItem* src)
 		which->ShowTextbox(moves, false);
 	};
 
-	which->SetText(new TextItem(which, show_which, pokestring("Restore PP of\nwhich technique?\a")));
+	which->SetText(TextItem::Create(which, show_which, pokestring("Restore PP of\nwhich technique?\a")));
 	src->GetParent()->ShowTextbox(which, false);
 }
 
@@ -554,15 +537,15 @@ void ItemActions::UseElixer(TextItem* src)
 
 	if (count)
 	{
-		Textbox* t = new Textbox();
-		t->SetText(new TextItem(t, [](TextItem* s) {MenuCache::PokemonMenu()->GetMenu()->Close(); }, pokestring("PP was restored.\f")));
+		Textbox* t = Textbox::Create();
+		t->SetText(TextItem::Create(t, [](TextItem* s) {MenuCache::PokemonMenu()->GetMenu()->Close(); }, pokestring("PP was restored.\f")));
 		MenuCache::PokemonMenu()->GetMenu()->SetArrowState(ArrowStates::INACTIVE);
 		src->GetParent()->ShowTextbox(t, false);
 		return;
 	}
 
-	Textbox* t = new Textbox();
-	t->SetText(new TextItem(src->GetParent(), [items](TextItem* s){MenuCache::PokemonMenu()->GetMenu()->Close(); }, pokestring("It won't have any\n\neffect.")));
+	Textbox* t = Textbox::Create();
+	t->SetText(TextItem::Create(src->GetParent(), [items](TextItem* s){MenuCache::PokemonMenu()->GetMenu()->Close(); }, pokestring("It won't have any\n\neffect.")));
 	MenuCache::PokemonMenu()->GetMenu()->SetArrowState(ArrowStates::INACTIVE);
 	src->GetParent()->ShowTextbox(t, false);
 }
@@ -572,14 +555,14 @@ void ItemActions::UsePPUp(TextItem* src)
 	Pokemon* p = MenuCache::PokemonMenu()->GetParty()[src->index];
 	ItemStorage* items = last_inventory;
 
-	Textbox* which = new Textbox();
+	Textbox* which = Textbox::Create();
 	MenuCache::PokemonMenu()->GetMenu()->SetArrowState(ArrowStates::INACTIVE);
 
 	auto show_which = [src, which, p](TextItem* s2)
 	{
 		which->CancelClose();
 		which->SetCloseCallback([](TextItem* s6) {MenuCache::PokemonMenu()->GetMenu()->Close(); });
-		Textbox* moves = new Textbox(4, 7, 16, 6);
+		Textbox* moves = Textbox::Create(4, 7, 16, 6);
 		moves->SetMenu(true, 4, sf::Vector2i(1, 0), sf::Vector2u(0, 1), nullptr, MenuFlags::FOCUSABLE);
 		moves->SetArrowState(ArrowStates::ACTIVE);
 
@@ -588,18 +571,18 @@ void ItemActions::UsePPUp(TextItem* src)
 			moves->SetCloseCallback([which](TextItem* s5){ which->Close(); });
 			if (p->moves[moves->GetActiveIndex()].pp_ups >= 3)
 			{
-				Textbox* f = new Textbox();
-				f->SetText(new TextItem(f, [moves](TextItem* s4) {moves->Close(); }, string(p->moves[moves->GetActiveIndex()].name).append(pokestring("'s PP\nis maxed out.\f"))));
+				Textbox* f = Textbox::Create();
+				f->SetText(TextItem::Create(f, [moves](TextItem* s4) {moves->Close(); }, string(p->moves[moves->GetActiveIndex()].GetName()).append(pokestring("'s PP\nis maxed out.\f"))));
 				moves->ShowTextbox(f, false);
 			}
 			else
 			{
-				Textbox* f = new Textbox();
-				f->SetText(new TextItem(f, [moves](TextItem* s4) {moves->Close(); }, string(p->moves[moves->GetActiveIndex()].name).append(pokestring("'s PP\nincreased.\f"))));
+				Textbox* f = Textbox::Create();
+				f->SetText(TextItem::Create(f, [moves](TextItem* s4) {moves->Close(); }, string(p->moves[moves->GetActiveIndex()].GetName()).append(pokestring("'s PP\nincreased.\f"))));
 				moves->ShowTextbox(f, false);
 				p->moves[moves->GetActiveIndex()].pp_ups++;
-				p->moves[moves->GetActiveIndex()].max_pp += min(7, p->moves[moves->GetActiveIndex()].original_max_pp / 5);
-				p->moves[moves->GetActiveIndex()].pp += min(7, p->moves[moves->GetActiveIndex()].original_max_pp / 5);
+				p->moves[moves->GetActiveIndex()].max_pp += min(7, p->moves[moves->GetActiveIndex()].Info().max_pp / 5);
+				p->moves[moves->GetActiveIndex()].pp += min(7, p->moves[moves->GetActiveIndex()].Info().max_pp / 5);
 				last_inventory->RemoveItemFromSlot(last_src->index, 1);
 			}
 		};
@@ -609,12 +592,12 @@ void ItemActions::UsePPUp(TextItem* src)
 		{
 			if (p->moves[i].index != 0)
 			{
-				moves->GetItems().push_back(new TextItem(moves, move_select, p->moves[i].name, i));
+				moves->GetItems().push_back(TextItem::Create(moves, move_select, p->moves[i].GetName(), i));
 				move_count++;
 			}
 			else
 			{
-				moves->GetItems().push_back(new TextItem(moves, move_select, pokestring("-"), i));
+				moves->GetItems().push_back(TextItem::Create(moves, move_select, pokestring("-"), i));
 			}
 		}
 		moves->SetMaxSelect(move_count);
@@ -628,6 +611,6 @@ void ItemActions::UsePPUp(TextItem* src)
 		which->ShowTextbox(moves, false);
 	};
 
-	which->SetText(new TextItem(which, show_which, pokestring("Raise PP of which\ntechnique?\a")));
+	which->SetText(TextItem::Create(which, show_which, pokestring("Raise PP of which\ntechnique?\a")));
 	src->GetParent()->ShowTextbox(which, false);
 }
@@ -25,7 +25,7 @@ ItemStorage::ItemStorage(PlayerProperties* owner)
 		}
 	};
 
-	menu = new Textbox(4, 2, 16, 11, false);
+	menu = Textbox::Create(4, 2, 16, 11, false);
 	menu->SetMenu(true, 4, sf::Vector2i(1, 1), sf::Vector2u(0, 2), [](TextItem* source) { MenuCache::StartMenu()->SetArrowState(ArrowStates::ACTIVE); }, MenuFlags::FOCUSABLE | MenuFlags::HOLD_INPUT | MenuFlags::SWITCHABLE, 2, switch_items, false);
 	menu->SetArrowState(ArrowStates::ACTIVE);
 
@@ -38,7 +38,7 @@ ItemStorage::~ItemStorage()
 	{
 		menu->ClearItems();
 		menu->CloseAll();
-		delete menu;
+		Textbox::Release(menu);
 	}
 }
 
@@ -58,8 +58,8 @@ void ItemStorage::GenerateItems()
 		{
 			if (ResourceCache::IsKeyItem(item->value))
 			{
-				Textbox* t = new Textbox();
-				t->SetText(new TextItem(t, [this](TextItem*){this->GetMenu()->SetArrowState(ArrowStates::ACTIVE); this->GetMenu()->CloseAll(); }, pokestring("That's too impor-\ntant to toss!\f")));
+				Textbox* t = Textbox::Create();
+				t->SetText(TextItem::Create(t, [this](TextItem*){this->GetMenu()->SetArrowState(ArrowStates::ACTIVE); this->GetMenu()->CloseAll(); }, pokestring("That's too impor-\ntant to toss!\f")));
 				this->GetMenu()->ShowTextbox(t, false);
 			}
 			else
@@ -77,8 +77,8 @@ void ItemStorage::GenerateItems()
 
 						auto toss_final = [this](TextItem* yesnosrc)
 						{
-							Textbox* threwaway = new Textbox();
-							threwaway->SetText(new TextItem(threwaway, [this](TextItem* src)
+							Textbox* threwaway = Textbox::Create();
+							threwaway->SetText(TextItem::Create(threwaway, [this](TextItem* src)
 							{
 								this->RemoveItemFromSlot(this->GetMenu()->GetInactiveIndex(), this->GetMenu()->GetTextboxes()[1]->GetCounterValue());
 								this->GetMenu()->ResetSelection(); this->GetMenu()->SetArrowState(ArrowStates::ACTIVE);
@@ -91,16 +91,16 @@ void ItemStorage::GenerateItems()
 						};
 
 						from->GetParent()->CancelClose();
-						Textbox* yesno = new Textbox(14, 7, 6, 5);
+						Textbox* yesno = Textbox::Create(14, 7, 6, 5);
 						yesno->SetMenu(true, 2, sf::Vector2i(1, 0), sf::Vector2u(0, 2), close_all, MenuFlags::FOCUSABLE);
 						yesno->SetArrowState(ArrowStates::ACTIVE);
-						yesno->GetItems().push_back(new TextItem(yesno, toss_final, pokestring("YES")));
-						yesno->GetItems().push_back(new TextItem(yesno, close_all, pokestring("NO")));
+						yesno->GetItems().push_back(TextItem::Create(yesno, toss_final, pokestring("YES")));
+						yesno->GetItems().push_back(TextItem::Create(yesno, close_all, pokestring("NO")));
 						yesno->UpdateMenu();
 						this->GetMenu()->ShowTextbox(yesno, false);
 					};
-					Textbox* tb = new Textbox();
-					tb->SetText(new TextItem(tb, confirm_toss_b, pokestring("Is it OK to toss\n").append(ResourceCache::GetItemName(this->GetItems()[this->GetMenu()->GetInactiveIndex()].id)).append(pokestring("?\f"))));
+					Textbox* tb = Textbox::Create();
+					tb->SetText(TextItem::Create(tb, confirm_toss_b, pokestring("Is it OK to toss\n").append(ResourceCache::GetItemName(this->GetItems()[this->GetMenu()->GetInactiveIndex()].id)).append(pokestring("?\f"))));
 					this->GetMenu()->ShowTextbox(tb, false);
 				};
 				auto close_all = [this](TextItem* yesnosrc)
@@ -110,7 +110,7 @@ void ItemStorage::GenerateItems()
 					this->GetMenu()->CloseAll();
 				};
 
-				Textbox* t = new Textbox(15, 9, 5, 3);
+				Textbox* t = Textbox::Create(15, 9, 5, 3);
 				t->SetCounter(true, 1, this->GetItems()[item->index].quantity, confirm, close_all);
 				this->GetMenu()->ShowTextbox(t, false);
 				this->GetMenu()->GetTextboxes()[0]->SetArrowState(ArrowStates::INACTIVE);
@@ -121,8 +121,8 @@ void ItemStorage::GenerateItems()
 		{
 			item->GetParent()->SetArrowState(ArrowStates::INACTIVE);
 			ItemActions::UseItem(this, item, item->value);
-			/*Textbox* t = new Textbox();
-			t->SetText(new TextItem(t, [this](TextItem* src)
+			/*Textbox* t = Textbox::Create();
+			t->SetText(TextItem::Create(t, [this](TextItem* src)
 			{
 				this->GetMenu()->GetTextboxes()[0]->Close();
 			}, pokestring("You just used\n").append(ResourceCache::GetItemName(item->value)).append(pokestring("."))));
@@ -131,11 +131,11 @@ void ItemStorage::GenerateItems()
 
 		this->GetMenu()->SetArrowState(ArrowStates::INACTIVE);
 
-		Textbox* usetoss = new Textbox(13, 10, 7, 5);
+		Textbox* usetoss = Textbox::Create(13, 10, 7, 5);
 		usetoss->SetMenu(true, 2, sf::Vector2i(1, 0), sf::Vector2u(0, 2), [this](TextItem* source){ this->GetMenu()->FlashCursor(); this->GetMenu()->SetArrowState(ArrowStates::ACTIVE); }, MenuFlags::FOCUSABLE);
-		usetoss->GetItems().push_back(new TextItem(usetoss, use, pokestring("USE"), this->GetMenu()->GetInactiveIndex(), this->GetItems()[this->GetMenu()->GetInactiveIndex()].id));
+		usetoss->GetItems().push_back(TextItem::Create(usetoss, use, pokestring("USE"), this->GetMenu()->GetInactiveIndex(), this->GetItems()[this->GetMenu()->GetInactiveIndex()].id));
 
-		usetoss->GetItems().push_back(new TextItem(usetoss, toss, pokestring("TOSS"), this->GetMenu()->GetInactiveIndex(), this->GetItems()[this->GetMenu()->GetInactiveIndex()].id));
+		usetoss->GetItems().push_back(TextItem::Create(usetoss, toss, pokestring("TOSS"), this->GetMenu()->GetInactiveIndex(), this->GetItems()[this->GetMenu()->GetInactiveIndex()].id));
 		usetoss->UpdateMenu();
 		usetoss->SetArrowState(ArrowStates::ACTIVE);
 		menu->ShowTextbox(usetoss, false);
@@ -153,9 +153,9 @@ void ItemStorage::GenerateItems()
 			amt.insert(amt.begin(), ' ');
 		if (!ResourceCache::IsKeyItem(items[i].id))
 			s.append(pokestring("\n        *")).append(pokestring(amt));
-		menu->GetItems().push_back(new TextItem(menu, select, s, i, items[i].id));
+		menu->GetItems().push_back(TextItem::Create(menu, select, s, i, items[i].id));
 	}
-	menu->GetItems().push_back(new TextItem(menu, [this](TextItem* src){ this->GetMenu()->Close(); }, pokestring("CANCEL")));
+	menu->GetItems().push_back(TextItem::Create(menu, [this](TextItem* src){ this->GetMenu()->Close(); }, pokestring("CANCEL")));
 	menu->UpdateMenu();
 }
 
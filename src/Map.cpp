@@ -171,6 +171,8 @@ void Map::LoadWild()
 		data->data += 20;
 	}
 
+	grass_table.Build(grass_encounters, grass_rate, ResourceCache::GetWildChances());
+	water_table.Build(water_encounters, water_rate, ResourceCache::GetWildChances());
 	delete data;
 }
 
@@ -390,7 +392,7 @@ bool Map::CanWarp(int x, int y, unsigned char direction, Warp* check_warp)
 	return false;
 }
 
-void Map::RenderRectangle(int x, int y, int width, int height, sf::Sprite& sprite, sf::RenderWindow* window)
+void Map::RenderRectangle(int x, int y, int width, int height, PaletteTexture* texture, SpriteBatch& batch)
 {
 	int delta_y = (y < 0 ? (y - 7) / 8 * 8 + y % 8 : 0);
 	y -= delta_y;
@@ -407,13 +409,13 @@ void Map::RenderRectangle(int x, int y, int width, int height, sf::Sprite& sprit
 			int h = 8 - y % 8;
 			if (y + h > _py + height)
 				h = _py + height - y;
+			if (w <= 0 || h <= 0) //the edges land on tile boundaries
+				continue;
 			src_rect.left = (tile % 16) * 8 + (8 - w);
 			src_rect.top = (tile / 16) * 8 + y % 8;
 			src_rect.width = w;
 			src_rect.height = h;
-			sprite.setTextureRect(src_rect);
-			sprite.setPosition((float)(lX + 8 - w), (float)y);
-			window->draw(sprite);
+			batch.Add(lX + 8 - w, y, texture, src_rect);
 		}
 	}
 }
@@ -8,6 +8,7 @@
 #include "DataBlock.h"
 #include "MapConnection.h"
 #include "Events.h"
+#include "EncounterTable.h"
 #include "OverworldEntity.h"
 
 class Map
@@ -38,6 +39,8 @@ public:
 	WildEncounter water_encounters[10];
 	unsigned char grass_rate;
 	unsigned char water_rate;
+	EncounterTable grass_table; //built from the encounters above by LoadWild
+	EncounterTable water_table;
 
 	inline bool HasConnection(unsigned char e) { return (connection_mask & (1 << (3 - e))) != 0; }
 	inline sf::Color* GetPalette() { return palette; }
@@ -48,7 +51,7 @@ public:
 	bool InGrass(int x, int y, bool wild = false);
 	bool CanWarp(int x, int y, unsigned char direction, Warp* check_warp);
 
-	void RenderRectangle(int x, int y, int width, int height, sf::Sprite& sprite, sf::RenderWindow* window);
+	void RenderRectangle(int x, int y, int width, int height, PaletteTexture* texture, SpriteBatch& batch);
 
 	Warp GetWarp(unsigned int index)
 	{
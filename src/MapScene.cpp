@@ -17,6 +17,20 @@ MapScene::MapScene() : Scene()
 	transition_index = 255;
 	transition_timer = 0;
 	wild_steps = 3;
+	trainer_class = 0;
+	trainer_party = 0;
+	forced_direction = MOVEMENT_NONE;
+
+	background.create(BACKGROUND_BLOCKS_X * 32, BACKGROUND_BLOCKS_Y * 32);
+	background_valid = false;
+	background_poisoned = false;
+	background_palette_changes = 0;
+	for (int i = 0; i < 5; i++)
+		background_tilesets[i] = 0;
+
+	drawn_map = 255;
+	drawn_animation_frame = 0;
+	drawn_palette_changes = 0;
 
 	//Initialize the player
 	entities.push_back(new OverworldEntity(active_map, 0, 1, 11, 7, ENTITY_DOWN, false, nullptr, [this]() {Walk(); }));
@@ -60,7 +74,12 @@ void MapScene::Update()
 		{
 			if (!Interact())
 			{
-				if (sf::Keyboard::isKeyPressed(INPUT_DOWN))
+				if (forced_direction != MOVEMENT_NONE)
+				{
+					focus_entity->StartMoving(forced_direction);
+					TryResetWarp();
+				}
+				else if (sf::Keyboard::isKeyPressed(INPUT_DOWN))
 				{
 					focus_entity->StartMoving(ENTITY_DOWN);
 					TryResetWarp();
@@ -98,10 +117,13 @@ void MapScene::Update()
 		else
 			focus_entity->StopMoving();
 
-		for (unsigned int i = 0; i < entities.size(); i++)
 		{
-			if (entities[i])
-				entities[i]->Update();
+			ProfileScope profile(ProfileSections::ENTITY_UPDATE);
+			for (unsigned int i = 0; i < entities.size(); i++)
+			{
+				if (entities[i])
+					entities[i]->Update();
+			}
 		}
 
 		int x = (int)(focus_entity ? focus_entity->x : 0);
@@ -155,43 +177,78 @@ void MapScene::Update()
 
 }
 
-void MapScene::Render(sf::RenderWindow* window)
+void MapScene::Render(sf::RenderTarget* window)
 {
 	FocusFree(focus_entity->x, focus_entity->y);
 	window->setView(viewport);
 
 	if (active_map)
 	{
-		DrawMap(window, *active_map, -1, 0);
-		for (int i = 0; i < 4; i++)
-		{
-			if (active_map->HasConnection(i))
-			{
-				DrawMap(window, *active_map->connected_maps[i], i, &active_map->connections[i]);
-			}
-		}
+		ProfileScope profile(ProfileSections::MAP_RENDER);
+		DrawBackground(window);
 	}
 
-	for (int i = entities.size() - 1; i > -1; i--)
-		entities[i]->Render(window);
-	for (int i = entities.size() - 1; i > -1; i--) //draw emote bubbles on top
-		entities[i]->DrawEmoteBubble(window);
+	{
+		ProfileScope profile(ProfileSections::ENTITY_RENDER);
+		//the player is first in the list but gets drawn last so it ends up on top
+		for (int i = entities.size() - 1; i > -1; i--)
+			entities[i]->Render(entity_layers);
+		entity_layers.Draw(window);
+		entity_layers.Clear();
+	}
 	window->setView(window->getDefaultView());
 
 	for (unsigned int i = 0; i < textboxes.size(); i++)
 		textboxes[i]->Render(window);
 
 	DrawBattleTransition(window);
+
+	drawn_map = active_map ? active_map->index : 255;
+	drawn_animation_frame = GetAnimationFrame();
+	drawn_palette_changes = PaletteTexture::GetChangeCount();
+	drawn_entities = entities;
+	MarkTextboxesDrawn();
+}
+
+bool MapScene::NeedsRedraw()
+{
+	//transitions change the screen every few frames anyway
+	if (!active_map || transition_index != 255 || teleport_stage != 0)
+		return true;
+	if (active_map->index != drawn_map || GetAnimationFrame() != drawn_animation_frame || PaletteTexture::GetChangeCount() != drawn_palette_changes)
+		return true;
+
+	//the camera follows the focus entity, so this covers scrolling too
+	if (entities != drawn_entities)
+		return true;
+	for (unsigned int i = 0; i < entities.size(); i++)
+	{
+		if (entities[i]->NeedsRedraw())
+			return true;
+	}
+	return TextboxesNeedRedraw();
+}
+
+unsigned int MapScene::GetAnimationFrame()
+{
+	if (!active_map)
+		return 0;
+	Tileset* tileset = ResourceCache::GetTileset(active_map->tileset);
+	return tileset ? tileset->GetAnimationFrame() : 0;
 }
 
 void MapScene::NotifySwitchedTo()
 {
 	poison_steps = 4;
+	//battles leave the menu and font textures in their own palette
+	if (active_map)
+		SetPalette(active_map->GetPalette());
 }
 
 void MapScene::SwitchMap(unsigned char index)
 {
 	ClearEntities();
+	background_valid = false;
 	unsigned char previous_palette = 0;
 	if (index <= OUTSIDE_MAP)
 		previous_map = index;
@@ -255,12 +312,67 @@ void MapScene::FocusFree(int x, int y)
 	viewport.reset(sf::FloatRect((float)(x - (int)(VIEWPORT_WIDTH / 2 - 1) * 16), (float)(y - ((int)(VIEWPORT_HEIGHT / 2)) * 16), VIEWPORT_WIDTH * 16, VIEWPORT_HEIGHT * 16));
 }
 
-void MapScene::DrawMap(sf::RenderWindow* window, Map& map, int connection_index, MapConnection* connection)
+void MapScene::DrawBackground(sf::RenderTarget* window)
+{
+	int left = (int)(viewport.getCenter().x - viewport.getSize().x / 2);
+	int top = (int)(viewport.getCenter().y - viewport.getSize().y / 2);
+	//round towards negative infinity since the camera can go past the top left of the map
+	sf::Vector2i origin((left < 0 ? (left - 31) / 32 : left / 32) - 1, (top < 0 ? (top - 31) / 32 : top / 32) - 1);
+
+	//scrolling inside a block just moves the texture, only rebuild when the tiles themselves could look different
+	Tileset* tileset = ResourceCache::GetTileset(active_map->tileset);
+	bool poisoned = tileset && tileset->IsPoisoned();
+	if (!background_valid || origin != background_origin || poisoned != background_poisoned || PaletteTexture::GetChangeCount() != background_palette_changes)
+	{
+		background_origin = origin;
+		background_poisoned = poisoned;
+		BuildBackground();
+		background_palette_changes = PaletteTexture::GetChangeCount();
+		background_valid = true;
+	}
+
+	sf::Sprite sprite(background.getTexture());
+	sprite.setPosition((float)(origin.x * 32), (float)(origin.y * 32));
+	window->draw(sprite);
+	Profiler::CountDraw(sprite.getTexture());
+	for (int i = 0; i < 5; i++)
+	{
+		if (background_tilesets[i])
+			background_tilesets[i]->RenderAnimatedTiles(window, background_animations[i]);
+	}
+}
+
+void MapScene::BuildBackground()
+{
+	sf::IntRect blocks(background_origin.x, background_origin.y, BACKGROUND_BLOCKS_X, BACKGROUND_BLOCKS_Y);
+	background.setView(sf::View(sf::FloatRect((float)(blocks.left * 32), (float)(blocks.top * 32), (float)(blocks.width * 32), (float)(blocks.height * 32))));
+	background.clear();
+	for (int i = 0; i < 5; i++)
+	{
+		background_animations[i].water.clear();
+		background_animations[i].flowers.clear();
+		background_tilesets[i] = 0;
+	}
+
+	background_tilesets[0] = ResourceCache::GetTileset(active_map->tileset);
+	DrawMap(&background, *active_map, -1, 0, blocks, &background_animations[0]);
+	for (int i = 0; i < 4; i++)
+	{
+		if (active_map->HasConnection(i))
+		{
+			background_tilesets[i + 1] = ResourceCache::GetTileset(active_map->connected_maps[i]->tileset);
+			DrawMap(&background, *active_map->connected_maps[i], i, &active_map->connections[i], blocks, &background_animations[i + 1]);
+		}
+	}
+	background.display();
+}
+
+void MapScene::DrawMap(sf::RenderTarget* window, Map& map, int connection_index, MapConnection* connection, sf::IntRect blocks, AnimatedTiles* animated)
 {
-	int startX = (int)(viewport.getCenter().x - viewport.getSize().x / 2) / 32;
-	int startY = (int)(viewport.getCenter().y - viewport.getSize().y / 2) / 32;
-	int endX = (int)(viewport.getCenter().x + viewport.getSize().x / 2) / 32;
-	int endY = (int)(viewport.getCenter().y + viewport.getSize().y / 2) / 32;
+	int startX = blocks.left;
+	int startY = blocks.top;
+	int endX = blocks.left + blocks.width - 1;
+	int endY = blocks.top + blocks.height - 1;
 
 	switch (connection_index)
 	{
@@ -303,9 +415,9 @@ void MapScene::DrawMap(sf::RenderWindow* window, Map& map, int connection_index,
 	Tileset* tileset = ResourceCache::GetTileset(map.tileset);
 	if (!tileset)
 		return;
-	for (int x = startX - 1; x <= endX; x++)
+	for (int x = startX; x <= endX; x++)
 	{
-		for (int y = startY - 1; y <= endY; y++)
+		for (int y = startY; y <= endY; y++)
 		{
 			unsigned char tile = map.border_tile;
 			if (x >= 0 && x < map.width && y >= 0 && y < map.height) //are we drawing a piece of the map or a border tile
@@ -346,7 +458,7 @@ void MapScene::DrawMap(sf::RenderWindow* window, Map& map, int connection_index,
 				}
 			}
 
-			tileset->Render(window, drawX, drawY, tile, 4, 4);
+			tileset->Render(window, drawX, drawY, tile, 4, 4, animated);
 		}
 	}
 }
@@ -413,8 +525,8 @@ bool MapScene::Interact()
 	{
 		if (active_map->signs[i].x == x && active_map->signs[i].y == y)
 		{
-			Textbox* t = new Textbox();
-			t->SetText(new TextItem(t, nullptr, pokestring(string("This is a sign\nwith index ").append(itos((int)i).append(".")).c_str())));
+			Textbox* t = Textbox::Create();
+			t->SetText(TextItem::Create(t, nullptr, pokestring(string("This is a sign\nwith index ").append(itos((int)i).append(".")).c_str())));
 			textboxes.push_back(t);
 			return true;
 		}
@@ -425,7 +537,7 @@ bool MapScene::Interact()
 	{
 		if (entities[i]->Snapped() && entities[i]->GetMovementDirection() == MOVEMENT_NONE && entities[i]->x / 16 == x && entities[i]->y / 16 == y)
 		{
-			Textbox* t = new Textbox();
+			Textbox* t = Textbox::Create();
 			string s;
 			if ((active_map->entities[i - 1].text & 0x40) != 0)
 			{
@@ -447,7 +559,7 @@ bool MapScene::Interact()
 					s.insert(s.end(), SFX_PICKUP_ITEM);
 					s.insert(s.end(), MESSAGE_AUTOCLOSE);
 					entities.erase(entities.begin() + i--);
-					t->SetText(new TextItem(t, nullptr, s, i));
+					t->SetText(TextItem::Create(t, nullptr, s, i));
 					textboxes.push_back(t);
 					continue;
 				}
@@ -463,7 +575,7 @@ bool MapScene::Interact()
 				}
 			}
 
-			t->SetText(new TextItem(t, nullptr, s, i));
+			t->SetText(TextItem::Create(t, nullptr, s, i));
 			textboxes.push_back(t);
 			entities[i]->Face((1 - (focus_entity->GetDirection() % 2) + (focus_entity->GetDirection() / 2 * 2)));
 			((NPC*)entities[i])->occupation = t;
@@ -572,8 +684,8 @@ void MapScene::Walk()
 		repel_steps--;
 		if (!repel_steps)
 		{
-			Textbox* t = new Textbox();
-			t->SetText(new TextItem(t, nullptr, pokestring("REPEL's effect\nwore off.")));
+			Textbox* t = Textbox::Create();
+			t->SetText(TextItem::Create(t, nullptr, pokestring("REPEL's effect\nwore off.")));
 			ShowTextbox(t);
 		}
 	}
@@ -606,8 +718,8 @@ void MapScene::Walk()
 		if (s != "")
 		{
 			focus_entity->ForceStop();
-			Textbox* t = new Textbox();
-			t->SetText(new TextItem(t, nullptr, s));
+			Textbox* t = Textbox::Create();
+			t->SetText(TextItem::Create(t, nullptr, s));
 			ShowTextbox(t);
 
 			if (fainted == Players::GetPlayer1()->GetPartyCount())
@@ -648,6 +760,13 @@ void MapScene::TriggerWildBattle(unsigned char index)
 
 void MapScene::TriggerTrainerBattle(unsigned char trainer_class, unsigned char trainer_party)
 {
+	//the battle starts once the transition is over, same as wild ones
+	unsigned char species[6];
+	unsigned char levels[6];
+	if (GameData::GetTrainerParty(trainer_class, trainer_party, species, levels) == 0)
+		return;
+	this->trainer_class = trainer_class;
+	this->trainer_party = trainer_party;
 	TriggerBattleTransition(1);
 	Engine::GetMusicPlayer().Play(145);
 }
@@ -835,17 +954,11 @@ void MapScene::ProcessWildEncounter()
 		if (active_map->grass_rate == 0)
 			return;
 
-		//if (rand() % 256 >= active_map->grass_rate)
+		//if (Random::GetStream(RandomStreams::ENCOUNTERS).NextByte() >= active_map->grass_rate)
 		//	return;
-		unsigned char rnd = rand() % 256;
-		for (int i = 0; i < 10; i++)
-		{
-			if (rnd <= ResourceCache::GetWildChances()[i]) //get the wild slot
-			{
-				TriggerWildBattle(i);
-				break;
-			}
-		}
+		unsigned char slot = active_map->grass_table.GetSlot(Random::GetStream(RandomStreams::ENCOUNTERS).NextByte());
+		if (slot != ENCOUNTER_NONE)
+			TriggerWildBattle(slot);
 	}
 	else if (wild_transition == 0)
 		return;
@@ -916,35 +1029,29 @@ void MapScene::ProcessBattleTransition()
 			bool trainer = (transition_index & 1) != 0;
 			transition_index = 255;
 			if (!trainer)
-			{
 				Engine::GetBattleScene()->BeginWildBattle(active_map->grass_encounters[wild_index].id, active_map->grass_encounters[wild_index].level);
-				Engine::SwitchState(States::BATTLE);
-			}
+			else
+				Engine::GetBattleScene()->BeginTrainerBattle(trainer_class, trainer_party);
+			Engine::SwitchState(States::BATTLE);
 		}
 		return;
 	}
 }
 
-void MapScene::DrawBattleTransition(sf::RenderWindow* window)
+void MapScene::DrawBattleTransition(sf::RenderTarget* window)
 {
 	if (transition_index != 255)
 	{
-		sf::IntRect src_rect = sf::IntRect(0, 0, 8, 8);
-		sf::Sprite sprite;
-		sprite.setTexture(*ResourceCache::GetFontTexture());
-		src_rect.left = 120;
-		src_rect.top = 32;
-		sprite.setTextureRect(src_rect);
-		for (int i = 0; i <= transition_step; i++)
+		Transition& t = ResourceCache::GetBattleTransition(transition_index);
+		if (t.n_steps == 0)
+			return;
+		//transition_step goes past the last step (and is 255 while holding the covered screen)
+		unsigned char step = (transition_step < t.n_steps ? transition_step : t.n_steps - 1);
+		sf::VertexArray& quads = ResourceCache::GetBattleTransitionQuads(transition_index);
+		if (t.covered[step] > 0)
 		{
-			for (int s = 0; s < 256; s++)
-			{
-				unsigned short u = ResourceCache::GetBattleTransition(transition_index).tiles[i][s];
-				if (u == 0xFFFF)
-					break;
-				sprite.setPosition((float)(int)((u & 0xFF) * 8), (float)(int)(((u >> 8) & 0xFF) * 8));
-				window->draw(sprite);
-			}
+			window->draw(&quads[0], t.covered[step] * 4, sf::Quads, ResourceCache::GetFontTexture()->GetTexture());
+			Profiler::CountDraw(ResourceCache::GetFontTexture()->GetTexture());
 		}
 	}
 }
@@ -12,6 +12,10 @@
 #include "ItemStorage.h"
 #include "AudioConstants.h"
 
+//size of the cached map background in blocks: the viewport plus one block of margin on each side
+#define BACKGROUND_BLOCKS_X ((VIEWPORT_WIDTH + 1) / 2 + 3)
+#define BACKGROUND_BLOCKS_Y ((VIEWPORT_HEIGHT + 1) / 2 + 3)
+
 class MapScene : public Scene
 {
 public:
@@ -19,15 +23,16 @@ public:
 	~MapScene();
 
 	void Update() override;
-	void Render(sf::RenderWindow*) override;
+	void Render(sf::RenderTarget*) override;
 	void NotifySwitchedTo() override;
+	bool NeedsRedraw() override;
 
 	void SwitchMap(unsigned char index);
 	void SetPlayerPosition(unsigned char x, unsigned int y);
 	void Focus(signed char x, signed char y);
 	void FocusFree(int x, int y);
 
-	void DrawMap(sf::RenderWindow* window, Map& map, int connection_index, MapConnection* connection);
+	void DrawMap(sf::RenderTarget* window, Map& map, int connection_index, MapConnection* connection, sf::IntRect blocks, AnimatedTiles* animated = 0);
 	void ClearEntities(bool focused = false);
 	void SetPalette(sf::Color* palette, bool only_bg = false);
 
@@ -46,6 +51,7 @@ public:
 	void SetFlag(unsigned int index, bool b) { if (index < 4096) flags[index] = b; }
 
 	void SetRepel(unsigned char to) { repel_steps = to; }
+	void SetForcedDirection(unsigned char direction) { forced_direction = direction; } //walks as if that direction was held, MOVEMENT_NONE to stop
 
 private:
 	Map* active_map;
@@ -54,6 +60,8 @@ private:
 
 	vector<OverworldEntity*> entities;
 	OverworldEntity* focus_entity;
+	EntityLayers entity_layers;
+	unsigned char forced_direction;
 
 	bool can_warp;
 	unsigned char previous_palette;
@@ -64,6 +72,8 @@ private:
 	unsigned char repel_steps; //steps remaining for repel
 	unsigned char poison_steps;
 	unsigned char wild_index; //wild pokemon slot
+	unsigned char trainer_class; //the trainer battle the transition leads into
+	unsigned char trainer_party;
 	unsigned char wild_steps;
 	unsigned char wild_transition;
 	unsigned char transition_step;
@@ -76,12 +86,30 @@ private:
 
 	Script* active_script;
 
+	//the map around the camera gets drawn into this once and reused until the camera crosses into another block
+	sf::RenderTexture background;
+	sf::Vector2i background_origin; //top left block
+	bool background_valid;
+	bool background_poisoned;
+	unsigned int background_palette_changes;
+	AnimatedTiles background_animations[5]; //water and flowers of the map and its 4 connections
+	Tileset* background_tilesets[5];
+	void DrawBackground(sf::RenderTarget* window);
+	void BuildBackground();
+
+	//what the last rendered frame showed
+	unsigned char drawn_map;
+	unsigned int drawn_animation_frame;
+	unsigned int drawn_palette_changes;
+	vector<OverworldEntity*> drawn_entities;
+	unsigned int GetAnimationFrame();
+
 	void CheckWarp();
 	void TryResetWarp();
 	void ProcessTeleport();
 	void ProcessWildEncounter();
 	void ProcessWildTransition();
 	void ProcessBattleTransition();
-	void DrawBattleTransition(sf::RenderWindow* window);
+	void DrawBattleTransition(sf::RenderTarget* window);
 	void CheckTrainers();
 };
\ No newline at end of file
@@ -17,9 +17,9 @@ void MenuCache::ReleaseResources()
 	if (pokemon_menu)
 		delete pokemon_menu;
 	if (start_menu)
-		delete start_menu;
+		Textbox::Release(start_menu);
 	if (debug_menu)
-		delete debug_menu;
+		Textbox::Release(debug_menu);
 }
 
 //Return the start menu or create it if it doesn't exist
@@ -29,28 +29,28 @@ Textbox* MenuCache::StartMenu(std::vector<Textbox*>* owner)
 	if (start_menu)
 		return start_menu;
 
-	start_menu = new Textbox(10, 0, 10, 16, false);
+	start_menu = Textbox::Create(10, 0, 10, 16, false);
 	start_menu->SetMenu(true, 7, sf::Vector2i(1, 1), sf::Vector2u(0, 2), nullptr, MenuFlags::FOCUSABLE | MenuFlags::WRAPS);
 
 	auto doe = [](TextItem* source)->void
 	{
-		Textbox* message = new Textbox();
-		message->SetText(new TextItem(start_menu, [](TextItem* source)->void { start_menu->SetArrowState(ArrowStates::ACTIVE); }, pokestring(string("Sorry! That\nfeature has not\vbeen implemented\vyet.").c_str())));
+		Textbox* message = Textbox::Create();
+		message->SetText(TextItem::Create(start_menu, [](TextItem* source)->void { start_menu->SetArrowState(ArrowStates::ACTIVE); }, pokestring(string("Sorry! That\nfeature has not\vbeen implemented\vyet.").c_str())));
 		start_menu->SetArrowState(ArrowStates::INACTIVE);
 		start_menu->ShowTextbox(message, false);
 	};
-	start_menu->GetItems().push_back(new TextItem(start_menu, doe, pokestring("POKDEX"), 0));
-	start_menu->GetItems().push_back(new TextItem(start_menu, [](TextItem* source){PokemonMenu()->UpdatePokemon(Players::GetPlayer1()->GetParty()); PokemonMenu()->Show(start_menu); }, pokestring("POKMON"), 1));
-	start_menu->GetItems().push_back(new TextItem(start_menu, [](TextItem* source)->void
+	start_menu->GetItems().push_back(TextItem::Create(start_menu, doe, pokestring("POKDEX"), 0));
+	start_menu->GetItems().push_back(TextItem::Create(start_menu, [](TextItem* source){PokemonMenu()->UpdatePokemon(Players::GetPlayer1()->GetParty()); PokemonMenu()->Show(start_menu); }, pokestring("POKMON"), 1));
+	start_menu->GetItems().push_back(TextItem::Create(start_menu, [](TextItem* source)->void
 	{
 		start_menu->SetArrowState(ArrowStates::INACTIVE);
 		start_menu->ShowTextbox(Players::GetPlayer1()->GetInventory()->GetMenu());
 	}
 	, pokestring("ITEMS"), 2));
-	start_menu->GetItems().push_back(new TextItem(start_menu, doe, pokestring("Lin"), 3));
-	start_menu->GetItems().push_back(new TextItem(start_menu, doe, pokestring("SAVE"), 4));
-	start_menu->GetItems().push_back(new TextItem(start_menu, doe, pokestring("OPTIONS"), 5));
-	start_menu->GetItems().push_back(new TextItem(start_menu, [](TextItem* source)->void { start_menu->Close(); }, pokestring("EXIT"), 6));
+	start_menu->GetItems().push_back(TextItem::Create(start_menu, doe, pokestring("Lin"), 3));
+	start_menu->GetItems().push_back(TextItem::Create(start_menu, doe, pokestring("SAVE"), 4));
+	start_menu->GetItems().push_back(TextItem::Create(start_menu, doe, pokestring("OPTIONS"), 5));
+	start_menu->GetItems().push_back(TextItem::Create(start_menu, [](TextItem* source)->void { start_menu->Close(); }, pokestring("EXIT"), 6));
 
 	start_menu->UpdateMenu();
 	return start_menu;
@@ -61,11 +61,11 @@ Textbox* MenuCache::DebugMenu(std::vector<Textbox*>* owner)
 	if (debug_menu)
 		return debug_menu;
 
-	debug_menu = new Textbox(0, 8, 14, 7, false);
+	debug_menu = Textbox::Create(0, 8, 14, 7, false);
 	debug_menu->SetMenu(true, 3, sf::Vector2i(1, 1), sf::Vector2u(0, 1), nullptr, MenuFlags::FOCUSABLE);
-	debug_menu->GetItems().push_back(new TextItem(debug_menu, nullptr, "Testing"));
-	debug_menu->GetItems().push_back(new TextItem(debug_menu, nullptr, "multiple"));
-	debug_menu->GetItems().push_back(new TextItem(debug_menu, nullptr, "menus."));
+	debug_menu->GetItems().push_back(TextItem::Create(debug_menu, nullptr, "Testing"));
+	debug_menu->GetItems().push_back(TextItem::Create(debug_menu, nullptr, "multiple"));
+	debug_menu->GetItems().push_back(TextItem::Create(debug_menu, nullptr, "menus."));
 
 	debug_menu->UpdateMenu();
 	return debug_menu;
@@ -1,20 +1,15 @@
 #pragma once
 
-#include "ResourceCache.h"
+#include "GameData.h"
+#include "StringConverter.h"
 
+//a pokemon's move slot. The move's data and name are looked up in GameData by index.
 struct Move
 {
 	unsigned char index;
-	unsigned char animation;
-	unsigned char effect;
-	unsigned char power;
-	unsigned char type;
-	unsigned char accuracy;
 	unsigned char max_pp;
-	unsigned char original_max_pp;
 	unsigned char pp;
 	unsigned char pp_ups;
-	string name;
 
 	Move() : Move(0)
 	{
@@ -28,13 +23,17 @@ struct Move
 		//so we're going to do this the easy way.
 		pp_ups = 0;
 		index = id;
-		memcpy(&animation, ResourceCache::GetMoveData()->data_start + 6 * id - 6, 6);
-		original_max_pp = max_pp;
+		max_pp = Info().max_pp;
 		pp = max_pp;
-		//woooaaaahhhhhhh like it's cool to be able to do this. i feel naughty.
-		if (id > 0)
-			name = ResourceCache::GetMoveName(id - 1);
-		else
-			name = pokestring("-");
+	}
+
+	MoveInfo& Info() { return GameData::GetMoveInfo(index); }
+
+	const string& GetName()
+	{
+		static const string none = pokestring("-");
+		if (index > 0)
+			return GameData::GetMoveName(index - 1);
+		return none;
 	}
 };
\ No newline at end of file
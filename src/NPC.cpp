@@ -1,4 +1,5 @@
 #include "NPC.h"
+#include "Random.h"
 
 
 NPC::NPC(Map* on_map, unsigned char index, Entity data, Script* script, std::function<void()> step_callback) : OverworldEntity(on_map, index, data.sprite, data.x, data.y, ENTITY_DOWN, true, script, step_callback)
@@ -33,7 +34,7 @@ void NPC::PerformAI(bool force)
 
 	if ((force && data.movement1 != MTYPE_DIRECTIONAL) || !force)
 	{
-		if (rand() % 255 >= RANDOM_WALK || steps_remaining > 0)
+		if (Random::Range(RandomStreams::NPCS, 255) >= RANDOM_WALK || steps_remaining > 0)
 			return;
 	}
 
@@ -55,7 +56,7 @@ unsigned char NPC::GetNextDirection()
 	{
 	case MDIR_ANY:
 	case MDIR_NONE:
-		return rand() % 4;
+		return Random::Range(RandomStreams::NPCS, 4);
 		break;
 
 	case MDIR_DOWN:
@@ -66,11 +67,11 @@ unsigned char NPC::GetNextDirection()
 		break;
 
 	case MDIR_VERTICAL:
-		return ENTITY_DOWN + rand() % 2;
+		return ENTITY_DOWN + Random::Range(RandomStreams::NPCS, 2);
 		break;
 
 	case MDIR_HORIZONTAL:
-		return ENTITY_LEFT + rand() % 2;
+		return ENTITY_LEFT + Random::Range(RandomStreams::NPCS, 2);
 		break;
 	}
 
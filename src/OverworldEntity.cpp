@@ -32,6 +32,10 @@ OverworldEntity::OverworldEntity(Map* m, unsigned char index, unsigned char spri
 	emotion_bubble = 255;
 	force_fast = false;
 	offset_y = 0;
+	jump_index = 0;
+	jump_x = 0;
+	jump_y = 0;
+	has_drawn = false;
 
 	//is this entity a moving npc or a static image (eg. pokeball)
 	direction = (direction > 3 ? 0 : index <= ENTITY_LIMIT ? direction : 0);
@@ -53,7 +57,6 @@ OverworldEntity::OverworldEntity(Map* m, unsigned char index, unsigned char spri
 		emotion_texture->GetTexture()->SetPalette(palette);
 	}
 	sprite8x8.setTexture(*tiles_tex);
-	shadow8x8.setTexture(*ResourceCache::GetShadowTexture());
 
 	Face(direction);
 }
@@ -190,31 +193,27 @@ void OverworldEntity::Update()
 	}
 }
 
-void OverworldEntity::Render(sf::RenderWindow* window, int offset_x, int offset_y)
+void OverworldEntity::Render(EntityLayers& layers, int offset_x, int offset_y)
 {
+	drawn_state = GetRenderState();
+	has_drawn = true;
+
+	if (emotion_bubble < 3)
+		emotion_texture->Render(layers.bubbles, this->x / 16, this->y / 16 - 1, emotion_bubble, 2, 2, 0, -4);
 	if (!tiles_tex)
 		return;
 
-	//draw the shadow if jumping
-	sf::IntRect src_rect = sf::IntRect(0, 0, 8, 8);
+	//draw the shadow if jumping, the right and bottom quarters are the top left one flipped
 	if (movement_type == MOVEMENT_JUMP)
 	{
 		for (int i = 0; i < 4; i++)
 		{
-			int x = this->x + (i % 2) * 8;
-			int y = this->y + (i / 2) * 8 + 4;
-			src_rect.left = (i % 2) * 8;
-			src_rect.top = (i / 2) * 8;
-			src_rect.width = 8 + (i % 2) * -16;
-			src_rect.height = 8 + (i / 2) * -16;
-			shadow8x8.setTextureRect(src_rect);
-			shadow8x8.setPosition((float)x, (float)y);
-			window->draw(shadow8x8);
+			unsigned char flags = (i % 2 ? TileFlags::FLIP_X : 0) | (i / 2 ? TileFlags::FLIP_Y : 0);
+			layers.shadows.Add(this->x + (i % 2) * 8, this->y + (i / 2) * 8 + 4, ResourceCache::GetShadowTexture(), sf::IntRect(0, 0, 8, 8), flags);
 		}
 	}
 
 	//draw the player
-	src_rect.height = 8;
 	int dest_x = x;
 	int dest_y = y;
 	bool h_flip = direction == ENTITY_RIGHT;
@@ -229,10 +228,6 @@ void OverworldEntity::Render(sf::RenderWindow* window, int offset_x, int offset_
 				if (direction == ENTITY_DOWN || direction == ENTITY_UP)
 					h_flip = (step_frame) > 1;
 			}
-			src_rect.left = (t % tiles_x) * 8 + (h_flip ? 8 : 0);
-			src_rect.top = (t / tiles_x) * 8;
-			src_rect.width = (h_flip ? -8 : 8);
-			sprite8x8.setTextureRect(src_rect);
 
 			dest_x = (int)(this->x + (h_flip ? 1 - x : x) * 8);
 			dest_y = (int)(this->y + y * 8) - 4;
@@ -242,8 +237,7 @@ void OverworldEntity::Render(sf::RenderWindow* window, int offset_x, int offset_
 				int offset = (ResourceCache::GetJumpCoordinates()->data[min(JUMP_STEPS - 3, max(0, (int)(signed char)jump_index))] - 0x3C) - (jump_y - this->y) - 2;
 				dest_y = (int)(this->jump_y + y * 8) + offset;
 			}
-			sprite8x8.setPosition((float)(dest_x + offset_x), (float)(dest_y + offset_y + this->offset_y));
-			window->draw(sprite8x8);
+			layers.bodies.Add(dest_x + offset_x, dest_y + offset_y + this->offset_y, tiles_tex, sf::IntRect((t % tiles_x) * 8, (t / tiles_x) * 8, 8, 8), (h_flip ? TileFlags::FLIP_X : TileFlags::NONE));
 		}
 	}
 
@@ -251,26 +245,37 @@ void OverworldEntity::Render(sf::RenderWindow* window, int offset_x, int offset_
 	//i'll be incredibly relieved when this is over.
 	if (on_map && on_map->InGrass(this->x / 16, this->y / 16))
 	{
-		//store the previous texture and set it to the transparent tiles
-		const sf::Texture* tex = sprite8x8.getTexture();
-		sprite8x8.setTexture(*ResourceCache::GetTileset(on_map->tileset)->GetTransparentTiles());
-
 		//after several tries with using single grass tiles and drawing things manually i decided to create
 		//a function that renders all the tiles in a certain spot
 		//much easier...
-		on_map->RenderRectangle(this->x, this->y + 4, 16, 8, sprite8x8, window);
-
-		//set the texture back to what it was
-		sprite8x8.setTexture(*tex);
+		on_map->RenderRectangle(this->x, this->y + 4, 16, 8, ResourceCache::GetTileset(on_map->tileset)->GetTransparentTiles(), layers.grass);
 	}
 }
 
-void OverworldEntity::DrawEmoteBubble(sf::RenderWindow* window)
+bool OverworldEntity::NeedsRedraw()
 {
-	if (emotion_bubble < 3)
-	{
-		emotion_texture->Render(window, this->x / 16, this->y / 16 - 1, emotion_bubble, 2, 2, 0, -4);
-	}
+	if (!has_drawn)
+		return true;
+	RenderState now = GetRenderState();
+	return memcmp(&now, &drawn_state, sizeof(RenderState)) != 0;
+}
+
+OverworldEntity::RenderState OverworldEntity::GetRenderState()
+{
+	RenderState s;
+	memset(&s, 0, sizeof(RenderState)); //clear the padding so memcmp works
+	s.x = x;
+	s.y = y;
+	s.offset_y = offset_y;
+	s.jump_y = jump_y;
+	s.texture = tiles_tex;
+	s.first_tile = (formation ? formation->data[0] : 0);
+	s.direction = direction;
+	s.step_frame = step_frame;
+	s.movement_type = movement_type;
+	s.jump_index = jump_index;
+	s.emotion_bubble = emotion_bubble;
+	return s;
 }
 
 void OverworldEntity::Face(unsigned char direction)
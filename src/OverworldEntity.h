@@ -8,6 +8,30 @@
 #include "Map.h"
 #include "Script.h"
 
+//batches for drawing every entity on screen with a few draw calls, in the order they get drawn
+struct EntityLayers
+{
+	SpriteBatch shadows;
+	SpriteBatch bodies;
+	SpriteBatch grass; //grass covering the lower half of entities standing in it
+	SpriteBatch bubbles;
+
+	void Draw(sf::RenderTarget* window)
+	{
+		shadows.Draw(window);
+		bodies.Draw(window);
+		grass.Draw(window);
+		bubbles.Draw(window);
+	}
+	void Clear()
+	{
+		shadows.Clear();
+		bodies.Clear();
+		grass.Clear();
+		bubbles.Clear();
+	}
+};
+
 class OverworldEntity : public TileMap
 {
 public:
@@ -15,8 +39,8 @@ public:
 	virtual ~OverworldEntity();
 
 	virtual void Update();
-	virtual void Render(sf::RenderWindow* window, int offset_x = 0, int offset_y = 0);
-	void DrawEmoteBubble(sf::RenderWindow* window);
+	virtual void Render(EntityLayers& layers, int offset_x = 0, int offset_y = 0);
+	bool NeedsRedraw(); //true if the entity would look different than when it was last rendered
 	void Face(unsigned char direction);
 	void StartMoving(unsigned char direction);
 	void StopMoving();
@@ -84,7 +108,24 @@ protected:
 	unsigned char emotion_bubble;
 	TileMap* emotion_texture;
 
-	sf::Sprite shadow8x8;
+	//everything Render looks at, to tell when the entity needs redrawing
+	struct RenderState
+	{
+		int x;
+		int y;
+		int offset_y;
+		int jump_y;
+		PaletteTexture* texture;
+		unsigned char first_tile;
+		unsigned char direction;
+		unsigned char step_frame;
+		unsigned char movement_type;
+		unsigned char jump_index;
+		unsigned char emotion_bubble;
+	};
+	RenderState drawn_state;
+	bool has_drawn;
+	RenderState GetRenderState();
 
 	std::function<void()> step_callback;
 };
\ No newline at end of file
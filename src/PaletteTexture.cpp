@@ -1,5 +1,7 @@
 #include "PaletteTexture.h"
+#include "Profiler.h"
 
+unsigned int PaletteTexture::change_count = 0;
 
 PaletteTexture::PaletteTexture(const char* filename)
 {
@@ -38,6 +40,7 @@ bool PaletteTexture::loadFromFile(const std::string& filename)
 	original_pixels = new unsigned char[size.x * size.y * 4];
 	memcpy(pixels, temp.getPixelsPtr(), size.x * size.y * 4);
 	memcpy(original_pixels, pixels, size.x*size.y * 4);
+	change_count++;
 	return true;
 }
 
@@ -55,6 +58,7 @@ void PaletteTexture::Copy(PaletteTexture* src)
 	memcpy(original_pixels, src->GetOriginalPixels(), size.x * size.y * 4);
 	memcpy(palette, src->GetPalette(), sizeof(sf::Color) * 4);
 	underlying_texture.update(pixels);
+	change_count++;
 }
 
 void PaletteTexture::As8x8Tile(PaletteTexture* from, int tile)
@@ -76,6 +80,7 @@ void PaletteTexture::As8x8Tile(PaletteTexture* from, int tile)
 			memcpy(pixels + (x + y * 8) * 4, from->GetPixels() + (x_coord + y_coord) * 4, 4);
 		}
 		underlying_texture.update(pixels);
+		change_count++;
 		//underlying_texture.loadFromMemory(from->GetPixels(), 8 * 8 * 4, sf::IntRect((tile % 16) * 8, tile / 16 * 8, 8, 8));
 		memcpy(palette, from->GetPalette(), sizeof(sf::Color) * 4);
 	}
@@ -83,6 +88,7 @@ void PaletteTexture::As8x8Tile(PaletteTexture* from, int tile)
 
 void PaletteTexture::SetPalette(const sf::Color new_palette[])
 {
+	Profiler::CountSetPalette();
 	if ((size.x | size.y) == 0 || !pixels)
 		return;
 	sf::Uint32 pal0 = PAL_0_RGBA; //((palette[0].r / 8 * 8) << 24) + ((palette[0].g / 8 * 8) << 16) + ((palette[0].b / 8 * 8) << 8) + palette[0].a;
@@ -131,4 +137,5 @@ void PaletteTexture::SetPalette(const sf::Color new_palette[])
 
 	memcpy(palette, new_palette, sizeof(sf::Color) * 4);
 	underlying_texture.update(pixels);
+	change_count++;
 }
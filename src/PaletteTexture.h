@@ -23,7 +23,11 @@ public:
 	sf::Uint8* GetOriginalPixels() { return original_pixels; }
 	sf::Color* GetPalette() { return palette; }
 
+	static unsigned int GetChangeCount() { return change_count; } //goes up whenever any texture's pixels change
+
 private:
+	static unsigned int change_count;
+
 	sf::Texture underlying_texture;
 	sf::Color palette[4];
 	sf::Uint8* pixels;
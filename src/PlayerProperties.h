@@ -5,6 +5,7 @@
 #include "OverworldEntity.h"
 #include "Options.h"
 #include "Pokemon.h"
+#include "Random.h"
 
 class PlayerProperties
 {
@@ -38,10 +39,10 @@ public:
 		{
 			if (party[i])
 				delete party[i];
-			int ind = rand() % 190;
-			while (ResourceCache::GetPokedexIndex(ind - 1) > 151)
-				ind = rand() % 190;
-			party[i] = new Pokemon(ind, rand() % 98 + 2);
+			int ind = Random::Range(RandomStreams::PARTY, 190);
+			while (GameData::GetPokedexIndex(ind - 1) > 151)
+				ind = Random::Range(RandomStreams::PARTY, 190);
+			party[i] = new Pokemon(ind, Random::Range(RandomStreams::PARTY, 98) + 2);
 		}
 		party[0] = new Pokemon(0x66, 50);
 	}
@@ -1,15 +1,28 @@
 #include "Pokemon.h"
+#include "Random.h"
+#include <cstring>
+#include <algorithm>
 
+//levels 0-100 for each growth rate, filled in at compile time
+#define XP_TENS(type, tens) CalculateXPAt(tens##0, type), CalculateXPAt(tens##1, type), CalculateXPAt(tens##2, type), CalculateXPAt(tens##3, type), CalculateXPAt(tens##4, type), \
+	CalculateXPAt(tens##5, type), CalculateXPAt(tens##6, type), CalculateXPAt(tens##7, type), CalculateXPAt(tens##8, type), CalculateXPAt(tens##9, type)
+#define XP_ROW(type) { XP_TENS(type, ), XP_TENS(type, 1), XP_TENS(type, 2), XP_TENS(type, 3), XP_TENS(type, 4), XP_TENS(type, 5), \
+	XP_TENS(type, 6), XP_TENS(type, 7), XP_TENS(type, 8), XP_TENS(type, 9), CalculateXPAt(100, type) }
+const unsigned int Pokemon::xp_table[6][101] = { XP_ROW(0), XP_ROW(1), XP_ROW(2), XP_ROW(3), XP_ROW(4), XP_ROW(5) };
 
 Pokemon::Pokemon(unsigned char index, unsigned char l)
 {
+	//an empty slot, eg. the unused ones in a Battle's parties
+	if (index == 0)
+	{
+		memset((void*)this, 0, sizeof(Pokemon)); //fine since Pokemon is trivially copyable
+		return;
+	}
+
 	id = index;
 	level = l;
-	pokedex_index = ResourceCache::GetPokedexIndex(index - 1);
-	ot = rand() % 100000;
-	type1 = 0;
-	type2 = 0;
-	ot_name = pokestring("Lin");
+	ot = Random::Range(RandomStreams::POKEMON, 100000);
+	SetOTName(pokestring("Lin"));
 	status = Statuses::OK;
 	has_nickname = false;
 	unsigned char move_count = 0;
@@ -17,124 +30,93 @@ Pokemon::Pokemon(unsigned char index, unsigned char l)
 	LoadStats(true, &move_count);
 
 	//determine the pokemon's moveset
-	for (int i = 0; i < 16; i++)
+	const unsigned char* learned;
+	unsigned char learned_count = Species().GetMovesLearned(0, level, &learned);
+	for (int i = 0; i < learned_count; i++)
 	{
-		if (learnset[i].level && learnset[i].level <= level)
+		if (move_count < 4)
+		{
+			moves[move_count++] = Move(learned[i]);
+		}
+		else
 		{
-			if (move_count < 4)
-			{
-				moves[move_count++] = Move(learnset[i].move);
-			}
-			else
-			{
-				//this was causing problems unfortunately. probably related to padding
-				//memcpy(moves, moves + 1, sizeof(Move)* 3);
-				moves[0] = moves[1];
-				moves[1] = moves[2];
-				moves[2] = moves[3];
-				moves[3] = Move(learnset[i].move);
-			}
+			//this was causing problems unfortunately. probably related to padding
+			//memcpy(moves, moves + 1, sizeof(Move)* 3);
+			moves[0] = moves[1];
+			moves[1] = moves[2];
+			moves[2] = moves[3];
+			moves[3] = Move(learned[i]);
 		}
 	}
 
-	xp = GetXPAt(l, growth_rate);
+	xp = GetXPAt(l, Species().growth_rate);
 	ev_hp = 0;
 	ev_attack = 0;
 	ev_defense = 0;
 	ev_speed = 0;
 	ev_special = 0;
 
-	dv_attack = rand() % 16;
-	dv_defense = rand() % 16;
-	dv_speed = rand() % 16;
-	dv_special = rand() % 16;
+	//one number has enough bits for all four DVs
+	unsigned int dvs = Random::Next(RandomStreams::POKEMON);
+	dv_attack = dvs >> 28;
+	dv_defense = (dvs >> 24) & 15;
+	dv_speed = (dvs >> 20) & 15;
+	dv_special = (dvs >> 16) & 15;
 	dv_hp = ((dv_attack & 1) << 3) | ((dv_defense & 1) << 2) | ((dv_speed & 1) << 1) | (dv_special & 1);
 
 	RecalculateStats();
-	int by = rand() % 10 + 1;
-	hp = max_hp;// max_hp / 3 / (by)* (rand() % by + 1);
+	hp = max_hp;
 	if (hp == 0)
 		status = Statuses::FAINTED;
 }
 
-Pokemon::~Pokemon()
-{
-}
-
 void Pokemon::LoadStats(bool default_moves, unsigned char* move_count)
 {
-	original_name = ResourceCache::GetPokemonName(id - 1);
 	if (!has_nickname)
-		nickname = original_name;
-	DataBlock* data = ResourceCache::GetPokemonStats(pokedex_index - 1);
-	if (data)
+		SetNickname(GetName());
+
+	if (default_moves)
 	{
-		data->data = data->data_start;
-		data->getc(); //pokedex index; we don't use it because according to padz it's a leftover value
-		base_hp = data->getc();
-		base_attack = data->getc();
-		base_defense = data->getc();
-		base_speed = data->getc();
-		base_special = data->getc();
-
-		type1 = data->getc();
-		type2 = data->getc();
-
-		catch_rate = data->getc();
-		xp_yield = data->getc();
-
-		unsigned char size = data->getc();
-		size_x = size & 0xF;
-		size_y = (size >> 4) & 0xF;
-
-		//moves
-		if (default_moves)
+		for (int i = 0; i < 4; i++)
 		{
-			for (int i = 0; i < 4; i++)
-			{
-				moves[i] = Move(data->getc());
-				if (moves[i].index && move_count)
-					*move_count++;
-			}
+			moves[i] = Move(Species().default_moves[i]);
+			if (moves[i].index && move_count)
+				(*move_count)++;
 		}
-		growth_rate = data->getc();
 	}
+}
 
-	data = ResourceCache::GetPokemonLeveling(id - 1);
-	if (data)
-	{
-		data->data = data->data_start;
-		for (int i = 0; i < 5; i++)
-		{
-			evolutions[i].Load(data);
-			if (evolutions[i].trigger == 0)
-			{
-				for (int k = i + 1; k < 5; k++)
-					evolutions[i].trigger = 0;
-				break;
-			}
-		}
+void Pokemon::SetNickname(const string& name)
+{
+	strncpy(nickname, name.c_str(), POKEMON_NAME_LENGTH - 1);
+	nickname[POKEMON_NAME_LENGTH - 1] = 0;
+}
 
-		for (int i = 0; i < 16; i++)
-		{
-			learnset[i].Load(data);
-			if (!learnset[i].level)
-			{
-				for (int k = i + 1; k < 16; k++)
-					learnset[i].level = 0;
-				break;
-			}
-		}
-	}
+void Pokemon::SetOTName(const string& name)
+{
+	strncpy(ot_name, name.c_str(), OT_NAME_LENGTH - 1);
+	ot_name[OT_NAME_LENGTH - 1] = 0;
 }
 
 void Pokemon::RecalculateStats()
 {
-	max_hp = (unsigned int)((float)(base_hp + dv_hp + 50) * (float)level / 50.0f + 10.0f + (float)CalculateStatXP(ev_hp, level));
-	attack = CalculateStat(base_attack, dv_attack, ev_attack, level);
-	defense = CalculateStat(base_defense, dv_defense, ev_defense, level);
-	speed = CalculateStat(base_speed, dv_speed, ev_speed, level);
-	special = CalculateStat(base_special, dv_special, ev_special, level);
+	SpeciesInfo& s = Species();
+	max_hp = CalculateHP(s.base_hp, dv_hp, ev_hp, level);
+	attack = CalculateStat(s.base_attack, dv_attack, ev_attack, level);
+	defense = CalculateStat(s.base_defense, dv_defense, ev_defense, level);
+	speed = CalculateStat(s.base_speed, dv_speed, ev_speed, level);
+	special = CalculateStat(s.base_special, dv_special, ev_special, level);
+}
+
+void Pokemon::SetTrainerDVs()
+{
+	dv_attack = 9;
+	dv_defense = 8;
+	dv_speed = 8;
+	dv_special = 8;
+	dv_hp = ((dv_attack & 1) << 3) | ((dv_defense & 1) << 2) | ((dv_speed & 1) << 1) | (dv_special & 1);
+	RecalculateStats();
+	hp = max_hp;
 }
 
 void Pokemon::Heal()
@@ -145,70 +127,30 @@ void Pokemon::Heal()
 	status = Statuses::OK;
 }
 
-unsigned int Pokemon::CalculateStat(unsigned char base, unsigned char dv, unsigned int ev, unsigned char level)
+unsigned char Pokemon::AddXP(unsigned int amount)
 {
-	return (unsigned int)((float)(base + dv + 50) * (float)level / 50.0f + 5.0f + CalculateStatXP(ev, level));
-}
+	const unsigned int* table = xp_table[Species().growth_rate < 6 ? Species().growth_rate : 0];
+	if (level >= 100)
+		return 0;
+	xp = amount < table[100] - std::min(xp, table[100]) ? xp + amount : table[100]; //anything past level 100 is lost
 
-float Pokemon::CalculateStatXP(unsigned int xp, unsigned char level)
-{
-	if (xp == 0)
+	//find the new level in one search rather than checking a level at a time
+	unsigned char new_level = (unsigned char)(std::upper_bound(table + level + 1, table + 101, xp) - table - 1);
+	if (new_level <= level)
 		return 0;
-	float f = (float)((sqrt((double)xp - 1.0) + 1.0) * (double)level / 400.0);
-	return f;
+	unsigned char gained = new_level - level;
+	level = new_level;
+	unsigned short old_hp = max_hp;
+	RecalculateStats();
+	hp += max_hp - old_hp;
+	return gained;
 }
 
 const char* Pokemon::GetTypeName(unsigned char type)
 {
-	switch (type)
-	{
-	case 0x00:
-		return "NORMAL";
-		break;
-	case 0x01:
-		return "FIGHTING";
-		break;
-	case 0x02:
-		return "FLYING";
-		break;
-	case 0x03:
-		return "POISON";
-		break;
-	case 0x04:
-		return "GROUND";
-		break;
-	case 0x05:
-		return "ROCK";
-		break;
-	case 0x07:
-		return "BUG";
-		break;
-	case 0x08:
-		return "GHOST";
-		break;
-	case 0x14:
-		return "FIRE";
-		break;
-	case 0x15:
-		return "WATER";
-		break;
-	case 0x16:
-		return "GRASS";
-		break;
-	case 0x17:
-		return "ELECTRIC";
-		break;
-	case 0x18:
-		return "PSYCHIC";
-		break;
-	case 0x19:
-		return "ICE";
-		break;
-	case 0x1A:
-		return "DRAGON";
-		break;
-	}
-	return "UNKNOWN";
+	static const char* names[TYPE_COUNT + 1] = { "NORMAL", "FIGHTING", "FLYING", "POISON", "GROUND", "ROCK", "BUG", "GHOST",
+		"FIRE", "WATER", "GRASS", "ELECTRIC", "PSYCHIC", "ICE", "DRAGON", "UNKNOWN" };
+	return names[GetTypeIndex(type)];
 }
 
 const char* Pokemon::GetStatusName(unsigned char s)
@@ -232,22 +174,3 @@ const char* Pokemon::GetStatusName(unsigned char s)
 	}
 	return "OK ";
 }
-
-unsigned int Pokemon::GetXPAt(unsigned char level, unsigned char exp_type)
-{
-	level = min(100u, (unsigned int)level);
-	switch (exp_type)
-	{
-	default: //case 1 and 2 never actually occur...
-		return level * level * level;
-
-	case 3:
-		return (unsigned int)(((1.2 * pow(level, 3u)) - (15.0 * pow(level, 2u)) + (100.0 * (double)level - 140.0)));
-
-	case 4:
-		return (unsigned int)(pow(level, 3u) * .8);
-
-	case 5:
-		return (unsigned int)(pow(level, 3u) * 1.25);
-	}
-}
\ No newline at end of file
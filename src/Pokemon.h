@@ -3,28 +3,9 @@
 #include "StringConverter.h"
 #include "Move.h"
 #include "Events.h"
+#include "TypeChart.h"
 #include <math.h>
-
-//this is never going to be used without the inclusion of Pokemon.h
-//so why not just declare it here
-enum Types
-{
-	NORMAL = 0,
-	FIGHTING = 1,
-	FLYING = 2,
-	POISON = 3,
-	GROUND = 4,
-	ROCK = 5,
-	BUG = 7,
-	GHOST = 8,
-	FIRE = 0x14,
-	WATER = 0x15,
-	GRASS = 0x16,
-	ELECTRIC = 0x17,
-	PSYCHIC = 0x18,
-	ICE = 0x19,
-	DRAGON = 0x1A,
-};
+#include <type_traits>
 
 enum Statuses
 {
@@ -37,39 +18,29 @@ enum Statuses
 	FAINTED	= 6
 };
 
+#define POKEMON_NAME_LENGTH 11 //10 characters and a terminator
+#define OT_NAME_LENGTH 8
+
+//Only what differs between two pokemon of the same species is stored here, everything else is looked up
+//through Species(). Pokemon is trivially copyable so whole parties can be memcpy'd, eg. to simulate battles.
 class Pokemon
 {
 public:
 	Pokemon(unsigned char index = 0, unsigned char level = 1);
-	~Pokemon();
 
 	//i really hate making accessors and mutators
 	//so to avoid having 20 of them im just going to make the variables public.
 	//sue me.
 
 	unsigned char id;
-	unsigned char pokedex_index;
-	unsigned short ot;
 	unsigned char level;
-	unsigned int xp;
-	unsigned char growth_rate;
-	unsigned char catch_rate;
-	unsigned char xp_yield;
-	unsigned int hp;
-	string ot_name;
+	unsigned char status;
 	bool has_nickname;
+	unsigned short ot;
+	unsigned short hp;
+	unsigned int xp;
 
-	string original_name;
-	string nickname;
-	unsigned char type1;
-	unsigned char type2;
-
-	unsigned char base_hp;
-	unsigned char base_attack;
-	unsigned char base_defense;
-	unsigned char base_speed;
-	unsigned char base_special;
-
+	//calculated from the species, level, dvs and stat xp by RecalculateStats
 	unsigned short max_hp;
 	unsigned short attack;
 	unsigned short defense;
@@ -87,28 +58,66 @@ public:
 	unsigned char dv_defense;
 	unsigned char dv_speed;
 	unsigned char dv_special;
-	
-	unsigned char size_x;
-	unsigned char size_y;
 
 	Move moves[4];
-	Evolution evolutions[5];
-	LearnsetMove learnset[16];
 
-	unsigned char status;
+	char nickname[POKEMON_NAME_LENGTH]; //the species name if there's no nickname
+	char ot_name[OT_NAME_LENGTH];
+
+	//base stats, types, evolutions and so on are shared by the whole species
+	SpeciesInfo& Species() { return GameData::GetSpeciesInfo(id - 1); }
+	string& GetName() { return GameData::GetPokemonName(id - 1); }
+	unsigned char GetPokedexIndex() { return GameData::GetPokedexIndex(id - 1); }
+
+	void SetNickname(const string& name);
+	void SetOTName(const string& name);
 
 	void LoadStats(bool default_moves = false, unsigned char* move_count = 0);
 	void RecalculateStats();
+	void SetTrainerDVs(); //trainers' pokemon always have the same DVs in the game, this sets them and heals
 	void Heal();
+	//levels up as far as the xp goes and returns how many levels that was. the moves and evolution for the whole jump
+	//are Species().GetMovesLearned(old level, level) and Species().GetLevelEvolution(level)
+	unsigned char AddXP(unsigned int amount);
+
+	unsigned int GetXPRemaining() { return GetXPAt(level + 1, Species().growth_rate) - xp; }
+
+	//the game's stat formulas, with the same integer rounding. the old float versions added the level twice for
+	//everything but hp, so those stats are now exactly `level` lower than they used to be (see Tests/StatTest.cpp)
+	static unsigned int CalculateStat(unsigned char base, unsigned char dv, unsigned int stat_xp, unsigned char level)
+	{
+		return ((base + dv) * 2 + CalculateStatXP(stat_xp)) * level / 100 + 5;
+	}
+	static unsigned int CalculateHP(unsigned char base, unsigned char dv, unsigned int stat_xp, unsigned char level)
+	{
+		return ((base + dv) * 2 + CalculateStatXP(stat_xp)) * level / 100 + level + 10;
+	}
+	//ceil(sqrt(stat_xp)) / 4, where the square root stops counting at 255 like in the game. the root reaches 4 * b
+	//once stat_xp is over (4 * b - 1)^2, so the bonus is the largest b that is, found one bit at a time from the top
+	static constexpr unsigned int CalculateStatXP(unsigned int stat_xp)
+	{
+		return StatXPBit(stat_xp, StatXPBit(stat_xp, StatXPBit(stat_xp, StatXPBit(stat_xp, StatXPBit(stat_xp, StatXPBit(stat_xp, 0, 32), 16), 8), 4), 2), 1);
+	}
+	static constexpr unsigned int StatXPBit(unsigned int stat_xp, unsigned int bonus, unsigned int bit)
+	{
+		return (4 * (bonus + bit) - 1) * (4 * (bonus + bit) - 1) < stat_xp ? bonus + bit : bonus;
+	}
+
+	//total xp needed for a level, for each growth rate. GetXPAt reads it from a table built with this
+	static constexpr unsigned int CalculateXPAt(unsigned int level, unsigned char exp_type)
+	{
+		return exp_type == 3 ? (level * level * level * 6 / 5 + 100 * level > 15 * level * level + 140 ? level * level * level * 6 / 5 + 100 * level - 15 * level * level - 140 : 0) //medium slow, which would go negative at level 1
+			: exp_type == 4 ? level * level * level * 4 / 5
+			: exp_type == 5 ? level * level * level * 5 / 4
+			: level * level * level; //case 1 and 2 never actually occur...
+	}
+	static unsigned int GetXPAt(unsigned char level, unsigned char exp_type) { return xp_table[exp_type < 6 ? exp_type : 0][level < 100 ? level : 100]; }
 
-	unsigned int GetXPRemaining() { return GetXPAt(level + 1, growth_rate) - xp; }
-
-	static unsigned int CalculateStat(unsigned char base, unsigned char dv, unsigned int xp, unsigned char level);
-
-	static float CalculateStatXP(unsigned int xp, unsigned char level);
 	static const char* GetTypeName(unsigned char type);
 	static const char* GetStatusName(unsigned char s);
-	static unsigned int GetXPAt(unsigned char level, unsigned char exp_type);
 
 private:
+	static const unsigned int xp_table[6][101];
 };
+
+static_assert(std::is_trivially_copyable<Pokemon>::value, "Pokemon has to stay memcpy-safe");
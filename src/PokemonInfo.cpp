@@ -1,4 +1,5 @@
 #include "PokemonInfo.h"
+#include "RenderUtils.h"
 
 PokemonInfo::PokemonInfo()
 {
@@ -14,9 +15,9 @@ PokemonInfo::PokemonInfo()
 	//although the bottom textbox looks like an ordinary textbox,
 	//the current textbox class doesn't support instant full printout of text.
 	//so we can just fake it by making it a display-only menu
-	choose_textbox = new Textbox(0, 12, 20, 6, false);
+	choose_textbox = Textbox::Create(0, 12, 20, 6, false);
 	choose_textbox->SetMenu(true, 1, sf::Vector2i(0, 1), sf::Vector2u(0, 2), nullptr, MenuFlags::FOCUSABLE, 2147U, nullptr, true, sf::Vector2i(-10, 0));
-	choose_textbox->GetItems().push_back(new TextItem(choose_textbox, [this](TextItem* src) {this->GetChooseTextbox()->Close(); }, pokestring("Choose a #MON.")));
+	choose_textbox->GetItems().push_back(TextItem::Create(choose_textbox, [this](TextItem* src) {this->GetChooseTextbox()->Close(); }, pokestring("Choose a #MON.")));
 	choose_textbox->UpdateMenu();
 
 	//i spent over an hour on this trying to find out why it wouldn't switch properly.
@@ -34,14 +35,14 @@ PokemonInfo::PokemonInfo()
 		//this->UpdatePokemon(this->GetParty());
 	};
 
-	menu = new Textbox(-1, -1, 22, 13, false, true);
+	menu = Textbox::Create(-1, -1, 22, 13, false, true);
 	menu->SetMenu(true, 6, sf::Vector2i(3, 0), sf::Vector2u(0, 2), [this](TextItem* src)
 	{
 		this->GetChooseTextbox()->Close();
 	}, MenuFlags::FOCUSABLE | MenuFlags::SWITCHABLE | MenuFlags::WRAPS | MenuFlags::A_TO_SWITCH, INT_MAX, swapped, true, sf::Vector2i(-2, 1));
 	menu->SetArrowState(ArrowStates::ACTIVE);
 	menu->UpdateMenu();
-	menu->SetRenderCallback([this](sf::RenderWindow* w) { this->DrawHPBars(w); this->DrawIcons(w); });
+	menu->SetRenderCallback([this](sf::RenderTarget* w) { this->DrawHPBars(); this->DrawIcons(); this->compositor.Flush(w); });
 }
 
 PokemonInfo::~PokemonInfo()
@@ -49,19 +50,19 @@ PokemonInfo::~PokemonInfo()
 	if (menu)
 	{
 		//menu->CloseAll();
-		delete menu;
+		Textbox::Release(menu);
 	}
 	if (choose_textbox)
 	{
 		//choose_textbox->CloseAll();
-		delete choose_textbox;
+		Textbox::Release(choose_textbox);
 	}
 }
 
 void PokemonInfo::Show(Textbox* parent)
 {
 	choose_textbox->ClearItems();
-	choose_textbox->GetItems().push_back(new TextItem(choose_textbox, nullptr, pokestring("Choose a #MON.")));
+	choose_textbox->GetItems().push_back(TextItem::Create(choose_textbox, nullptr, pokestring("Choose a #MON.")));
 	choose_textbox->UpdateMenu();
 	menu->SetCloseCallback([this](TextItem* src) { this->GetChooseTextbox()->Close(true); });
 	menu->SetArrowState(ArrowStates::ACTIVE);
@@ -73,7 +74,7 @@ void PokemonInfo::Show(Textbox* parent, string text, std::function<void(TextItem
 {
 	this->parent = parent;
 	this->GetChooseTextbox()->ClearItems();
-	this->GetChooseTextbox()->GetItems().push_back(new TextItem(choose_textbox, nullptr, text));
+	this->GetChooseTextbox()->GetItems().push_back(TextItem::Create(choose_textbox, nullptr, text));
 	this->GetChooseTextbox()->UpdateMenu();
 	this->GetMenu()->SetCloseCallback(close_callback);
 	menu->SetArrowState(ArrowStates::ACTIVE);
@@ -103,22 +104,22 @@ void PokemonInfo::UpdatePokemon(Pokemon** party, bool show_able_notable)
 	auto select = [this](TextItem* src)
 	{
 		this->GetMenu()->SetArrowState(ArrowStates::INACTIVE);
-		Textbox* select = new Textbox(11, 11, 9, 7);
+		Textbox* select = Textbox::Create(11, 11, 9, 7);
 		select->SetMenu(true, 3, sf::Vector2i(1, 0), sf::Vector2u(0, 2), [this](TextItem* s) { this->GetMenu()->FlashCursor(); if (this->GetMenu()->GetArrowState() == ArrowStates::INACTIVE) this->GetMenu()->SetArrowState(ArrowStates::ACTIVE); }, MenuFlags::FOCUSABLE | MenuFlags::WRAPS);
 
 		auto _switch = [this](TextItem* src)
 		{
 			this->GetChooseTextbox()->ClearItems();
-			this->GetChooseTextbox()->GetItems().push_back(new TextItem(choose_textbox, nullptr, pokestring("Move #MON\n\nwhere?")));
+			this->GetChooseTextbox()->GetItems().push_back(TextItem::Create(choose_textbox, nullptr, pokestring("Move #MON\n\nwhere?")));
 			this->GetChooseTextbox()->UpdateMenu();
 			this->GetMenu()->InitializeSwitch();
 			src->GetParent()->Close();
 		};
 
 		select->SetArrowState(ArrowStates::ACTIVE);
-		select->GetItems().push_back(new TextItem(select, [this](TextItem* src) { DisplaySummary(this->GetParty()[this->GetMenu()->GetActiveIndex()]); }, pokestring("STATS"), 0));
-		select->GetItems().push_back(new TextItem(select, _switch, pokestring("SWITCH"), 0));
-		select->GetItems().push_back(new TextItem(select, [this](TextItem* src) {this->GetMenu()->FlashCursor(); this->GetMenu()->SetArrowState(ArrowStates::ACTIVE); src->GetParent()->Close(); }, pokestring("CANCEL"), 0));
+		select->GetItems().push_back(TextItem::Create(select, [this](TextItem* src) { DisplaySummary(this->GetParty()[this->GetMenu()->GetActiveIndex()]); }, pokestring("STATS"), 0));
+		select->GetItems().push_back(TextItem::Create(select, _switch, pokestring("SWITCH"), 0));
+		select->GetItems().push_back(TextItem::Create(select, [this](TextItem* src) {this->GetMenu()->FlashCursor(); this->GetMenu()->SetArrowState(ArrowStates::ACTIVE); src->GetParent()->Close(); }, pokestring("CANCEL"), 0));
 		select->UpdateMenu();
 
 		this->GetMenu()->ShowTextbox(select, false);
@@ -128,7 +129,7 @@ void PokemonInfo::UpdatePokemon(Pokemon** party, bool show_able_notable)
 	menu->ClearItems();
 	for (int i = 0; i < 6; i++)
 	{
-		menu->GetItems().push_back(new TextItem(menu, select, "", i, party[i]->id));
+		menu->GetItems().push_back(TextItem::Create(menu, select, "", i, party[i]->id));
 		UpdateOnePokemon((unsigned char)i, ability[i]);
 	}
 	menu->UpdateMenu();
@@ -188,12 +189,13 @@ void PokemonInfo::UpdateOnePokemon(unsigned char index, bool is_able)
 	menu->GetItems()[index]->SetText(s);
 }
 
-void PokemonInfo::DrawHPBars(sf::RenderWindow* window)
+void PokemonInfo::DrawHPBars()
 {
 	if (show_able_notable)
+	{
+		compositor.ClearBackground();
 		return;
-	sf::IntRect src_rect = sf::IntRect(0, 0, 8, 8);
-	sf::Sprite sprite8x8;
+	}
 	for (int i = 0; i < 6; i++)
 	{
 		unsigned int pixels = CalculateHPBars(party[i]->hp, party[i]->max_hp);
@@ -229,11 +231,11 @@ void PokemonInfo::DrawHPBars(sf::RenderWindow* window)
 				}
 			}
 		}
-		DrawHPBar(window, sprite8x8, src_rect, 6, i * 2 + 1, party[i], pixels);
+		RenderHPBar(&compositor, pixels, 6, i * 2 + 1);
 	}
 }
 
-void PokemonInfo::DrawIcons(sf::RenderWindow* window)
+void PokemonInfo::DrawIcons()
 {
 	if (menu->GetArrowState() & ArrowStates::ACTIVE)
 		selection_delay++;
@@ -244,13 +246,11 @@ void PokemonInfo::DrawIcons(sf::RenderWindow* window)
 	last_hover = GetMenu()->GetActiveIndex();
 
 	sf::IntRect src_rect = sf::IntRect(0, 0, 8, 8);
-	sf::Sprite sprite8x8;
-	sprite8x8.setTexture(*ResourceCache::GetPokemonIcons());
 	int dest_x, dest_y;
 	bool mirrored = false;
 	for (int i = 0; i < 6; i++)
 	{
-		unsigned char c = ResourceCache::GetIconIndex(party[i]->pokedex_index - 1);
+		unsigned char c = ResourceCache::GetIconIndex(party[i]->GetPokedexIndex() - 1);
 		if (c == 0 || c == 3 || c >= 6)
 			mirrored = true;
 		else
@@ -262,12 +262,11 @@ void PokemonInfo::DrawIcons(sf::RenderWindow* window)
 				unsigned char t = c * 4 + y * 2 + (!mirrored && x == 1 ? x : 0);
 				if (i == last_hover && selection_delay >= reset_point / 2)
 					t += 0x40; //animate
-				src_rect.left = (t % 16) * 8 + (mirrored && x == 1 ? 8 : 0);
+				src_rect.left = (t % 16) * 8;
 				src_rect.top = (t / 16) * 8;
-				src_rect.width = (mirrored && x == 1 ? -8 : 8);
 				src_rect.height = 8;
 
-				dest_x = (int)(8 + x * 8 + (mirrored && x == 1 ? 1 - x : 0) * 8);
+				dest_x = (int)(8 + x * 8);
 				dest_y = (int)(i * 16 + y * 8);
 				if (i == last_hover && (c == 1 || c == 2) && selection_delay >= reset_point / 2)
 				{
@@ -283,9 +282,7 @@ void PokemonInfo::DrawIcons(sf::RenderWindow* window)
 						dest_y--;
 				}
 
-				sprite8x8.setTextureRect(src_rect);
-				sprite8x8.setPosition((float)dest_x, (float)dest_y);
-				window->draw(sprite8x8);
+				compositor.AddSprite(dest_x, dest_y, ResourceCache::GetPokemonIcons(), src_rect, (mirrored && x == 1 ? TileFlags::FLIP_X : TileFlags::NONE));
 			}
 		}
 	}
@@ -311,40 +308,10 @@ void PokemonInfo::SwapPokemon()
 	}
 
 	choose_textbox->ClearItems();
-	choose_textbox->GetItems().push_back(new TextItem(choose_textbox, nullptr, pokestring("Choose a #MON.")));
+	choose_textbox->GetItems().push_back(TextItem::Create(choose_textbox, nullptr, pokestring("Choose a #MON.")));
 	choose_textbox->UpdateMenu();
 }
 
-void PokemonInfo::DrawHPBar(sf::RenderWindow* window, sf::Sprite& sprite8x8, sf::IntRect& src_rect, int x, int y, Pokemon* p, unsigned int pixels)
-{
-	src_rect.width = 8;
-	src_rect.height = 8;
-	if (pixels < 10)
-		sprite8x8.setTexture(*ResourceCache::GetStatusesTexture(2));
-	else if (pixels < 27)
-		sprite8x8.setTexture(*ResourceCache::GetStatusesTexture(1));
-	else
-		sprite8x8.setTexture(*ResourceCache::GetStatusesTexture(0));
-	for (int h = 0; h < 6; h++)
-	{
-		unsigned char c = 0x9; //full
-		if (pixels == 0)
-			c = 1;
-		else if (pixels < 8)
-		{
-			c = pixels + 1;
-			pixels = 0;
-		}
-		else
-			pixels -= 8;
-		src_rect.left = (c % 16) * 8;
-		src_rect.top = c / 16 * 8;
-		sprite8x8.setTextureRect(src_rect);
-		sprite8x8.setPosition((float)((h + x) * 8), (float)(y * 8));
-		window->draw(sprite8x8);
-	}
-}
-
 void PokemonInfo::Heal(int amount, std::function<void(TextItem* src)> f)
 {
 	if (f)
@@ -362,23 +329,25 @@ void PokemonInfo::Heal(int amount, std::function<void(TextItem* src)> f)
 void PokemonInfo::DisplaySummary(Pokemon* p)
 {
 	Engine::GetCryPlayer().Queue(p->id, MENU_DELAY_TIME);
-	Textbox* top = new Textbox(-1, 0, 22, 11, true, true);
+	Textbox* top = Textbox::Create(-1, 0, 22, 11, true, true);
 	top->SetMenu(true, 4, sf::Vector2i(9, 0), sf::Vector2u(0, 0));
-	top->SetRenderCallback([this](sf::RenderWindow* r) {
+	top->SetRenderCallback([this](sf::RenderTarget* r) {
 		sf::Sprite s;
 		sf::IntRect ir;
 		if (this->GetMenu()->GetTextboxes().size() > 3)
-		{
-			this->DrawHPBar(r, s, ir, 13, 3, this->GetParty()[this->GetMenu()->GetActiveIndex()], CalculateHPBars(party[menu->GetActiveIndex()]->hp, party[menu->GetActiveIndex()]->max_hp));
-		}
-		s.setTexture(*ResourceCache::GetPokemonFront(this->GetParty()[this->GetMenu()->GetActiveIndex()]->pokedex_index), true);
-		ir.left = this->GetParty()[this->GetMenu()->GetActiveIndex()]->size_x * 8;
+			RenderHPBar(&summary_compositor, CalculateHPBars(party[menu->GetActiveIndex()]->hp, party[menu->GetActiveIndex()]->max_hp), 13, 3);
+		else
+			summary_compositor.ClearBackground();
+		summary_compositor.Flush(r);
+		s.setTexture(*ResourceCache::GetPokemonFront(this->GetParty()[this->GetMenu()->GetActiveIndex()]->GetPokedexIndex()), true);
+		ir.left = this->GetParty()[this->GetMenu()->GetActiveIndex()]->Species().size_x * 8;
 		ir.top = 0;
-		ir.width = -this->GetParty()[this->GetMenu()->GetActiveIndex()]->size_x * 8;
-		ir.height = this->GetParty()[this->GetMenu()->GetActiveIndex()]->size_y * 8;
+		ir.width = -this->GetParty()[this->GetMenu()->GetActiveIndex()]->Species().size_x * 8;
+		ir.height = this->GetParty()[this->GetMenu()->GetActiveIndex()]->Species().size_y * 8;
 		s.setTextureRect(ir);
 		s.setPosition((float)(64 + ir.width), (float)(56 - ir.height));
 		r->draw(s);
+		Profiler::CountDraw(s.getTexture());
 	});
 
 	string s = p->nickname;
@@ -405,9 +374,9 @@ void PokemonInfo::DisplaySummary(Pokemon* p)
 	s.append(pokestring(itos(p->max_hp).c_str()));
 	s.append(pokestring("\n\nSTATUS/").append(pokestring(Pokemon::GetStatusName(p->status))).append(pokestring("  ")));
 	s.insert(s.end(), 0x12); //No
-	s.append(pokestring(string(".").append(p->pokedex_index < 100 ? "0" : "").append(p->pokedex_index < 10 ? "0" : "").append(itos(p->pokedex_index)).c_str()));
+	s.append(pokestring(string(".").append(p->GetPokedexIndex() < 100 ? "0" : "").append(p->GetPokedexIndex() < 10 ? "0" : "").append(itos(p->GetPokedexIndex())).c_str()));
 
-	top->GetItems().push_back(new TextItem(top, nullptr, s));
+	top->GetItems().push_back(TextItem::Create(top, nullptr, s));
 	top->UpdateMenu();
 
 	for (int i = 1; i < 7; i++)
@@ -421,16 +390,16 @@ void PokemonInfo::DisplaySummary(Pokemon* p)
 
 
 
-	Textbox* bottom = new Textbox(9, 8, 12, 10, true, true);
+	Textbox* bottom = Textbox::Create(9, 8, 12, 10, true, true);
 	bottom->SetMenu(true, 4, sf::Vector2i(0, 0), sf::Vector2u(0, 2));
-	bottom->GetItems().push_back(new TextItem(bottom, nullptr, pokestring(string("TYPE1/\n ").append(Pokemon::GetTypeName(p->type1)))));
-	bottom->GetItems().push_back(new TextItem(bottom, nullptr, (p->type2 != p->type1 ? pokestring(string("TYPE2/\n ").append(Pokemon::GetTypeName(p->type2))) : "")));
+	bottom->GetItems().push_back(TextItem::Create(bottom, nullptr, pokestring(string("TYPE1/\n ").append(Pokemon::GetTypeName(p->Species().type1)))));
+	bottom->GetItems().push_back(TextItem::Create(bottom, nullptr, (p->Species().type2 != p->Species().type1 ? pokestring(string("TYPE2/\n ").append(Pokemon::GetTypeName(p->Species().type2))) : "")));
 	s = 0x11;
 	s.insert(s.end(), 0x12);
 	s.append(pokestring("/\n  "));
 	s.append(pokestring(itos(p->ot).c_str()));
-	bottom->GetItems().push_back(new TextItem(bottom, nullptr, s));
-	bottom->GetItems().push_back(new TextItem(bottom, nullptr, string(pokestring("OT/\n  ")).append(p->ot_name)));
+	bottom->GetItems().push_back(TextItem::Create(bottom, nullptr, s));
+	bottom->GetItems().push_back(TextItem::Create(bottom, nullptr, string(pokestring("OT/\n  ")).append(p->ot_name)));
 	bottom->UpdateMenu();
 
 	for (int i = 0; i < 8; i++)
@@ -444,7 +413,7 @@ void PokemonInfo::DisplaySummary(Pokemon* p)
 
 
 	auto f = [this](TextItem* src) { this->DisplaySummary2(this->GetParty()[this->GetMenu()->GetActiveIndex()]); };
-	Textbox* stats = new Textbox(0, 8, 10, 10);
+	Textbox* stats = Textbox::Create(0, 8, 10, 10);
 	stats->SetMenu(true, 4, sf::Vector2i(0, 0), sf::Vector2u(0, 2), f, MenuFlags::FOCUSABLE, 2147u, nullptr, true, sf::Vector2i(-100, 0));
 	PokemonUtils::WriteStats(stats, p, 0);
 
@@ -461,7 +430,7 @@ void PokemonInfo::DisplaySummary2(Pokemon* p)
 
 	Textbox* top = this->GetMenu()->GetTextboxes()[1];
 	top->ClearItems();
-	string s = p->original_name;
+	string s = p->GetName();
 	s.append(pokestring("\n\nEXP POINTS\n   "));
 	unsigned int digits = (p->xp > 0 ? (unsigned int)floor(log10(p->xp) + 1) : 1);
 	for (unsigned int i = 0; i < 7 - digits; i++)
@@ -484,9 +453,9 @@ void PokemonInfo::DisplaySummary2(Pokemon* p)
 	s.insert(s.end(), MENU_BLANK);
 
 	s.insert(s.end(), 0x12);
-	s.append(pokestring(string(".").append(p->pokedex_index < 100 ? "0" : "").append(p->pokedex_index < 10 ? "0" : "").append(itos(p->pokedex_index)).c_str()));
+	s.append(pokestring(string(".").append(p->GetPokedexIndex() < 100 ? "0" : "").append(p->GetPokedexIndex() < 10 ? "0" : "").append(itos(p->GetPokedexIndex())).c_str()));
 
-	top->GetItems().push_back(new TextItem(top, nullptr, s));
+	top->GetItems().push_back(TextItem::Create(top, nullptr, s));
 	top->UpdateMenu();
 
 	for (int i = 1; i < 7; i++)
@@ -506,12 +475,12 @@ void PokemonInfo::DisplaySummary2(Pokemon* p)
 		this->GetChooseTextbox()->SetJustOpened();
 	};
 
-	Textbox* moves = new Textbox(0, 8, 20, 10);
+	Textbox* moves = Textbox::Create(0, 8, 20, 10);
 	moves->SetMenu(true, 4, sf::Vector2i(1, 0), sf::Vector2u(0, 2), f, MenuFlags::FOCUSABLE, 2147u, nullptr, true, sf::Vector2i(-2, 0));
 	moves->SetArrowState(ArrowStates::ACTIVE);
 	for (int i = 0; i < 4; i++)
 	{
-		string s = p->moves[i].name;
+		string s = p->moves[i].GetName();
 		s.append(pokestring("\n         "));
 		if (p->moves[i].index > 0)
 		{
@@ -526,7 +495,7 @@ void PokemonInfo::DisplaySummary2(Pokemon* p)
 		}
 		else
 			s.append(pokestring("--"));
-		moves->GetItems().push_back(new TextItem(moves, f, s));
+		moves->GetItems().push_back(TextItem::Create(moves, f, s));
 	}
 	moves->UpdateMenu();
 
@@ -4,6 +4,7 @@
 #include "Pokemon.h"
 #include "TileMap.h"
 #include "PokemonUtils.h"
+#include "TileCompositor.h"
 
 class PokemonInfo
 {
@@ -18,16 +19,14 @@ public:
 	void FocusChooseTextbox();
 	void UpdatePokemon(Pokemon** party, bool show_able_notable = false);
 	void UpdateOnePokemon(unsigned char index, bool is_able = false);
-	void DrawHPBars(sf::RenderWindow* window);
-	void DrawIcons(sf::RenderWindow* window);
+	void DrawHPBars();
+	void DrawIcons();
 	Pokemon** GetParty() { return party; }
 	unsigned char CalculateHPBars(unsigned int hp, unsigned int max_hp);
 	void SwapPokemon();
 	void DisplaySummary(Pokemon* p);
 	void DisplaySummary2(Pokemon* p);
 
-	void DrawHPBar(sf::RenderWindow* window, sf::Sprite& sprite8x8, sf::IntRect& src_rect, int x, int y, Pokemon* p, unsigned int pixels);
-
 	void Heal(int amount, std::function<void(TextItem* src)> finished);
 	int GetHPAmountChanged() { return hp_amount_changed; }
 
@@ -46,6 +45,8 @@ private:
 	unsigned char last_hover;
 	bool ability[6];
 	bool show_able_notable;
+	TileCompositor compositor; //hp bars and icons of the party menu
+	TileCompositor summary_compositor; //hp bar of the summary screen
 
 	//hp recovery and draining
 	int delta_hp;
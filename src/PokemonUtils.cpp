@@ -9,7 +9,7 @@ void PokemonUtils::WriteStats(Textbox* t, Pokemon* p, char x)
 		s.insert(s.end(), ' ');
 	s.append(itos(p->attack));
 
-	t->GetItems().push_back(new TextItem(t, nullptr, pokestring(s)));
+	t->GetItems().push_back(TextItem::Create(t, nullptr, pokestring(s)));
 
 	s = "DEFENSE\n";
 	for (int i = 0; i < x; i++)
@@ -17,7 +17,7 @@ void PokemonUtils::WriteStats(Textbox* t, Pokemon* p, char x)
 	for (int i = 0; i < 5 + (p->defense < 10 ? 2 : p->defense < 100 ? 1 : 0); i++)
 		s.insert(s.end(), ' ');
 	s.append(itos(p->defense));
-	t->GetItems().push_back(new TextItem(t, nullptr, pokestring(s)));
+	t->GetItems().push_back(TextItem::Create(t, nullptr, pokestring(s)));
 
 	s = "SPEED\n";
 	for (int i = 0; i < x; i++)
@@ -25,7 +25,7 @@ void PokemonUtils::WriteStats(Textbox* t, Pokemon* p, char x)
 	for (int i = 0; i < 5 + (p->speed < 10 ? 2 : p->speed < 100 ? 1 : 0); i++)
 		s.insert(s.end(), ' ');
 	s.append(itos(p->speed));
-	t->GetItems().push_back(new TextItem(t, nullptr, pokestring(s)));
+	t->GetItems().push_back(TextItem::Create(t, nullptr, pokestring(s)));
 
 	s = "SPECIAL\n";
 	for (int i = 0; i < x; i++)
@@ -34,7 +34,7 @@ void PokemonUtils::WriteStats(Textbox* t, Pokemon* p, char x)
 		s.insert(s.end(), ' ');
 	s.append(itos(p->special));
 
-	t->GetItems().push_back(new TextItem(t, nullptr, pokestring(s)));
+	t->GetItems().push_back(TextItem::Create(t, nullptr, pokestring(s)));
 
 	t->UpdateMenu();
 }
@@ -43,7 +43,7 @@ void PokemonUtils::Levelup(TextItem* src, Pokemon* p, std::function<void(TextIte
 {
 	auto stats_f = [p, src, action_callback](TextItem* s)
 	{
-		Textbox* stats = new Textbox(9, 2, 11, 10);
+		Textbox* stats = Textbox::Create(9, 2, 11, 10);
 		auto close = [action_callback, stats](TextItem* z) {stats->Close(true); action_callback(z); };
 		stats->SetMenu(true, 4, sf::Vector2i(0, 0), sf::Vector2u(0, 2), close, MenuFlags::FOCUSABLE, 2147u, nullptr, true, sf::Vector2i(-100, 0));
 		PokemonUtils::WriteStats(stats, p, 1);
@@ -54,39 +54,24 @@ void PokemonUtils::Levelup(TextItem* src, Pokemon* p, std::function<void(TextIte
 		MenuCache::PokemonMenu()->GetChooseTextbox()->ShowTextbox(stats, false);
 
 		bool learned_move = false;
-		for (int i = 0; i < 16; i++)
+		const unsigned char* learned;
+		unsigned char learned_count = p->Species().GetMovesLearned(p->level - 1, p->level, &learned);
+		if (learned_count > 0)
 		{
-			if (p->learnset[i].level == 0)
-				break;
-			if (p->learnset[i].level == p->level)
-			{
-				std::function<void(TextItem* t)> m_f = LearnMove(stats, p, p->learnset[i].move);
-				for (int i = 0; i < 4; i++)
-					stats->GetItems()[i]->SetAction(m_f);
-				stats->SetTextTimer();
-				learned_move = true;
-			}
+			std::function<void(TextItem* t)> m_f = LearnMove(stats, p, learned[learned_count - 1]);
+			for (int i = 0; i < 4; i++)
+				stats->GetItems()[i]->SetAction(m_f);
+			stats->SetTextTimer();
+			learned_move = true;
 		}
 
-		if (!learned_move)
+		if (!learned_move && p->Species().GetLevelEvolution(p->level))
 		{
-			for (int i = 0; i < 5; i++)
-			{
-				if (p->evolutions[i].trigger != 0)
-				{
-					if (p->evolutions[i].trigger == EVOLUTION_LEVEL && p->evolutions[i].level <= p->level)
-					{
-						auto m_f = Evolve(stats, p, p->evolutions[i].pokemon);
-						for (int i = 0; i < 4; i++)
-							stats->GetItems()[i]->SetAction(m_f);
-						stats->SetTextTimer();
-						learned_move = true;
-						break;
-					}
-				}
-				else
-					break;
-			}
+			auto m_f = Evolve(stats, p, p->Species().GetLevelEvolution(p->level));
+			for (int i = 0; i < 4; i++)
+				stats->GetItems()[i]->SetAction(m_f);
+			stats->SetTextTimer();
+			learned_move = true;
 		}
 	};
 
@@ -115,24 +100,11 @@ std::function<void(TextItem* s)> PokemonUtils::LearnMove(Textbox* src, Pokemon*
 			p->moves[i] = Move(move);
 			auto m_f = [src, p, i, close_src](TextItem* s_t)
 			{
-				Textbox* learned = new Textbox();
+				Textbox* learned = Textbox::Create();
 
-				std::function<void(TextItem* s)> m_f = nullptr;
-				for (int k = 0; k < 5; k++)
-				{
-					if (p->evolutions[k].trigger != 0)
-					{
-						if (p->evolutions[k].trigger == EVOLUTION_LEVEL && p->evolutions[k].level <= p->level)
-						{
-							m_f = Evolve(src, p, p->evolutions[k].pokemon);
-							break;
-						}
-					}
-					else
-						break;
-				}
+				std::function<void(TextItem* s)> m_f = CheckMove(src, p);
 
-				learned->SetText(new TextItem(src, m_f, string(p->nickname).append(pokestring(" learned\n").append(p->moves[i].name).append(pokestring("!\f")))));
+				learned->SetText(TextItem::Create(src, m_f, string(p->nickname).append(pokestring(" learned\n").append(p->moves[i].GetName()).append(pokestring("!\f")))));
 
 				if (close_src && !m_f)
 				{
@@ -152,18 +124,18 @@ std::function<void(TextItem* s)> PokemonUtils::LearnMove(Textbox* src, Pokemon*
 	//i also got sick of having to use a TextItem parameter, so the names increment for simplicity.
 	auto m_f = [src, p, move, close_src](TextItem* s_t)
 	{
-		Textbox* learned = new Textbox();
+		Textbox* learned = Textbox::Create();
 
 		auto yes_no = [learned, src, p, move, close_src](TextItem* s)
 		{
-			Textbox* yn = new Textbox(14, 7, 6, 5);
+			Textbox* yn = Textbox::Create(14, 7, 6, 5);
 			auto no = [learned, yn, src, p, move, close_src](TextItem* s2)
 			{
-				Textbox* abandon = new Textbox();
+				Textbox* abandon = Textbox::Create();
 
 				auto confirm_abandon = [abandon, learned, src, p, move, close_src, yn](TextItem* s3)
 				{
-					Textbox* yn2 = new Textbox(14, 7, 6, 5);
+					Textbox* yn2 = Textbox::Create(14, 7, 6, 5);
 					auto reset = [yn2, src, learned, abandon, yn](TextItem* s3) {
 						yn2->Close(true);
 						abandon->Close();
@@ -178,46 +150,46 @@ std::function<void(TextItem* s)> PokemonUtils::LearnMove(Textbox* src, Pokemon*
 					{
 						yn2->Close(true);
 						abandon->Close();
-						Textbox* forgotten = new Textbox();
+						Textbox* forgotten = Textbox::Create();
 
 						std::function<void(TextItem* s)> e_f = CheckMove(src, p);
 						
-						forgotten->SetText(new TextItem(forgotten, (!e_f ? [src, learned](TextItem* s4) { src->Close(true); MenuCache::PokemonMenu()->GetMenu()->Close(); } : e_f), string(p->nickname).append(pokestring("\ndid not learn\v")).append(Move(move).name).append(pokestring("!\f"))));
+						forgotten->SetText(TextItem::Create(forgotten, (!e_f ? [src, learned](TextItem* s4) { src->Close(true); MenuCache::PokemonMenu()->GetMenu()->Close(); } : e_f), string(p->nickname).append(pokestring("\ndid not learn\v")).append(Move(move).GetName()).append(pokestring("!\f"))));
 						src->ShowTextbox(forgotten, false);
 					};
 
 					yn2->SetMenu(true, 2, sf::Vector2i(1, 0), sf::Vector2u(0, 2), reset, MenuFlags::FOCUSABLE);
 					yn2->SetArrowState(ArrowStates::ACTIVE);
-					yn2->GetItems().push_back(new TextItem(yn2, quit, pokestring("YES"), 0));
-					yn2->GetItems().push_back(new TextItem(yn2, reset, pokestring("NO"), 1));
+					yn2->GetItems().push_back(TextItem::Create(yn2, quit, pokestring("YES"), 0));
+					yn2->GetItems().push_back(TextItem::Create(yn2, reset, pokestring("NO"), 1));
 					yn2->UpdateMenu();
 					abandon->CancelClose();
 					abandon->ShowTextbox(yn2, false);
 				};
 
 				yn->Close(true);
-				abandon->SetText(new TextItem(abandon, confirm_abandon, pokestring("Abandon learning\n").append(Move(move).name).append(pokestring("?\a"))));
+				abandon->SetText(TextItem::Create(abandon, confirm_abandon, pokestring("Abandon learning\n").append(Move(move).GetName()).append(pokestring("?\a"))));
 				learned->CancelClose();
 				learned->ShowTextbox(abandon, false);
 			};
 
 			auto yes = [no, learned, yn, src, p, move, close_src](TextItem* s)
 			{
-				Textbox* which_move = new Textbox();
+				Textbox* which_move = Textbox::Create();
 
 				auto show_moves = [no, which_move, src, p, move, close_src, learned](TextItem* s2)
 				{
-					Textbox* moves = new Textbox(4, 7, 16, 6);
+					Textbox* moves = Textbox::Create(4, 7, 16, 6);
 
 					auto move_selected = [which_move, moves, src, p, move, learned](TextItem* s3)
 					{
 						moves->Close(true);
-						Textbox* last = new Textbox();
+						Textbox* last = Textbox::Create();
 
 						std::function<void(TextItem* s)> e_f = CheckMove(src, p);
 						std::function<void(TextItem* s)> real_ef = [src, learned, which_move, e_f](TextItem* s4) {learned->Close(true); which_move->Close(true); e_f(s4); };
 
-						last->SetText(new TextItem(last, (!e_f ? [src, learned, which_move](TextItem* s4) { learned->Close(true); which_move->Close(true); src->Close(); MenuCache::PokemonMenu()->GetMenu()->Close(); } : real_ef), pokestring("1, 2 and... \tPoof!\r").append(p->nickname).append(pokestring(" forgot\n")).append(p->moves[moves->GetActiveIndex()].name).append(pokestring("!\rAnd...\r").append(p->nickname).append(pokestring(" learned\n")).append(Move(move).name).append(pokestring("!\f")))));
+						last->SetText(TextItem::Create(last, (!e_f ? [src, learned, which_move](TextItem* s4) { learned->Close(true); which_move->Close(true); src->Close(); MenuCache::PokemonMenu()->GetMenu()->Close(); } : real_ef), pokestring("1, 2 and... \tPoof!\r").append(p->nickname).append(pokestring(" forgot\n")).append(p->moves[moves->GetActiveIndex()].GetName()).append(pokestring("!\rAnd...\r").append(p->nickname).append(pokestring(" learned\n")).append(Move(move).GetName()).append(pokestring("!\f")))));
 						p->moves[moves->GetActiveIndex()] = Move(move);
 						which_move->ShowTextbox(last, false);
 					};
@@ -226,7 +198,7 @@ std::function<void(TextItem* s)> PokemonUtils::LearnMove(Textbox* src, Pokemon*
 					moves->SetArrowState(ArrowStates::ACTIVE);
 					for (unsigned int i = 0; i < 4; i++)
 					{
-						moves->GetItems().push_back(new TextItem(moves, move_selected, p->moves[i].name, i));
+						moves->GetItems().push_back(TextItem::Create(moves, move_selected, p->moves[i].GetName(), i));
 					}
 					moves->UpdateMenu();
 					which_move->CancelClose();
@@ -234,21 +206,21 @@ std::function<void(TextItem* s)> PokemonUtils::LearnMove(Textbox* src, Pokemon*
 				};
 
 				yn->Close(true);
-				which_move->SetText(new TextItem(which_move, show_moves, pokestring("Which move should\nbe forgotten?\a")));
+				which_move->SetText(TextItem::Create(which_move, show_moves, pokestring("Which move should\nbe forgotten?\a")));
 				learned->CancelClose();
 				learned->ShowTextbox(which_move, false);
 			};
 			yn->SetMenu(true, 2, sf::Vector2i(1, 0), sf::Vector2u(0, 2), no, MenuFlags::FOCUSABLE);
 			yn->SetArrowState(ArrowStates::ACTIVE);
-			yn->GetItems().push_back(new TextItem(yn, yes, pokestring("YES"), 0));
-			yn->GetItems().push_back(new TextItem(yn, no, pokestring("NO"), 1));
+			yn->GetItems().push_back(TextItem::Create(yn, yes, pokestring("YES"), 0));
+			yn->GetItems().push_back(TextItem::Create(yn, no, pokestring("NO"), 1));
 			yn->UpdateMenu();
 			learned->CancelClose();
 			learned->ShowTextbox(yn, false);
 		};
 
-		string text = string(p->nickname).append(pokestring(" is\ntrying to learn\v").append(Move(move).name).append(pokestring("!\rBut, "))).append(p->nickname).append(pokestring("\ncan't learn more\vthan 4 moves!\rDelete an older\nmove to make room\vfor ")).append(Move(move).name).append(pokestring("?\a"));
-		learned->SetText(new TextItem(src, yes_no, text));
+		string text = string(p->nickname).append(pokestring(" is\ntrying to learn\v").append(Move(move).GetName()).append(pokestring("!\rBut, "))).append(p->nickname).append(pokestring("\ncan't learn more\vthan 4 moves!\rDelete an older\nmove to make room\vfor ")).append(Move(move).GetName()).append(pokestring("?\a"));
+		learned->SetText(TextItem::Create(src, yes_no, text));
 
 		
 
@@ -267,7 +239,7 @@ std::function<void(TextItem* s)> PokemonUtils::Evolve(Textbox* src, Pokemon* p,
 	auto mf = [src, p, evolution, close_src](TextItem* s)
 	{
 		src->CancelClose();
-		Textbox* what = new Textbox();
+		Textbox* what = Textbox::Create();
 
 		auto start_evolution = [what, p, src, evolution](TextItem* s2)
 		{
@@ -284,7 +256,7 @@ std::function<void(TextItem* s)> PokemonUtils::Evolve(Textbox* src, Pokemon* p,
 			});
 		};
 
-		what->SetText(new TextItem(what, start_evolution, pokestring("What? ").append(p->nickname).append(pokestring("\nis evolving!\t\t\a"))));
+		what->SetText(TextItem::Create(what, start_evolution, pokestring("What? ").append(p->nickname).append(pokestring("\nis evolving!\t\t\a"))));
 		what->SetArrowState(ArrowStates::INACTIVE);
 		src->ShowTextbox(what, false);
 	};
@@ -294,19 +266,8 @@ std::function<void(TextItem* s)> PokemonUtils::Evolve(Textbox* src, Pokemon* p,
 
 std::function<void(TextItem* s)> PokemonUtils::CheckMove(Textbox* src, Pokemon* p)
 {
-	for (int k = 0; k < 5; k++)
-	{
-		if (p->evolutions[k].trigger != 0)
-		{
-			if (p->evolutions[k].trigger == EVOLUTION_LEVEL &&p->evolutions[k].level <= p->level)
-			{
-				return Evolve(src, p, p->evolutions[k].pokemon);
-				break;
-			}
-		}
-		else
-			break;
-	}
+	if (p->Species().GetLevelEvolution(p->level))
+		return Evolve(src, p, p->Species().GetLevelEvolution(p->level));
 
 	return nullptr;
 }
@@ -315,8 +276,8 @@ void PokemonUtils::Faint(MapScene* scene, Textbox* t)
 {
 	t->GetText()->SetAction([t, scene](TextItem* src)
 	{
-		Textbox* f = new Textbox();
-		f->SetText(new TextItem(f, [scene](TextItem* s2)
+		Textbox* f = Textbox::Create();
+		f->SetText(TextItem::Create(f, [scene](TextItem* s2)
 		{
 			Warp w;
 			w.dest_map = scene->GetLastHealedMap();
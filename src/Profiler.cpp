@@ -0,0 +1,312 @@
+#include "Profiler.h"
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <new>
+#include <cstdlib>
+#include "ResourceCache.h"
+#include "StringConverter.h"
+#include "Utils.h"
+
+sf::Clock Profiler::clock;
+sf::Mutex Profiler::mutex;
+
+sf::Int64 Profiler::frame_start = 0;
+sf::Int64 Profiler::section_start[ProfileSections::COUNT];
+unsigned char Profiler::section_depth[ProfileSections::COUNT];
+const sf::Texture* Profiler::last_texture = 0;
+unsigned int Profiler::draw_calls = 0;
+unsigned int Profiler::texture_binds = 0;
+unsigned int Profiler::set_palette_calls = 0;
+unsigned char Profiler::current_section = ProfileSections::COUNT;
+unsigned int Profiler::allocations[ALLOCATION_TAGS];
+std::size_t Profiler::allocated_bytes[ALLOCATION_TAGS];
+std::thread::id Profiler::main_thread;
+std::atomic<unsigned int> Profiler::thread_allocations(0);
+std::atomic<std::size_t> Profiler::thread_allocated_bytes(0);
+unsigned int Profiler::last_allocations[ALLOCATION_TAGS];
+std::size_t Profiler::last_allocated_bytes[ALLOCATION_TAGS];
+
+sf::Int64 Profiler::frame_total = 0;
+sf::Int64 Profiler::section_total[ProfileSections::COUNT];
+unsigned int Profiler::draw_total = 0;
+unsigned int Profiler::bind_total = 0;
+unsigned int Profiler::set_palette_total = 0;
+unsigned int Profiler::allocation_total = 0;
+std::size_t Profiler::allocated_bytes_total = 0;
+unsigned int Profiler::averaged_frames = 0;
+
+bool Profiler::overlay_visible = false;
+SpriteBatch Profiler::overlay;
+
+bool Profiler::tracing = false;
+unsigned int Profiler::trace_frames = 0;
+std::vector<Profiler::TraceEvent> Profiler::trace;
+
+static const char* section_names[ProfileSections::COUNT] = { "Scene update", "Scripts", "Entity update", "Map render", "Entity render", "Textbox render", "Audio" };
+static const char* overlay_names[ProfileSections::COUNT] = { "UPDATE", "SCRIPT", "ENTITY", "MAP R", "ENT R", "TEXT R", "AUDIO" };
+void Profiler::Initialize()
+{
+	main_thread = std::this_thread::get_id();
+}
+
+void Profiler::BeginFrame()
+{
+	frame_start = Now();
+	last_texture = 0;
+	draw_calls = 0;
+	texture_binds = 0;
+	set_palette_calls = 0;
+}
+
+void Profiler::EndFrame()
+{
+	sf::Int64 now = Now();
+	frame_total += now - frame_start;
+	draw_total += draw_calls;
+	bind_total += texture_binds;
+	set_palette_total += set_palette_calls;
+
+	//other threads' allocations get lumped in with audio, since that's all that runs on them
+	allocations[ProfileSections::AUDIO] += thread_allocations.exchange(0);
+	allocated_bytes[ProfileSections::AUDIO] += thread_allocated_bytes.exchange(0);
+	for (int i = 0; i < ALLOCATION_TAGS; i++)
+	{
+		allocation_total += allocations[i];
+		allocated_bytes_total += allocated_bytes[i];
+		last_allocations[i] = allocations[i];
+		last_allocated_bytes[i] = allocated_bytes[i];
+		allocations[i] = 0;
+		allocated_bytes[i] = 0;
+	}
+
+	if (tracing)
+	{
+		TraceEvent e = { ProfileSections::COUNT, frame_start, now - frame_start, draw_calls, texture_binds, set_palette_calls, GetFrameAllocations() };
+		mutex.lock();
+		trace.push_back(e);
+		mutex.unlock();
+		if (++trace_frames >= PROFILER_TRACE_FRAMES)
+			StopTrace();
+	}
+
+	if (++averaged_frames >= PROFILER_AVERAGE_FRAMES)
+	{
+		if (overlay_visible)
+			BuildOverlay();
+		frame_total = 0;
+		draw_total = bind_total = set_palette_total = 0;
+		allocation_total = 0;
+		allocated_bytes_total = 0;
+		averaged_frames = 0;
+		sf::Lock lock(mutex);
+		for (int i = 0; i < ProfileSections::COUNT; i++)
+			section_total[i] = 0;
+	}
+}
+
+unsigned char Profiler::Begin(unsigned char section)
+{
+	unsigned char previous = current_section;
+	current_section = section;
+	if (section_depth[section]++ == 0)
+		section_start[section] = Now();
+	return previous;
+}
+
+void Profiler::End(unsigned char section, unsigned char previous)
+{
+	current_section = previous;
+	if (section_depth[section] == 0 || --section_depth[section] > 0)
+		return;
+	sf::Int64 duration = Now() - section_start[section];
+	section_total[section] += duration;
+	if (tracing)
+	{
+		sf::Lock lock(mutex);
+		AddTraceEvent(section, section_start[section], duration);
+	}
+}
+
+void Profiler::AddAudioTime(sf::Int64 start, sf::Int64 duration)
+{
+	sf::Lock lock(mutex);
+	section_total[ProfileSections::AUDIO] += duration;
+	if (tracing)
+		AddTraceEvent(ProfileSections::AUDIO, start, duration);
+}
+
+void Profiler::CountDraw(const sf::Texture* texture)
+{
+	draw_calls++;
+	if (texture != last_texture)
+	{
+		texture_binds++;
+		last_texture = texture;
+	}
+}
+
+void Profiler::CountAllocation(std::size_t size)
+{
+	if (std::this_thread::get_id() != main_thread)
+	{
+		thread_allocations++;
+		thread_allocated_bytes += size;
+		return;
+	}
+	allocations[current_section]++;
+	allocated_bytes[current_section] += size;
+}
+
+unsigned int Profiler::GetFrameAllocations()
+{
+	unsigned int count = 0;
+	for (int i = 0; i < ALLOCATION_TAGS; i++)
+		count += last_allocations[i];
+	return count;
+}
+
+void Profiler::PrintFrameAllocations()
+{
+	for (int i = 0; i < ALLOCATION_TAGS; i++)
+	{
+		if (last_allocations[i] == 0)
+			continue;
+		std::cout << (i < ProfileSections::COUNT ? section_names[i] : "Other") << ": " << last_allocations[i] << " allocations, " << last_allocated_bytes[i] << " bytes\n";
+	}
+}
+
+void Profiler::DrawOverlay(sf::RenderTarget* target)
+{
+	overlay.Draw(target);
+}
+
+void Profiler::StartTrace()
+{
+	sf::Lock lock(mutex);
+	trace.clear();
+	trace_frames = 0;
+	tracing = true;
+}
+
+void Profiler::StopTrace()
+{
+	mutex.lock();
+	tracing = false;
+	std::vector<TraceEvent> events;
+	events.swap(trace);
+	mutex.unlock();
+
+	std::ofstream out(PROFILER_TRACE_FILE);
+	if (!out.is_open())
+	{
+#ifdef _DEBUG
+		std::cout << "Couldn't write " << PROFILER_TRACE_FILE << "\n";
+#endif
+		return;
+	}
+	out << "{\"traceEvents\":[\n";
+	for (unsigned int i = 0; i < events.size(); i++)
+	{
+		TraceEvent& e = events[i];
+		if (e.section == ProfileSections::COUNT)
+		{
+			out << "{\"name\":\"Frame\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << e.start << ",\"dur\":" << e.duration << "},\n";
+			out << "{\"name\":\"Counters\",\"ph\":\"C\",\"pid\":1,\"ts\":" << e.start << ",\"args\":{\"draw calls\":" << e.draws << ",\"texture binds\":" << e.binds << ",\"SetPalette calls\":" << e.set_palettes << ",\"allocations\":" << e.allocations << "}}";
+		}
+		else
+		{
+			//audio gets its own row since it runs on other threads
+			out << "{\"name\":\"" << section_names[e.section] << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << (e.section == ProfileSections::AUDIO ? 2 : 1) << ",\"ts\":" << e.start << ",\"dur\":" << e.duration << "}";
+		}
+		out << (i + 1 < events.size() ? ",\n" : "\n");
+	}
+	out << "]}\n";
+#ifdef _DEBUG
+	std::cout << "Wrote " << events.size() << " trace events to " << PROFILER_TRACE_FILE << "\n";
+#endif
+}
+
+void Profiler::AddTraceEvent(unsigned char section, sf::Int64 start, sf::Int64 duration)
+{
+	TraceEvent e = { section, start, duration, 0, 0, 0, 0 };
+	trace.push_back(e);
+}
+
+void Profiler::BuildOverlay()
+{
+	//one line per number, in microseconds, using the game's font on top of blank menu tiles
+	std::vector<string> lines;
+	lines.push_back(string("FRAME ").append(itos((int)(frame_total / averaged_frames))));
+	sf::Lock lock(mutex);
+	for (int i = 0; i < ProfileSections::COUNT; i++)
+		lines.push_back(string(overlay_names[i]).append(" ").append(itos((int)(section_total[i] / averaged_frames))));
+	lines.push_back(string("DRAW ").append(itos(draw_total / averaged_frames)));
+	lines.push_back(string("BIND ").append(itos(bind_total / averaged_frames)));
+	lines.push_back(string("PAL ").append(itos(set_palette_total / averaged_frames)));
+#ifdef PROFILE_ALLOCATIONS
+	lines.push_back(string("ALLOC ").append(itos(allocation_total / averaged_frames)));
+	lines.push_back(string("BYTES ").append(itos((int)(allocated_bytes_total / averaged_frames))));
+#endif
+
+	overlay.Clear();
+	for (unsigned int y = 0; y < lines.size(); y++)
+	{
+		pokestring(lines[y]);
+		for (unsigned int x = 0; x < lines[y].length(); x++)
+		{
+			unsigned char tile = (unsigned char)lines[y][x] & 0x7F;
+			overlay.Add(x * 8, y * 8, ResourceCache::GetMenuTexture(), sf::IntRect((MENU_BLANK % 16) * 8, (MENU_BLANK / 16) * 8, 8, 8));
+			overlay.Add(x * 8, y * 8, ResourceCache::GetFontTexture(), sf::IntRect((tile % 16) * 8, (tile / 16) * 8, 8, 8));
+		}
+	}
+}
+
+#ifdef PROFILE_ALLOCATIONS
+//Replacing the global allocation functions lets every new (including the ones inside std::string,
+//std::vector and SFML) be counted. Everything still goes through malloc/free.
+void* operator new(std::size_t size)
+{
+	Profiler::CountAllocation(size);
+	void* p = malloc(size ? size : 1);
+	if (!p)
+		throw std::bad_alloc();
+	return p;
+}
+
+void* operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	Profiler::CountAllocation(size);
+	return malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+	return operator new(size, std::nothrow);
+}
+
+void operator delete(void* p) noexcept
+{
+	free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+	free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+	free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+	free(p);
+}
+#endif
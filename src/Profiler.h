@@ -0,0 +1,125 @@
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <cstddef>
+#include <SFML/Graphics.hpp>
+#include <SFML/System.hpp>
+#include "SpriteBatch.h"
+
+#define PROFILER_AVERAGE_FRAMES 60 //the overlay shows averages over this many frames
+#define PROFILER_TRACE_FRAMES 3600 //traces stop by themselves after this many frames
+#define PROFILER_TRACE_FILE "trace.json" //open with chrome://tracing
+#define ALLOCATION_TAGS (ProfileSections::COUNT + 1) //allocations are tagged with the innermost section, or this for none
+
+namespace ProfileSections
+{
+	enum
+	{
+		SCENE_UPDATE,
+		SCRIPTS,
+		ENTITY_UPDATE,
+		MAP_RENDER,
+		ENTITY_RENDER,
+		TEXTBOX_RENDER,
+		AUDIO, //measured on the audio threads, use AddAudioTime
+		COUNT
+	};
+}
+
+//Times parts of each frame and counts what gets sent to the GPU. F3 shows the
+//numbers on screen, F4 starts and stops recording a Chrome trace.
+//Building with PROFILE_ALLOCATIONS also counts heap allocations (see the bottom of Profiler.cpp).
+class Profiler
+{
+public:
+	static void Initialize(); //call on the main thread before any other thread starts; allocations from the others count as audio
+	static void BeginFrame();
+	static void EndFrame();
+
+	//nested calls for the same section only count the outermost one. Begin returns the section that
+	//was active before, which has to be passed to End so allocations get tagged properly
+	static unsigned char Begin(unsigned char section);
+	static void End(unsigned char section, unsigned char previous);
+	static void AddAudioTime(sf::Int64 start, sf::Int64 duration); //safe to call from any thread
+	static sf::Int64 Now() { return clock.getElapsedTime().asMicroseconds(); }
+
+	static void CountDraw(const sf::Texture* texture);
+	static void CountSetPalette() { set_palette_calls++; }
+	static void CountAllocation(std::size_t size); //can't allocate, it gets called from operator new
+
+	static unsigned int GetFrameAllocations(); //allocations made during the last finished frame
+	static void PrintFrameAllocations(); //per section breakdown of the last finished frame
+
+	static void ToggleOverlay() { overlay_visible = !overlay_visible; }
+	static bool OverlayVisible() { return overlay_visible; }
+	static void DrawOverlay(sf::RenderTarget* target); //draws in screen (160x144) coordinates
+
+	static void StartTrace();
+	static void StopTrace(); //writes PROFILER_TRACE_FILE
+	static bool Tracing() { return tracing; }
+
+private:
+	struct TraceEvent
+	{
+		unsigned char section; //ProfileSections::COUNT for frame counters
+		sf::Int64 start;
+		sf::Int64 duration;
+		unsigned int draws;
+		unsigned int binds;
+		unsigned int set_palettes;
+		unsigned int allocations;
+	};
+
+	static sf::Clock clock;
+	static sf::Mutex mutex; //the audio threads add their times and trace events too
+
+	static sf::Int64 frame_start;
+	static sf::Int64 section_start[ProfileSections::COUNT];
+	static unsigned char section_depth[ProfileSections::COUNT];
+	static const sf::Texture* last_texture;
+	static unsigned int draw_calls;
+	static unsigned int texture_binds;
+	static unsigned int set_palette_calls;
+	static unsigned char current_section; //ProfileSections::COUNT outside of any section
+	static unsigned int allocations[ALLOCATION_TAGS];
+	static std::size_t allocated_bytes[ALLOCATION_TAGS];
+	static std::thread::id main_thread;
+	static std::atomic<unsigned int> thread_allocations; //allocations from the audio threads
+	static std::atomic<std::size_t> thread_allocated_bytes;
+	static unsigned int last_allocations[ALLOCATION_TAGS];
+	static std::size_t last_allocated_bytes[ALLOCATION_TAGS];
+
+	//totals for the overlay, averaged every PROFILER_AVERAGE_FRAMES
+	static sf::Int64 frame_total;
+	static sf::Int64 section_total[ProfileSections::COUNT];
+	static unsigned int draw_total;
+	static unsigned int bind_total;
+	static unsigned int set_palette_total;
+	static unsigned int allocation_total;
+	static std::size_t allocated_bytes_total;
+	static unsigned int averaged_frames;
+
+	static bool overlay_visible;
+	static SpriteBatch overlay;
+
+	static bool tracing;
+	static unsigned int trace_frames;
+	static std::vector<TraceEvent> trace;
+
+	static void AddTraceEvent(unsigned char section, sf::Int64 start, sf::Int64 duration); //lock mutex first
+	static void BuildOverlay();
+};
+
+//times the enclosing block as a ProfileSections section
+class ProfileScope
+{
+public:
+	ProfileScope(unsigned char section) : section(section) { previous = Profiler::Begin(section); }
+	~ProfileScope() { Profiler::End(section, previous); }
+
+private:
+	unsigned char section;
+	unsigned char previous;
+};
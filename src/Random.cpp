@@ -0,0 +1,12 @@
+#include "Random.h"
+
+unsigned long long Random::seed = 0;
+RandomStream Random::streams[RandomStreams::COUNT];
+
+void Random::Seed(unsigned long long seed)
+{
+	Random::seed = seed;
+	//same seed, different stream numbers, so the streams never overlap
+	for (unsigned char i = 0; i < RandomStreams::COUNT; i++)
+		streams[i].Seed(seed, i);
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+//A small seedable random number generator (PCG32, see pcg-random.org). Unlike rand(), each RandomStream has
+//its own state, so something seeded the same way always rolls the same numbers no matter what else is rolling.
+//Streams with the same seed but a different stream number don't overlap.
+class RandomStream
+{
+public:
+	RandomStream(unsigned long long seed = 0, unsigned long long stream = 0) { Seed(seed, stream); }
+
+	void Seed(unsigned long long seed, unsigned long long stream = 0)
+	{
+		state = 0;
+		increment = (stream << 1) | 1;
+		Next();
+		state += seed;
+		Next();
+	}
+
+	unsigned int Next()
+	{
+		unsigned long long old = state;
+		state = old * 6364136223846793005ULL + increment;
+		unsigned int shifted = (unsigned int)(((old >> 18) ^ old) >> 27);
+		unsigned int rotation = (unsigned int)(old >> 59);
+		return (shifted >> rotation) | (shifted << ((32 - rotation) & 31));
+	}
+
+	unsigned char NextByte() { return (unsigned char)(Next() >> 24); } //the high bits are the best mixed
+	unsigned int Range(unsigned int n) { return (unsigned int)(((unsigned long long)Next() * n) >> 32); } //0 to n-1, like rand() % n without favouring low numbers as much
+
+	//a new stream that won't overlap this one, eg. for a battle or a thread that needs its own numbers
+	RandomStream Split()
+	{
+		unsigned long long seed = ((unsigned long long)Next() << 32) | Next();
+		return RandomStream(seed, Next());
+	}
+
+	//fills out with count random bytes, four per call to Next
+	void Fill(unsigned char* out, unsigned int count)
+	{
+		unsigned int i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			unsigned int r = Next();
+			out[i] = (unsigned char)r;
+			out[i + 1] = (unsigned char)(r >> 8);
+			out[i + 2] = (unsigned char)(r >> 16);
+			out[i + 3] = (unsigned char)(r >> 24);
+		}
+		for (; i < count; i++)
+			out[i] = NextByte();
+	}
+
+	void Fill(unsigned int* out, unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; i++)
+			out[i] = Next();
+	}
+
+private:
+	unsigned long long state;
+	unsigned long long increment;
+};
+
+namespace RandomStreams
+{
+	enum
+	{
+		POKEMON, //trainer ids and DVs of new pokemon
+		PARTY, //the test party
+		ENCOUNTERS, //wild pokemon
+		NPCS, //random walking
+		BATTLES, //each battle gets a stream split from this one
+		COUNT
+	};
+}
+
+//The game's random numbers. Each part of the game rolls from its own stream, so eg. NPCs walking around don't
+//change which wild pokemon show up, and seeding once makes everything replayable. The streams aren't locked, so
+//they're only for the game's thread; anything running on other threads (like the battle simulator's) should
+//Split its own RandomStream off first.
+class Random
+{
+public:
+	static void Seed(unsigned long long seed);
+	static unsigned long long GetSeed() { return seed; }
+
+	static RandomStream& GetStream(unsigned char stream) { return streams[stream]; }
+	static unsigned int Next(unsigned char stream) { return streams[stream].Next(); }
+	static unsigned int Range(unsigned char stream, unsigned int n) { return streams[stream].Range(n); }
+	static RandomStream Split(unsigned char stream) { return streams[stream].Split(); }
+	static void Fill(unsigned char stream, unsigned char* out, unsigned int count) { streams[stream].Fill(out, count); }
+
+private:
+	static unsigned long long seed;
+	static RandomStream streams[RandomStreams::COUNT];
+};
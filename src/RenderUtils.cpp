@@ -1,6 +1,27 @@
 #include "RenderUtils.h"
+#include "ResourceCache.h"
 
-void RenderHPBar(sf::RenderWindow* window, unsigned int hp, unsigned int max_hp, int x, int y)
+void RenderHPBar(TileCompositor* compositor, unsigned int pixels, int x, int y)
 {
-
+	PaletteTexture* texture;
+	if (pixels < 10)
+		texture = ResourceCache::GetStatusesTexture(2);
+	else if (pixels < 27)
+		texture = ResourceCache::GetStatusesTexture(1);
+	else
+		texture = ResourceCache::GetStatusesTexture(0);
+	for (int h = 0; h < 6; h++)
+	{
+		unsigned char c = 0x9; //full
+		if (pixels == 0)
+			c = 1;
+		else if (pixels < 8)
+		{
+			c = pixels + 1;
+			pixels = 0;
+		}
+		else
+			pixels -= 8;
+		compositor->SetTile(x + h, y, texture, c);
+	}
 }
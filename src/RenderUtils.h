@@ -1,5 +1,7 @@
 #pragma once
 
 #include <SFML/Graphics.hpp>
+#include "TileCompositor.h"
 
-void RenderHPBar(sf::RenderWindow* window, unsigned int hp, unsigned int max_hp, int x, int y);
\ No newline at end of file
+//writes a 6 tile hp bar filled with (pixels) out of 48 into the compositor's background at tile x, y
+void RenderHPBar(TileCompositor* compositor, unsigned int pixels, int x, int y);
\ No newline at end of file
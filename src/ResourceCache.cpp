@@ -1,4 +1,5 @@
 #include "ResourceCache.h"
+#include "Random.h"
 
 Tileset* ResourceCache::tilesets[24];
 PaletteTexture* ResourceCache::entity_textures[73];
@@ -14,25 +15,17 @@ PaletteTexture* ResourceCache::shadow_texture = 0;
 
 PaletteTexture* ResourceCache::menu_texture = 0;
 PaletteTexture* ResourceCache::font_texture = 0;
-DataBlock* ResourceCache::ascii_table = 0;
 
 string ResourceCache::item_names[256];
 bool ResourceCache::key_items[256];
 unsigned char ResourceCache::item_uses[256];
 
-DataBlock* ResourceCache::pokemon_stats[256];
-DataBlock* ResourceCache::pokemon_indexes = 0;
-string ResourceCache::pokemon_names[256];
 PaletteTexture* ResourceCache::statuses_texture[4];
 PaletteTexture* ResourceCache::pokemon_icons = 0;
 DataBlock* ResourceCache::icon_indexes = 0;
 PaletteTexture* ResourceCache::pokemon_front[256];
 PaletteTexture* ResourceCache::pokemon_back[256];
 DataBlock* ResourceCache::mon_palette_indexes = 0;
-DataBlock* ResourceCache::pokemon_leveling[256];
-
-string ResourceCache::move_names[256];
-DataBlock* ResourceCache::move_data = 0;
 
 FlyPoint ResourceCache::fly_points[13];
 DataBlock* ResourceCache::escape_rope_tilesets = 0;
@@ -42,6 +35,7 @@ unsigned char ResourceCache::music_indexes[256];
 unsigned char ResourceCache::trainer_music[256];
 
 Transition ResourceCache::transitions[8];
+sf::VertexArray ResourceCache::transition_quads[8];
 unsigned char ResourceCache::wild_chances[10];
 
 PaletteTexture* ResourceCache::trainer_front[256];
@@ -88,16 +82,7 @@ void ResourceCache::ReleaseResources()
 		delete menu_texture;
 	if (font_texture)
 		delete font_texture;
-	if (ascii_table)
-		delete ascii_table;
 
-	for (int i = 0; i < 256; i++)
-	{
-		if (pokemon_stats[i])
-			delete pokemon_stats[i];
-	}
-	if (pokemon_indexes)
-		delete pokemon_indexes;
 	for (int i = 0; i < 4; i++)
 	{
 		if (statuses_texture[i])
@@ -115,13 +100,9 @@ void ResourceCache::ReleaseResources()
 			delete pokemon_front[i];
 		if (pokemon_back[i])
 			delete pokemon_back[i];
-		if (pokemon_leveling[i])
-			delete pokemon_leveling[i];
 		item_names[i].clear();
 	}
 
-	if (move_data)
-		delete move_data;
 	if (escape_rope_tilesets)
 		delete escape_rope_tilesets;
 	if (bicycle_tilesets)
@@ -136,23 +117,25 @@ void ResourceCache::ReleaseResources()
 		delete red_back;
 	if (man_back)
 		delete man_back;
+
+	GameData::Release();
 }
 
 void ResourceCache::LoadAll()
 {
-	srand((unsigned int)time(0));
+	Random::Seed((unsigned long long)time(0));
 
 #ifdef _DEBUG
 	cout << "Loading resources...\n";
 #endif
 
+	GameData::LoadAll(RESOURCE_DIR);
 	LoadTilesets();
 	LoadEntities();
 	LoadPalettes();
 	LoadMisc();
 	LoadItems();
 	LoadPokemon();
-	LoadMoves();
 	LoadBattleData();
 	//LoadTilesets();
 	LoadTrainers();
@@ -231,7 +214,6 @@ void ResourceCache::LoadMisc()
 	menu_texture->loadFromFile(ResourceCache::GetResourceLocation(string("misc/menu.png")));
 	font_texture = new PaletteTexture();
 	font_texture->loadFromFile(ResourceCache::GetResourceLocation(string("misc/font.png")));
-	ascii_table = ReadFile(ResourceCache::GetResourceLocation(string("misc/ascii_table.dat")).c_str());
 	escape_rope_tilesets = ReadFile(ResourceCache::GetResourceLocation(string("misc/escaperope.dat")).c_str());
 	bicycle_tilesets = ReadFile(ResourceCache::GetResourceLocation(string("misc/bicycle.dat")).c_str());
 
@@ -285,32 +267,8 @@ void ResourceCache::LoadItems()
 void ResourceCache::LoadPokemon()
 {
 #ifdef _DEBUG
-	cout << "--Loading Pokemon...";
+	cout << "--Loading Pokemon sprites...";
 #endif
-	for (int i = 0; i < 256; i++)
-	{
-		DataBlock* d = ReadFile(ResourceCache::GetResourceLocation(string("pokemon/stats/").append(itos(i)).append(".dat")));
-		if (d)
-			pokemon_stats[i] = d;
-	}
-
-	pokemon_indexes = ReadFile(ResourceCache::GetResourceLocation(string("pokemon/dex_indexes.dat")).c_str());
-
-	DataBlock* d = ReadFile(ResourceCache::GetResourceLocation(string("pokemon/names.dat")).c_str());
-	unsigned char* p = d->data;
-	for (int i = 0; i < 256; i++)
-	{
-		string s;
-		while ((unsigned int)(p - d->data_start) < d->size && *p != MESSAGE_ENDNAME)
-			s.insert(s.begin() + s.length(), (char)*p++);
-		p++;
-		pokemon_names[i] = s;
-		//these pokemon names get reported as a memory leak
-		//however since theyre static not manually allocated, they will be deleted when the program terminates
-		//the leak reportings are false
-	}
-	delete d;
-
 	for (int i = 0; i < 4; i++)
 	{
 		statuses_texture[i] = new PaletteTexture();
@@ -331,8 +289,6 @@ void ResourceCache::LoadPokemon()
 
 		pokemon_front[i]->SetPalette(GetPalette(mon_palette_indexes->data[i]));
 		pokemon_back[i]->SetPalette(GetPalette(mon_palette_indexes->data[i]));
-
-		pokemon_leveling[i] = ReadFile(ResourceCache::GetResourceLocation(string("pokemon/leveling/").append(itos(i)).append(".dat")));
 	}
 
 #ifdef _DEBUG
@@ -340,33 +296,6 @@ void ResourceCache::LoadPokemon()
 #endif
 }
 
-void ResourceCache::LoadMoves()
-{
-#ifdef _DEBUG
-	cout << "--Loading moves...";
-#endif
-	DataBlock* d = ReadFile(ResourceCache::GetResourceLocation(string("moves/names.dat")).c_str());
-	unsigned char* p = d->data;
-	for (int i = 0; i < 256; i++)
-	{
-		string s;
-		while ((unsigned int)(p - d->data_start) < d->size && *p != MESSAGE_ENDNAME)
-			s.insert(s.begin() + s.length(), (char)*p++);
-		p++;
-		move_names[i] = s;
-		//these move names get reported as a memory leak
-		//however since theyre static not manually allocated, they will be deleted when the program terminates
-		//the leak reportings are false
-	}
-	delete d;
-
-	move_data = ReadFile(ResourceCache::GetResourceLocation(string("moves/moves.dat")).c_str());
-
-#ifdef _DEBUG
-	cout << "Done\n";
-#endif
-}
-
 void ResourceCache::LoadBattleData()
 {
 #ifdef _DEBUG
@@ -393,6 +322,26 @@ void ResourceCache::LoadBattleData()
 			transitions[i].tiles[n][count] = 0xFFFF;
 		}
 		delete d;
+
+		//precompute the quads. steps only ever add tiles, so drawing a prefix of the quads covers every finished step.
+		sf::VertexArray& quads = transition_quads[i];
+		quads.setPrimitiveType(sf::Quads);
+		quads.clear();
+		for (int n = 0; n < transitions[i].n_steps; n++)
+		{
+			for (int s = 0; s < 64 && transitions[i].tiles[n][s] != 0xFFFF; s++)
+			{
+				unsigned short u = transitions[i].tiles[n][s];
+				float x = (float)((u & 0xFF) * 8);
+				float y = (float)(((u >> 8) & 0xFF) * 8);
+				//the black tile in the font texture
+				quads.append(sf::Vertex(sf::Vector2f(x, y), sf::Vector2f(120, 32)));
+				quads.append(sf::Vertex(sf::Vector2f(x + 8, y), sf::Vector2f(128, 32)));
+				quads.append(sf::Vertex(sf::Vector2f(x + 8, y + 8), sf::Vector2f(128, 40)));
+				quads.append(sf::Vertex(sf::Vector2f(x, y + 8), sf::Vector2f(120, 40)));
+			}
+			transitions[i].covered[n] = (unsigned short)(quads.getVertexCount() / 4);
+		}
 	}
 
 	d = ReadFile(ResourceCache::GetResourceLocation(string("trainers/music.dat")).c_str());
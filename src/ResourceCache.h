@@ -8,6 +8,7 @@
 #include "PaletteTexture.h"
 #include "Utils.h"
 #include "Events.h"
+#include "GameData.h"
 
 #ifdef _DEBUG
 #include <iostream>
@@ -35,7 +36,6 @@ public:
 	static void LoadMisc();
 	static void LoadItems();
 	static void LoadPokemon();
-	static void LoadMoves();
 	static void LoadBattleData();
 	static void LoadTrainers();
 
@@ -83,24 +83,16 @@ public:
 
 	inline static PaletteTexture* GetMenuTexture() { return menu_texture; }
 	inline static PaletteTexture* GetFontTexture() { return font_texture; }
-	inline static DataBlock* GetAsciiTable() { return ascii_table; }
 	inline static string& GetItemName(unsigned char index) { return item_names[index]; }
 	inline static bool IsKeyItem(unsigned char index) { return key_items[index]; }
 	inline static unsigned char GetItemUse(unsigned char index) { return item_uses[index]; }
 
-	inline static DataBlock* GetPokemonStats(unsigned char index) { return pokemon_stats[index]; }
-	inline static unsigned char GetPokedexIndex(unsigned char created_index) { if (pokemon_indexes) return pokemon_indexes->data[created_index]; return 0; }
-	inline static string& GetPokemonName(unsigned char created_index) { return pokemon_names[created_index]; }
 	inline static PaletteTexture* GetStatusesTexture(unsigned char color) { return statuses_texture[color % 4]; }
 	inline static PaletteTexture* GetPokemonIcons() { return pokemon_icons; }
 	inline static unsigned char GetIconIndex(unsigned char pokedex_index) { if (icon_indexes) return icon_indexes->data[pokedex_index]; return 0; }
 	inline static unsigned char GetPokemonPaletteIndex(unsigned char index) { if (mon_palette_indexes) return mon_palette_indexes->data[index]; return 0; }
 	inline static PaletteTexture* GetPokemonFront(unsigned char index) { return pokemon_front[index]; }
 	inline static PaletteTexture* GetPokemonBack(unsigned char index) { return pokemon_back[index]; }
-	inline static DataBlock* GetPokemonLeveling(unsigned char index) { return pokemon_leveling[index]; }
-
-	inline static string& GetMoveName(unsigned char index) { return move_names[index]; }
-	inline static DataBlock* GetMoveData() { return move_data; }
 
 	inline static FlyPoint& GetFlyPoint(unsigned char index) { if (index > 12) index = 0; return fly_points[index]; }
 	inline static bool CanUseEscapeRope(unsigned char tileset) { for (unsigned int i = 0; i < escape_rope_tilesets->size; i++) if (escape_rope_tilesets->data[i] == tileset) return true; return false; }
@@ -110,6 +102,7 @@ public:
 
 	inline static unsigned char* GetWildChances() { return wild_chances; }
 	inline static Transition& GetBattleTransition(unsigned char index) { return transitions[index]; }
+	inline static sf::VertexArray& GetBattleTransitionQuads(unsigned char index) { return transition_quads[index]; }
 	inline static unsigned char GetTrainerMusic(unsigned char index) { return trainer_music[index]; }
 
 	inline static PaletteTexture* GetTrainerFront(unsigned char index) { return trainer_front[index]; }
@@ -136,7 +129,6 @@ private:
 	//textbox
 	static PaletteTexture* menu_texture;
 	static PaletteTexture* font_texture;
-	static DataBlock* ascii_table;
 
 	//items
 	static string item_names[256];
@@ -144,20 +136,12 @@ private:
 	static unsigned char item_uses[256];
 
 	//pokemon stuff
-	static DataBlock* pokemon_stats[256];
-	static DataBlock* pokemon_indexes;
-	static string pokemon_names[256];
 	static PaletteTexture* statuses_texture[4]; //3 for each hp bar color, 1 for the pokeballs
 	static PaletteTexture* pokemon_icons;
 	static DataBlock* icon_indexes;
 	static PaletteTexture* pokemon_front[256];
 	static PaletteTexture* pokemon_back[256];
 	static DataBlock* mon_palette_indexes;
-	static DataBlock* pokemon_leveling[256];
-
-	//move stuff
-	static string move_names[256];
-	static DataBlock* move_data;
 
 	//misc
 	static FlyPoint fly_points[13];
@@ -169,6 +153,7 @@ private:
 	//battle
 	static unsigned char wild_chances[10];
 	static Transition transitions[8];
+	static sf::VertexArray transition_quads[8]; //every step's tiles in order, so the first covered[step] quads draw the transition up to that step
 
 	//trainer
 	static PaletteTexture* trainer_front[256];
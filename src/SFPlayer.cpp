@@ -1,6 +1,8 @@
 #pragma once
 
 #include "SFPlayer.h"
+#include "Utils.h"
+#include "Profiler.h"
 #include "gme/blargg_source.h"
 
 
@@ -10,6 +12,7 @@ SFPlayer::SFPlayer()
 	emulator = 0;
 	current_track = 0;
 	switch_track = false;
+	saved_track = 0;
 }
 
 SFPlayer::~SFPlayer()
@@ -25,7 +28,13 @@ blargg_err_t SFPlayer::Initialize(const char* filename, bool allow_overlapping,
 	sample_rate = 44100;
 	overlapping = allow_overlapping;
 
-	RETURN_ERR(gme_open_file(filename, &emulator, sample_rate));
+	//read the whole file through the resource loader; the emulator keeps its own rom copy
+	DataBlock* data = ReadFile(filename);
+	if (!data)
+		return "Couldn't open file";
+	blargg_err_t err = gme_open_data(data->data, data->size, &emulator, sample_rate);
+	delete data;
+	RETURN_ERR(err);
 
 	sf::SoundStream::stop();
 	int min_size = sample_rate * 2 / FILL_RATE;
@@ -81,6 +90,40 @@ blargg_err_t SFPlayer::Play(int track, bool fadeout)
 	return 0;
 }
 
+//remembers exactly where the current track is so ResumeTrack can continue it later
+blargg_err_t SFPlayer::SaveTrack()
+{
+	saved_track = 0;
+	if (!emulator || current_track == 0 || switch_track)
+		return 0;
+
+	//the stream keeps playing, just make sure it isn't in the middle of generating samples
+	sf::Lock lock(emulator_mutex);
+	RETURN_ERR(emulator->save_state(&saved_state));
+	saved_track = current_track;
+	return 0;
+}
+
+blargg_err_t SFPlayer::ResumeTrack()
+{
+	if (!emulator || saved_track == 0)
+		return 0;
+	int track = saved_track;
+	saved_track = 0;
+
+	//nothing else was played in the meantime so the track just kept going
+	if (current_track == track && !switch_track)
+		return 0;
+
+	// Sound must not be running when operating on emulator
+	sf::SoundStream::stop();
+	RETURN_ERR(emulator->load_state(saved_state));
+	current_track = track;
+	switch_track = false;
+	play();
+	return 0;
+}
+
 void SFPlayer::Queue(int track, int delay)
 {
 	queues.push_back(((track & 0xFF) << 16) | (delay & 0xFFFF));
@@ -126,9 +169,12 @@ bool SFPlayer::onGetData(Chunk& data)
 {
 	if (emulator)
 	{
+		sf::Lock lock(emulator_mutex);
+		sf::Int64 start = Profiler::Now();
 		data.sampleCount = buffer_size;
 		emulator->play(buffer_size, (short*)samples);
 		data.samples = samples;
+		Profiler::AddAudioTime(start, Profiler::Now() - start);
 		return true;
 	}
 
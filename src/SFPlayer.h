@@ -16,6 +16,8 @@ public:
 
 	blargg_err_t Play(int track, bool fadeout = false);
 	void Queue(int track, int delay);
+	blargg_err_t SaveTrack();
+	blargg_err_t ResumeTrack();
 	void SetVolume(float value) { setVolume(value); }
 	void Update();
 	void Close();
@@ -37,8 +39,12 @@ private:
 	bool overlapping;
 
 	Music_Emu* emulator;
+	sf::Mutex emulator_mutex;
 	track_info_t track_info;
 	sf::Int16* samples;
 
 	std::vector<unsigned int> queues;
+
+	int saved_track;
+	Music_Emu::state_t saved_state;
 };
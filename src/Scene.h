@@ -13,8 +13,9 @@ public:
 	virtual ~Scene() = 0;
 
 	virtual void Update() = 0;
-	virtual void Render(sf::RenderWindow* window) = 0;
+	virtual void Render(sf::RenderTarget* window) = 0;
 	virtual void NotifySwitchedTo();
+	virtual bool NeedsRedraw() { return true; } //return false if the last rendered frame can be shown again
 
 protected:
 	Fade current_fade;
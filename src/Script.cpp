@@ -1,6 +1,7 @@
 #include "Script.h"
 #include "MapScene.h"
 #include "Opcodes.h"
+#include "Profiler.h"
 
 Script::Script(MapScene* on_scene)
 {
@@ -30,7 +31,7 @@ Script::~Script()
 	if (buffer)
 		delete buffer;
 	if (built_menu)
-		delete built_menu;
+		Textbox::Release(built_menu);
 }
 
 Script* Script::TryLoad(MapScene* on_scene, unsigned char map, unsigned char script_index)
@@ -86,6 +87,7 @@ void Script::Reset()
 
 void Script::Update()
 {
+	ProfileScope profile(ProfileSections::SCRIPTS);
 	//we have a while loop here to execute as many commands as possible
 	//it's necessary if, for example, we have a lot of logic that goes on before showing
 	//a textbox. the textbox would be severely delayed
@@ -185,8 +187,8 @@ void Script::Update()
 		case OPCODE_TEXT: //text
 			if (on_scene)
 			{
-				Textbox* t = new Textbox();
-				t->SetText(new TextItem(t, nullptr, pokestring(GetVariable().string_value.c_str())));
+				Textbox* t = Textbox::Create();
+				t->SetText(TextItem::Create(t, nullptr, pokestring(GetVariable().string_value.c_str())));
 				on_scene->ShowTextbox(t);
 			}
 			break;
@@ -274,7 +276,7 @@ void Script::Update()
 			s = pokestring(GetVariable().string_value.c_str());
 			if (s.length() != 0)
 			{
-				built_menu->GetItems().push_back(new TextItem(built_menu, [this](TextItem* i) { this->SetMenuResult(i->index + 1); this->GetBuiltMenu()->Close(); this->ClearBuiltMenu(); }, s, built_menu->GetItems().size()));
+				built_menu->GetItems().push_back(TextItem::Create(built_menu, [this](TextItem* i) { this->SetMenuResult(i->index + 1); this->GetBuiltMenu()->Close(); this->ClearBuiltMenu(); }, s, built_menu->GetItems().size()));
 			}
 			break;
 
@@ -294,7 +296,7 @@ void Script::Update()
 			d = GetVariable().int_value;
 			if (!built_menu)
 			{
-				built_menu = new Textbox(a, b, c, d);
+				built_menu = Textbox::Create(a, b, c, d);
 			}
 			built_menu->SetMenu(true, 16, sf::Vector2i(1, 1), sf::Vector2u(0, 2), [this](TextItem* i) { if (i)this->SetMenuResult(i->index + 1); this->ClearBuiltMenu(); }, MenuFlags::FOCUSABLE | MenuFlags::WRAPS);
 			built_menu->SetArrowState(ArrowStates::ACTIVE);
@@ -335,8 +337,8 @@ void Script::Update()
 				};
 				s = pokestring(GetVariable().string_value.c_str());
 				menu_variable = buffer->getc() + (buffer->getc() << 8);
-				Textbox* t = new Textbox();
-				t->SetText(new TextItem(t, showmenu, s));
+				Textbox* t = Textbox::Create();
+				t->SetText(TextItem::Create(t, showmenu, s));
 				on_scene->ShowTextbox(t);
 			}
 			break;
@@ -471,8 +473,8 @@ void Script::Update()
 		case OPCODE_TEXTRAW: //text raw
 			if (on_scene)
 			{
-				Textbox* t = new Textbox();
-				t->SetText(new TextItem(t, nullptr, fixdump(GetVariable().string_value)));
+				Textbox* t = Textbox::Create();
+				t->SetText(TextItem::Create(t, nullptr, fixdump(GetVariable().string_value)));
 				on_scene->ShowTextbox(t);
 			}
 			break;
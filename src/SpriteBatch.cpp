@@ -0,0 +1,102 @@
+#include "SpriteBatch.h"
+#include "Profiler.h"
+#include <algorithm>
+
+SpriteBatch::SpriteBatch()
+{
+	batch_count = 0;
+	draw_count = 0;
+}
+
+SpriteBatch::~SpriteBatch()
+{
+}
+
+void SpriteBatch::Add(int x, int y, PaletteTexture* texture, sf::IntRect src, unsigned char flags)
+{
+	if (!texture)
+		return;
+	float px = (float)x;
+	float py = (float)y;
+	float w = (float)src.width;
+	float h = (float)src.height;
+	sf::VertexArray& quads = GetBatch(texture, sf::FloatRect(px, py, w, h));
+
+	float left = (float)src.left;
+	float right = (float)(src.left + src.width);
+	float top = (float)src.top;
+	float bottom = (float)(src.top + src.height);
+	if (flags & TileFlags::FLIP_X)
+		std::swap(left, right);
+	if (flags & TileFlags::FLIP_Y)
+		std::swap(top, bottom);
+
+	quads.append(sf::Vertex(sf::Vector2f(px, py), sf::Vector2f(left, top)));
+	quads.append(sf::Vertex(sf::Vector2f(px + w, py), sf::Vector2f(right, top)));
+	quads.append(sf::Vertex(sf::Vector2f(px + w, py + h), sf::Vector2f(right, bottom)));
+	quads.append(sf::Vertex(sf::Vector2f(px, py + h), sf::Vector2f(left, bottom)));
+}
+
+void SpriteBatch::Draw(sf::RenderTarget* target)
+{
+	draw_count = 0;
+	for (unsigned int i = 0; i < batch_count; i++)
+	{
+		if (batches[i].quads.getVertexCount() == 0)
+			continue;
+		target->draw(batches[i].quads, batches[i].texture->GetTexture());
+		Profiler::CountDraw(batches[i].texture->GetTexture());
+		draw_count++;
+	}
+}
+
+void SpriteBatch::Clear()
+{
+	for (unsigned int i = 0; i < batch_count; i++)
+		batches[i].quads.clear();
+	batch_count = 0;
+}
+
+unsigned int SpriteBatch::GetQuadCount()
+{
+	unsigned int count = 0;
+	for (unsigned int i = 0; i < batch_count; i++)
+		count += batches[i].quads.getVertexCount() / 4;
+	return count;
+}
+
+sf::VertexArray& SpriteBatch::GetBatch(PaletteTexture* texture, const sf::FloatRect& area)
+{
+	//look back for a batch with this texture, but stop at anything that has to stay on top of the new quad.
+	//only a handful of batches are used at a time, so a linear search is fine
+	for (int i = (int)batch_count - 1; i >= 0; i--)
+	{
+		if (batches[i].texture == texture)
+			return batches[i].quads;
+		if (Overlaps(batches[i].quads, area))
+			break;
+	}
+
+	//reuse a batch left over from an earlier frame when there is one
+	if (batch_count == batches.size())
+	{
+		Batch b;
+		b.quads.setPrimitiveType(sf::Quads);
+		batches.push_back(b);
+	}
+	batches[batch_count].texture = texture;
+	return batches[batch_count++].quads;
+}
+
+bool SpriteBatch::Overlaps(const sf::VertexArray& quads, const sf::FloatRect& area)
+{
+	//quads sharing only an edge don't overlap. the first and third corners of each quad are its top left and bottom right
+	for (unsigned int i = 0; i < quads.getVertexCount(); i += 4)
+	{
+		const sf::Vector2f& top_left = quads[i].position;
+		const sf::Vector2f& bottom_right = quads[i + 2].position;
+		if (top_left.x < area.left + area.width && bottom_right.x > area.left && top_left.y < area.top + area.height && bottom_right.y > area.top)
+			return true;
+	}
+	return false;
+}
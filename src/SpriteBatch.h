@@ -0,0 +1,49 @@
+#pragma once
+
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include "PaletteTexture.h"
+
+namespace TileFlags
+{
+	enum
+	{
+		NONE = 0,
+		FLIP_X = 1,
+		FLIP_Y = 2,
+	};
+}
+
+//Collects textured quads and draws them with one draw call per texture where it can.
+//The result always looks as if the quads were drawn in the order they were added: a quad
+//joins the last batch with its texture unless a batch after that one overlaps it, in which
+//case it starts a new batch. The batch order is rebuilt each frame, after Clear.
+class SpriteBatch
+{
+public:
+	SpriteBatch();
+	~SpriteBatch();
+
+	void Add(int x, int y, PaletteTexture* texture, sf::IntRect src, unsigned char flags = TileFlags::NONE);
+	void Draw(sf::RenderTarget* target);
+	void Clear(); //removes the quads and batches, but keeps the batches' memory around for the next frame
+
+	unsigned int GetDrawCount() { return draw_count; } //draw calls made by the last Draw
+	unsigned int GetQuadCount();
+	unsigned int GetBatchCount() { return batch_count; }
+	PaletteTexture* GetBatchTexture(unsigned int batch) { return batches[batch].texture; } //in the order Draw draws them
+
+private:
+	struct Batch
+	{
+		PaletteTexture* texture;
+		sf::VertexArray quads;
+	};
+
+	std::vector<Batch> batches; //only the first batch_count are used this frame
+	unsigned int batch_count;
+	unsigned int draw_count;
+
+	sf::VertexArray& GetBatch(PaletteTexture* texture, const sf::FloatRect& area);
+	static bool Overlaps(const sf::VertexArray& quads, const sf::FloatRect& area);
+};
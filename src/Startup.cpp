@@ -28,7 +28,7 @@ int main()
 	_crtBreakAlloc = 22853;
 	Engine::Initialize();
 
-	sf::RenderWindow window(sf::VideoMode(VIEWPORT_WIDTH * 16, VIEWPORT_HEIGHT * 16), "SFML works!");
+	sf::RenderWindow window(sf::VideoMode(VIEWPORT_WIDTH * 16 * WINDOW_SCALE, VIEWPORT_HEIGHT * 16 * WINDOW_SCALE), "SFML works!");
 
 	window.setFramerateLimit(60);
 
@@ -40,6 +40,8 @@ int main()
 		{
 			if (event.type == sf::Event::Closed)
 				window.close();
+			else if (event.type == sf::Event::Resized) //keep the view 1:1 with the window, Engine does the scaling
+				window.setView(sf::View(sf::FloatRect(0, 0, (float)event.size.width, (float)event.size.height)));
 		}
 
 		window.clear();
@@ -52,6 +54,8 @@ int main()
 	MenuCache::ReleaseResources();
 	ResourceCache::ReleaseResources();
 	Engine::Release();
+	Textbox::FreePool();
+	TextItem::FreePool();
 
 #ifdef _WIN32
 #ifdef _DEBUG
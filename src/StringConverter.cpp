@@ -1,4 +1,5 @@
 #include "StringConverter.h"
+#include "Constants.h"
 
 /*
 TABLE OF ASCII POKESTRING EQUIVALENTS
@@ -26,7 +27,7 @@ string& pokestring(std::string& src)
 	for (unsigned int i = 0; i < src.length(); i++)
 	{
 		unsigned char c = src[i];
-		src[i] = ResourceCache::GetAsciiTable()->data[c];
+		src[i] = GameData::GetAsciiTable()->data[c];
 
 		//TODO: Replace with constants; make not really ugly
 		switch (c)
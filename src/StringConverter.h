@@ -1,7 +1,7 @@
 #pragma once
 
 #include <string>
-#include "ResourceCache.h"
+#include "GameData.h"
 
 string& pokestring(std::string& src);
 string pokestring(const char* c);
@@ -1,29 +1,55 @@
 #pragma once
 
 #include <functional>
+#include <vector>
 #include "Common.h"
 #include "Textbox.h"
 #include "StringConverter.h"
 
+#ifdef _DEBUG
+#include <iostream>
+#endif
+
+//Pooled like Textbox: use Create and Release instead of new and delete. A reused item keeps its
+//string's memory, so a message no longer than one shown before doesn't allocate.
 class TextItem
 {
 public:
-	TextItem(Textbox* owner, std::function<void(TextItem* source)> action_callback = nullptr, string text = 0, unsigned char index = 0, unsigned int value = 0)
+	static TextItem* Create(Textbox* owner, std::function<void(TextItem* source)> action_callback = nullptr, const string& text = string(), unsigned char index = 0, unsigned int value = 0)
 	{
-		this->owner_textbox = owner;
-		//for this stupid block of code, see Textbox.cpp
-		if(action_callback)
-			this->callback = action_callback;
-		else
-			this->callback = nullptr;
-		this->text = text;
-		this->index = index;
-		this->value = value;
-		//pokestring(this->text);
+		std::vector<TextItem*>& pool = Pool();
+		if (pool.size() == 0)
+			return new TextItem(owner, action_callback, text, index, value);
+		TextItem* item = pool.back();
+		pool.pop_back();
+		item->in_pool = false;
+		item->Initialize(owner, action_callback, text, index, value);
+		return item;
 	}
 
-	~TextItem()
+	static void Release(TextItem* item)
 	{
+		if (!item)
+			return;
+		if (item->in_pool)
+		{
+#ifdef _DEBUG
+			std::cout << "TextItem released twice\n";
+#endif
+			return;
+		}
+		item->in_pool = true;
+		item->callback = nullptr; //let go of whatever the callback captured
+		item->owner_textbox = 0;
+		Pool().push_back(item);
+	}
+
+	static void FreePool()
+	{
+		std::vector<TextItem*>& pool = Pool();
+		for (unsigned int i = 0; i < pool.size(); i++)
+			delete pool[i];
+		pool.clear();
 	}
 
 	void Action()
@@ -54,6 +80,33 @@ public:
 	unsigned int value; //the value on the item (used for items)
 
 private:
+	TextItem(Textbox* owner, std::function<void(TextItem* source)> action_callback, const string& text, unsigned char index, unsigned int value)
+	{
+		in_pool = false;
+		Initialize(owner, action_callback, text, index, value);
+	}
+
+	~TextItem()
+	{
+	}
+
+	void Initialize(Textbox* owner, std::function<void(TextItem* source)> action_callback, const string& text, unsigned char index, unsigned int value)
+	{
+		this->owner_textbox = owner;
+		//for this stupid block of code, see Textbox.cpp
+		if(action_callback)
+			this->callback = action_callback;
+		else
+			this->callback = nullptr;
+		this->text = text;
+		this->index = index;
+		this->value = value;
+		//pokestring(this->text);
+	}
+
+	static std::vector<TextItem*>& Pool() { static std::vector<TextItem*> pool; return pool; }
+
+	bool in_pool; //so releasing an item twice can be caught
 	Textbox* owner_textbox;
 	std::function<void(TextItem* source)> callback; //the function that gets called when the item is selected
 };
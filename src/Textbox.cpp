@@ -1,8 +1,75 @@
 #include "Textbox.h"
 
-Textbox::Textbox(char x, char y, unsigned char width, unsigned char height, bool d, bool hidden_frame)
+std::vector<Textbox*> Textbox::pool;
+
+Textbox* Textbox::Create(char x, char y, unsigned char width, unsigned char height, bool d, bool hidden_frame)
+{
+	if (pool.size() == 0)
+		return new Textbox(x, y, width, height, d, hidden_frame);
+	Textbox* t = pool.back();
+	pool.pop_back();
+	t->in_pool = false;
+	t->Initialize(x, y, width, height, d, hidden_frame);
+	return t;
+}
+
+void Textbox::Release(Textbox* t)
+{
+	if (!t)
+		return;
+	//a second release would put it in the pool twice, and Create would hand it out twice
+	if (t->in_pool)
+	{
+#ifdef _DEBUG
+		std::cout << "Textbox released twice\n";
+#endif
+		return;
+	}
+	t->in_pool = true;
+	//same as what deleting it used to do, but the vectors and vertex arrays keep their memory for the next textbox
+	if (t->text)
+		TextItem::Release(t->text);
+	t->text = 0;
+	t->ClearItems();
+	t->textboxes.clear();
+	t->drawn_textboxes.clear();
+
+	//let go of whatever the callbacks captured
+	t->render_callback = nullptr;
+	t->close_callback = nullptr;
+	t->switch_callback = nullptr;
+	t->counter_callback = nullptr;
+	t->counter_close_callback = nullptr;
+	pool.push_back(t);
+}
+
+void Textbox::FreePool()
+{
+	for (unsigned int i = 0; i < pool.size(); i++)
+		delete pool[i];
+	pool.clear();
+}
+
+Textbox::Textbox(char x, char y, unsigned char width, unsigned char height, bool d, bool hidden_frame) : frame_layer(sf::Quads), font_layer(sf::Quads), status_layer(sf::Quads)
+{
+	text = 0;
+	in_pool = false;
+	Initialize(x, y, width, height, d, hidden_frame);
+}
+
+Textbox::~Textbox()
+{
+	if (text)
+		TextItem::Release(text);
+	ClearItems();
+}
+
+void Textbox::Initialize(char x, char y, unsigned char width, unsigned char height, bool d, bool hidden_frame)
 {
-	tiles = 0;
+	tiles_changed = true;
+	layers_show_more = false;
+	layers_delayed = false;
+	drawn_arrows = 0;
 	delete_on_close = d;
 	close = false;
 	cancel_switch = false;
@@ -15,6 +82,12 @@ Textbox::Textbox(char x, char y, unsigned char width, unsigned char height, bool
 	scroll_pos = 0;
 	scroll_start = INT_MAX;
 	close_callback = nullptr;
+	render_callback = nullptr;
+	switch_callback = nullptr;
+	switch_last_item = true;
+	item_start = sf::Vector2i();
+	item_spacing = sf::Vector2u();
+	arrow_offset = sf::Vector2i();
 
 	active_index = 0;
 	inactive_index = 0;
@@ -34,27 +107,14 @@ Textbox::Textbox(char x, char y, unsigned char width, unsigned char height, bool
 	auto_close_timer = 0;
 	max_select = INT_MAX;
 
-	SetFrame(x, y, width, height);
-}
-
-Textbox::~Textbox()
-{
-	//if (delete_on_close)
-	{
-		if (text)
-		delete text;
+	is_counter = false;
+	min_counter = 0;
+	max_counter = 0;
+	counter_value = 0;
+	counter_callback = nullptr;
+	counter_close_callback = nullptr;
 
-		for (unsigned int i = 0; i < items.size(); i++)
-		{
-			if (items[i])
-				delete items[i];
-		}
-	}
-	if (tiles)
-	{
-		delete[] tiles;
-		tiles = 0;
-	}
+	SetFrame(x, y, width, height);
 }
 
 //TODO: Clean up a bit. Split into functions.
@@ -243,6 +303,7 @@ void Textbox::Update()
 					{
 						memcpy(tiles, tiles + size.x - 2, (size.x - 2) * 3);
 						memset(tiles + (size.x - 2) * 3, MENU_BLANK, (size.x - 2));
+						tiles_changed = true;
 					}
 					scroll_timer--;
 					if (scroll_timer == 0)
@@ -258,34 +319,51 @@ void Textbox::Update()
 	}
 }
 
-void Textbox::Render(sf::RenderWindow* window)
+void Textbox::Render(sf::RenderTarget* window)
 {
+	ProfileScope profile(ProfileSections::TEXTBOX_RENDER);
 	//we have to move this here because only the last textbox in a list gets updated
 	if (menu_open_delay > 0)
 		menu_open_delay--;
 	DrawFrame(window);
 }
 
+bool Textbox::NeedsRedraw()
+{
+	//the open delay counts down while rendering and callbacks draw things we can't track
+	if (tiles_changed || menu_open_delay > 0 || render_callback != nullptr)
+		return true;
+	if ((arrow_timer > CURSOR_MORE_TIME / 2) != layers_show_more || GetArrowSignature() != drawn_arrows)
+		return true;
+	return TextboxesNeedRedraw();
+}
+
 void Textbox::SetFrame(char x, char y, unsigned char width, unsigned char height)
 {
+	if ((width - 2) * (height - 1) > TEXTBOX_MAX_TILES)
+	{
+#ifdef _DEBUG
+		std::cout << "Textbox " << (int)width << "x" << (int)height << " is bigger than the screen\n";
+#endif
+		height = TEXTBOX_MAX_TILES / (width - 2) + 1;
+	}
 	pos = sf::Vector2i(x, y);
 	size = sf::Vector2u(width, height);
-	if (tiles)
-		delete[] tiles;
-	tiles = new unsigned char[(width - 2) * (height - 1)];
 	for (int i = 0; i < (width - 2) * (height - 1); i++)
 		tiles[i] = MENU_BLANK;
+	tiles_changed = true;
 }
 
 void Textbox::SetPosition(char x, char y)
 {
 	pos = sf::Vector2i(x, y);
+	tiles_changed = true;
 }
 
 void Textbox::SetText(TextItem* text)
 {
-	if (this->text)
-		delete this->text;
+	if (this->text && this->text != text)
+		TextItem::Release(this->text);
 	this->text = text;
 	this->text_tile_pos = size.x - 2;
 	this->text_pos = 0;
@@ -295,7 +373,7 @@ void Textbox::SetText(TextItem* text)
 void Textbox::SetText(string text)
 {
 	ClearItems();
-	SetText(new TextItem(this, nullptr, text));
+	SetText(TextItem::Create(this, nullptr, text));
 	is_menu = false;
 }
 
@@ -309,6 +387,7 @@ void Textbox::SetMenu(bool menu, unsigned char display_count, sf::Vector2i start
 	this->menu_flags = flags;
 	this->scroll_start = scroll_start;
 	this->switch_last_item = can_switch_last;
+	tiles_changed = true;
 	//this->menu_open_delay = MENU_DELAY_TIME;
 
 	//for assigning close_callback, you'd think if we passed nullptr to callback and assigned close_callback to callback, close_callback would be assigned nullptr
@@ -326,8 +405,7 @@ void Textbox::SetMenu(bool menu, unsigned char display_count, sf::Vector2i start
 	{
 		for (unsigned int i = 0; i < items.size(); i++)
 		{
-			if (items[i])
-				delete items[i];
+			TextItem::Release(items[i]);
 		}
 	}
 	this->items.resize(0);
@@ -339,10 +417,7 @@ void Textbox::ClearItems()
 	//if (delete_on_close)
 	//{
 	for (unsigned int i = 0; i < items.size(); i++)
-	{
-		if (items[i])
-			delete items[i];
-	}
+		TextItem::Release(items[i]);
 	//}
 
 	items.clear();
@@ -366,19 +441,19 @@ void Textbox::SetCounter(bool is_counter, unsigned char min, unsigned char max,
 	UpdateCounter();
 }
 
-void Textbox::DrawFrame(sf::RenderWindow* window)
+//rebuilds the cached quads. each cell goes into the layer of the texture it uses,
+//so the whole box is drawn with one call per texture instead of one per tile.
+void Textbox::BuildLayers()
 {
-	PaletteTexture* frame = ResourceCache::GetMenuTexture();
-	sf::IntRect src_rect(0, 0, 8, 8);
+	frame_layer.clear();
+	font_layer.clear();
+	status_layer.clear();
 	for (int x = pos.x; x < (int)(pos.x + size.x); x++)
 	{
 		for (int y = pos.y; y < (int)(pos.y + size.y); y++)
 		{
 			//determine which frame tile to draw
-			if (!hide_frame || menu_open_delay != 0)
-				sprite8x8.setTexture(*frame);
-			else
-				sprite8x8.setTexture(*ResourceCache::GetStatusesTexture(0));
+			sf::VertexArray* layer = (!hide_frame || menu_open_delay != 0 ? &frame_layer : &status_layer);
 			unsigned char tile = MENU_BLANK;
 			if (x == pos.x && y == pos.y)
 				tile = (hide_frame ? MENU_BLANK : MENU_CORNER_UL);
@@ -394,38 +469,63 @@ void Textbox::DrawFrame(sf::RenderWindow* window)
 				tile = (hide_frame ? MENU_BLANK : MENU_V);
 			else
 			{
-				if (x == pos.x + size.x - 2 && y == pos.y + size.y - 2 && arrow_timer > CURSOR_MORE_TIME / 2)
+				if (x == pos.x + size.x - 2 && y == pos.y + size.y - 2 && layers_show_more)
 				{
 					tile = CURSOR_MORE;
-					sprite8x8.setTexture(*ResourceCache::GetFontTexture());
+					layer = &font_layer;
 				}
 				else if (menu_open_delay == 0)
 				{
 					tile = (unsigned char)tiles[(x - pos.x - 1) + (y - pos.y - 1) * (size.x - 2)];
 					if (tile >= 0x80) //use the font texture
-						sprite8x8.setTexture(*ResourceCache::GetFontTexture());
+						layer = &font_layer;
 					else if (tile == MENU_BLANK)
-						sprite8x8.setTexture(*frame);
-					/*else if (tile >= 0x10 && tile < 0x40)
-					{
-					sprite8x8.setTexture(*ResourceCache::GetStatusesTexture(0));
-					tile -= 0x10;
-					}*/
+						layer = &frame_layer;
 					tile &= 0x7F;
 				}
 				else
 					tile = MENU_BLANK; //has intentionally making something seem like it's lagging ever been done before?
 			}
 			if (tile == MENU_BLANK)
-				sprite8x8.setTexture(*frame);
+				layer = &frame_layer;
+
+			float left = (float)((tile % 16) * 8);
+			float top = (float)((tile / 16) * 8);
+			float px = (float)(x * 8);
+			float py = (float)(y * 8);
+			layer->append(sf::Vertex(sf::Vector2f(px, py), sf::Vector2f(left, top)));
+			layer->append(sf::Vertex(sf::Vector2f(px + 8, py), sf::Vector2f(left + 8, top)));
+			layer->append(sf::Vertex(sf::Vector2f(px + 8, py + 8), sf::Vector2f(left + 8, top + 8)));
+			layer->append(sf::Vertex(sf::Vector2f(px, py + 8), sf::Vector2f(left, top + 8)));
+		}
+	}
+	tiles_changed = false;
+}
 
-			src_rect.left = (tile % 16) * 8;
-			src_rect.top = (tile / 16) * 8;
-			sprite8x8.setTextureRect(src_rect);
-			sprite8x8.setPosition((float)(x * 8), (float)(y * 8));
+void Textbox::DrawFrame(sf::RenderTarget* window)
+{
+	//the "more" arrow blinks and the contents are hidden while the menu is opening,
+	//so those also need a rebuild when they change
+	bool show_more = arrow_timer > CURSOR_MORE_TIME / 2;
+	bool delayed = menu_open_delay != 0;
+	if (tiles_changed || show_more != layers_show_more || delayed != layers_delayed)
+	{
+		layers_show_more = show_more;
+		layers_delayed = delayed;
+		BuildLayers();
+	}
 
-			window->draw(sprite8x8);
-		}
+	window->draw(frame_layer, ResourceCache::GetMenuTexture()->GetTexture());
+	Profiler::CountDraw(ResourceCache::GetMenuTexture()->GetTexture());
+	if (status_layer.getVertexCount() > 0)
+	{
+		window->draw(status_layer, ResourceCache::GetStatusesTexture(0)->GetTexture());
+		Profiler::CountDraw(ResourceCache::GetStatusesTexture(0)->GetTexture());
+	}
+	if (font_layer.getVertexCount() > 0)
+	{
+		window->draw(font_layer, ResourceCache::GetFontTexture()->GetTexture());
+		Profiler::CountDraw(ResourceCache::GetFontTexture()->GetTexture());
 	}
 
 	//This code to draw arrows must be here instead of in the Render function where it was before.
@@ -443,11 +543,27 @@ void Textbox::DrawFrame(sf::RenderWindow* window)
 
 	for (unsigned int i = 0; i < textboxes.size(); i++)
 		textboxes[i]->Render(window);
+	drawn_arrows = GetArrowSignature();
+	MarkTextboxesDrawn();
+}
+
+//packs which selection arrows DrawFrame shows and on which rows, so a change can be noticed without drawing
+unsigned int Textbox::GetArrowSignature()
+{
+	if (!is_menu || !(menu_flags & MenuFlags::FOCUSABLE) || menu_open_delay != 0)
+		return 0;
+	unsigned int signature = 0;
+	if (arrow_state & ArrowStates::INACTIVE)
+		signature |= 0x8000 | ((inactive_index - scroll_pos) & 0x7FFF);
+	if (arrow_state & ArrowStates::ACTIVE && cursor_visibility_timer < CURSOR_VIS_TIME / 2)
+		signature |= (0x8000 | ((active_index - scroll_pos) & 0x7FFF)) << 16;
+	return signature;
 }
 
 void Textbox::UpdateMenu()
 {
 	text_timer = 0;
+	tiles_changed = true;
 	memset(tiles, MENU_BLANK, (size.x - 2) * (size.y - 1));
 	//this function creates "tiles" for display
 	for (unsigned int i = scroll_pos; i < scroll_pos + display_count && i < items.size(); i++)
@@ -485,9 +601,10 @@ void Textbox::UpdateCounter()
 	pokestring(s);
 	for (unsigned int i = 0; i < s.length(); i++)
 		tiles[i] = (unsigned char)s[i];
+	tiles_changed = true;
 }
 
-void Textbox::DrawArrow(sf::RenderWindow* window, bool active)
+void Textbox::DrawArrow(sf::RenderTarget* window, bool active)
 {
 	sf::IntRect src_rect = sf::IntRect(0, 0, 8, 8);
 	sprite8x8.setTexture(*ResourceCache::GetFontTexture());
@@ -500,6 +617,7 @@ void Textbox::DrawArrow(sf::RenderWindow* window, bool active)
 	sprite8x8.setPosition((float)(pos.x * 8 + item_start.x * 8 + arrow_offset.x * 8), (float)(pos.y * 8 + item_start.y * 8 + 8 + index * 8 * item_spacing.y + arrow_offset.y * 8));
 	sprite8x8.setTextureRect(src_rect);
 	window->draw(sprite8x8);
+	Profiler::CountDraw(sprite8x8.getTexture());
 }
 
 void Textbox::ProcessNextCharacter()
@@ -542,6 +660,7 @@ void Textbox::ProcessNextCharacter()
 		if (InputController::KeyDownOnce(INPUT_A) || InputController::KeyDownOnce(INPUT_B))
 		{
 			memset(tiles, MENU_BLANK, (size.x - 2) * (size.y - 2));
+			tiles_changed = true;
 			text_tile_pos = size.x - 2;
 			text_timer = TEXT_TIMER_BLANK;
 			Engine::GetWorldSounds().Play(SFX_TEXT);
@@ -602,6 +721,7 @@ void Textbox::ProcessNextCharacter()
 
 	default: //regular char
 		tiles[text_tile_pos++] = c;
+		tiles_changed = true;
 		break;
 	}
 
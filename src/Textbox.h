@@ -13,14 +13,21 @@
 #include "InputController.h"
 #include "Players.h"
 
+//the most text tiles a textbox can hold: the inside of a frame hanging one tile off each side of the 20x18 screen
+#define TEXTBOX_MAX_TILES ((VIEWPORT_WIDTH * 2) * (VIEWPORT_HEIGHT * 2 + 1))
+
+//Textboxes come from a pool so showing a message doesn't have to allocate once a few have been used.
+//Use Create instead of new and Release instead of delete.
 class Textbox : public TextboxParent
 {
 public:
-	Textbox(char x = 0, char y = 12, unsigned char width = 20, unsigned char height = 6, bool delete_on_close = true, bool hidden_frame = false);
-	~Textbox();
+	static Textbox* Create(char x = 0, char y = 12, unsigned char width = 20, unsigned char height = 6, bool delete_on_close = true, bool hidden_frame = false);
+	static void Release(Textbox* t); //puts t back in the pool along with its text and items
+	static void FreePool(); //deletes the textboxes that aren't in use, call when shutting down
 
 	void Update();
-	void Render(sf::RenderWindow* window);
+	void Render(sf::RenderTarget* window);
+	bool NeedsRedraw(); //true if this textbox or its children would look different than when last rendered
 
 	void SetFrame(char x, char y, unsigned char width, unsigned char height);
 	void SetPosition(char x, char y);
@@ -56,7 +63,7 @@ public:
 	void ResetSelection() { active_index = inactive_index = scroll_pos = 0; }
 	bool IsDone() { return auto_close_timer > 0; }
 	void SetJustOpened(unsigned char delay = MENU_DELAY_TIME) { menu_open_delay = delay; }
-	unsigned char* GetTiles() { return tiles; } //allows for external tile editing
+	unsigned char* GetTiles() { tiles_changed = true; return tiles; } //allows for external tile editing
 	TextItem* GetText() { return text; }
 
 	int GetScrollIndex() { return active_index - scroll_pos; }
@@ -70,7 +77,7 @@ public:
 	void PerformCloseCallback() { if (close_callback != nullptr)close_callback(0); }
 	void SetMaxSelect(unsigned int value) { max_select = value; }
 
-	void SetRenderCallback(std::function<void(sf::RenderWindow* w)> f)
+	void SetRenderCallback(std::function<void(sf::RenderTarget* w)> f)
 	{
 		if (f)
 			this->render_callback = f;
@@ -79,6 +86,13 @@ public:
 	}
 
 private:
+	Textbox(char x, char y, unsigned char width, unsigned char height, bool delete_on_close, bool hidden_frame);
+	~Textbox();
+	void Initialize(char x, char y, unsigned char width, unsigned char height, bool delete_on_close, bool hidden_frame);
+
+	static std::vector<Textbox*> pool;
+	bool in_pool; //so releasing a textbox twice can be caught
+
 	sf::Vector2i pos;
 	sf::Vector2u size;
 	bool close;
@@ -86,7 +100,7 @@ private:
 	bool cancel_switch;
 	bool close_when_no_children; //make the textbox close when its children have been closed
 	bool hide_frame;
-	std::function<void(sf::RenderWindow* t)> render_callback; //function called when update loop finishes
+	std::function<void(sf::RenderTarget* t)> render_callback; //function called when update loop finishes
 	bool wait_for_sound;
 
 	//menu-related stuff
@@ -115,7 +129,7 @@ private:
 	TextItem* text; //the text that is going to be displayed (null-terminated)
 	unsigned int text_tile_pos; //the tile index for the text character
 	unsigned int text_pos; //the next char to parse
-	unsigned char* tiles; //the parsed text so several characters don't have to be parsed each frame
+	unsigned char tiles[TEXTBOX_MAX_TILES]; //the parsed text so several characters don't have to be parsed each frame
 	bool autoscroll; //does the text scroll if the player doesn't hit a button? (eg. in battles)
 	int text_timer; //the time until the next char is parsed
 	unsigned char arrow_timer; //if > CURSOR_NEXT_TIME / 2 then show "more" arrow
@@ -133,8 +147,17 @@ private:
 
 	//render stuff
 	sf::Sprite sprite8x8;
-	void DrawFrame(sf::RenderWindow* window);
-	void DrawArrow(sf::RenderWindow* window, bool active);
+	sf::VertexArray frame_layer; //cached quads for the frame and blank tiles
+	sf::VertexArray font_layer; //cached quads for the text tiles
+	sf::VertexArray status_layer; //cached quads for non-text tiles in a hidden frame
+	bool tiles_changed; //set when tiles/frame change so the layers get rebuilt
+	bool layers_show_more; //"more" arrow state the layers were built with
+	bool layers_delayed; //menu_open_delay state the layers were built with
+	unsigned int drawn_arrows; //GetArrowSignature() as of the last render
+	unsigned int GetArrowSignature();
+	void BuildLayers();
+	void DrawFrame(sf::RenderTarget* window);
+	void DrawArrow(sf::RenderTarget* window, bool active);
 	void ProcessNextCharacter();
 
 	void Scroll(bool up);
@@ -35,7 +35,7 @@ bool TextboxParent::UpdateTextboxes()
 		{
 			if (textboxes[i]->DeleteOnClose())
 			{
-				delete textboxes[i];
+				Textbox::Release(textboxes[i]);
 				textboxes[i] = 0;
 			}
 			else
@@ -57,7 +57,7 @@ void TextboxParent::CloseAll(bool include_this)
 		{
 			if (textboxes[i]->DeleteOnClose())
 			{
-				delete textboxes[i];
+				Textbox::Release(textboxes[i]);
 			}
 			else
 				textboxes[i]->CancelClose();
@@ -69,4 +69,17 @@ void TextboxParent::CloseAll(bool include_this)
 std::vector<Textbox*>& TextboxParent::GetTextboxes()
 {
 	return textboxes;
+}
+
+bool TextboxParent::TextboxesNeedRedraw()
+{
+	//compare against the list instead of flagging changes because GetTextboxes() lets anyone edit it
+	if (textboxes != drawn_textboxes)
+		return true;
+	for (unsigned int i = 0; i < textboxes.size(); i++)
+	{
+		if (textboxes[i] && textboxes[i]->NeedsRedraw())
+			return true;
+	}
+	return false;
 }
\ No newline at end of file
@@ -15,7 +15,11 @@ public:
 	virtual void CloseAll(bool include_this = false);
 
 	std::vector<Textbox*>& GetTextboxes();
+	bool TextboxesNeedRedraw(); //true if a textbox was opened, closed or changed since the last MarkTextboxesDrawn
 
 protected:
 	std::vector<Textbox*> textboxes;
+	std::vector<Textbox*> drawn_textboxes; //the textboxes as they were last rendered
+
+	void MarkTextboxesDrawn() { drawn_textboxes = textboxes; }
 };
\ No newline at end of file
@@ -0,0 +1,74 @@
+#include "TileCompositor.h"
+#include <cstring>
+
+TileCompositor::TileCompositor()
+{
+	draw_count = 0;
+	ClearBackground();
+}
+
+TileCompositor::~TileCompositor()
+{
+}
+
+void TileCompositor::SetTile(int x, int y, PaletteTexture* texture, unsigned char tile, unsigned char flags)
+{
+	if (x < 0 || y < 0 || x >= COMPOSITOR_WIDTH || y >= COMPOSITOR_HEIGHT)
+		return;
+	Cell& c = cells[x + y * COMPOSITOR_WIDTH];
+	if (c.texture == texture && c.tile == tile && c.flags == flags)
+		return;
+	c.texture = texture;
+	c.tile = tile;
+	c.flags = flags;
+	background_changed = true;
+}
+
+void TileCompositor::ClearTile(int x, int y)
+{
+	SetTile(x, y, 0, 0);
+}
+
+void TileCompositor::ClearBackground()
+{
+	memset(cells, 0, sizeof(cells));
+	background_changed = true;
+}
+
+void TileCompositor::AddSprite(int x, int y, PaletteTexture* texture, unsigned char tile, unsigned char flags)
+{
+	AddSprite(x, y, texture, sf::IntRect((tile % 16) * 8, (tile / 16) * 8, 8, 8), flags);
+}
+
+void TileCompositor::AddSprite(int x, int y, PaletteTexture* texture, sf::IntRect src, unsigned char flags)
+{
+	sprites.Add(x, y, texture, src, flags);
+}
+
+void TileCompositor::Flush(sf::RenderTarget* target)
+{
+	if (background_changed)
+		BuildBackground();
+	background.Draw(target);
+	sprites.Draw(target);
+	draw_count = background.GetDrawCount() + sprites.GetDrawCount();
+
+	//sprites get placed again next frame
+	sprites.Clear();
+}
+
+void TileCompositor::BuildBackground()
+{
+	background.Clear();
+	for (int y = 0; y < COMPOSITOR_HEIGHT; y++)
+	{
+		for (int x = 0; x < COMPOSITOR_WIDTH; x++)
+		{
+			Cell& c = cells[x + y * COMPOSITOR_WIDTH];
+			if (!c.texture)
+				continue;
+			background.Add(x * 8, y * 8, c.texture, sf::IntRect((c.tile % 16) * 8, (c.tile / 16) * 8, 8, 8), c.flags);
+		}
+	}
+	background_changed = false;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include "Constants.h"
+#include "PaletteTexture.h"
+#include "SpriteBatch.h"
+
+#define COMPOSITOR_WIDTH (VIEWPORT_WIDTH * 2) //in 8x8 tiles
+#define COMPOSITOR_HEIGHT (VIEWPORT_HEIGHT * 2)
+
+//Collects 8x8 tiles for a UI screen the way the Game Boy does: a 20x18 background
+//grid that stays until it's changed, and sprites that are placed again every frame.
+//Flush draws everything as quads with one draw call per texture and layer.
+class TileCompositor
+{
+public:
+	TileCompositor();
+	~TileCompositor();
+
+	//background tiles, in tile coordinates
+	void SetTile(int x, int y, PaletteTexture* texture, unsigned char tile, unsigned char flags = TileFlags::NONE);
+	void ClearTile(int x, int y);
+	void ClearBackground();
+
+	//sprites, in pixel coordinates. src can be smaller than 8x8.
+	void AddSprite(int x, int y, PaletteTexture* texture, unsigned char tile, unsigned char flags = TileFlags::NONE);
+	void AddSprite(int x, int y, PaletteTexture* texture, sf::IntRect src, unsigned char flags = TileFlags::NONE);
+
+	//draws the background then the sprites, and removes the sprites
+	void Flush(sf::RenderTarget* target);
+
+	unsigned int GetDrawCount() { return draw_count; } //draw calls made by the last Flush
+
+private:
+	struct Cell
+	{
+		PaletteTexture* texture; //0 if empty
+		unsigned char tile;
+		unsigned char flags;
+	};
+
+	Cell cells[COMPOSITOR_WIDTH * COMPOSITOR_HEIGHT];
+	bool background_changed;
+	SpriteBatch background;
+	SpriteBatch sprites;
+	unsigned int draw_count;
+
+	void BuildBackground();
+};
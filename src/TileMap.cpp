@@ -1,4 +1,5 @@
 #include "TileMap.h"
+#include "Profiler.h"
 
 TileMap::TileMap(PaletteTexture* tiles_texture, DataBlock* formation, unsigned int t_x, unsigned char index, bool delete_tex)
 {
@@ -22,7 +23,7 @@ TileMap::~TileMap()
 	}
 }
 
-void TileMap::Render(sf::RenderWindow* window, int dest_x, int dest_y, unsigned int tile, unsigned int tile_size_x, unsigned int tile_size_y, int offset_x, int offset_y)
+void TileMap::Render(sf::RenderTarget* window, int dest_x, int dest_y, unsigned int tile, unsigned int tile_size_x, unsigned int tile_size_y, int offset_x, int offset_y)
 {
 	if (!tiles_tex)
 		return;
@@ -37,6 +38,21 @@ void TileMap::Render(sf::RenderWindow* window, int dest_x, int dest_y, unsigned
 			sprite8x8.setTextureRect(src_rect);
 			sprite8x8.setPosition((float)(int)(dest_x * 8 * (int)tile_size_x + x * 8 + offset_x), (float)(int)(dest_y * 8 * (int)tile_size_y + y * 8 + offset_y));
 			window->draw(sprite8x8);
+			Profiler::CountDraw(sprite8x8.getTexture());
 		}
 	}
 }
+
+void TileMap::Render(SpriteBatch& batch, int dest_x, int dest_y, unsigned int tile, unsigned int tile_size_x, unsigned int tile_size_y, int offset_x, int offset_y)
+{
+	if (!tiles_tex)
+		return;
+	for (unsigned int y = 0; y < tile_size_y; y++)
+	{
+		for (unsigned int x = 0; x < tile_size_x; x++)
+		{
+			unsigned char t = (formation ? formation->data[tile * tile_size_x * tile_size_y + y * tile_size_x + x] : tile * tile_size_x * tile_size_y + y * tile_size_x + x);
+			batch.Add(dest_x * 8 * (int)tile_size_x + x * 8 + offset_x, dest_y * 8 * (int)tile_size_y + y * 8 + offset_y, tiles_tex, sf::IntRect((t % tiles_x) * 8, (t / tiles_x) * 8, 8, 8));
+		}
+	}
+}
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <SFML/Graphics/Texture.hpp>
 #include "DataBlock.h"
 #include "PaletteTexture.h"
+#include "SpriteBatch.h"
 
 class TileMap
 {
@@ -11,7 +12,8 @@ public:
 	TileMap(PaletteTexture* tiles_texture = 0, DataBlock* formation = 0, unsigned int t_x = 0, unsigned char index = 0, bool delete_tex = false);
 	virtual ~TileMap();
 
-	void Render(sf::RenderWindow* window, int dest_x, int dest_y, unsigned int tile, unsigned int tile_size_x, unsigned int tile_size_y, int offset_x = 0, int offset_y = 0);
+	void Render(sf::RenderTarget* window, int dest_x, int dest_y, unsigned int tile, unsigned int tile_size_x, unsigned int tile_size_y, int offset_x = 0, int offset_y = 0);
+	void Render(SpriteBatch& batch, int dest_x, int dest_y, unsigned int tile, unsigned int tile_size_x, unsigned int tile_size_y, int offset_x = 0, int offset_y = 0);
 	inline PaletteTexture* GetTexture() { return tiles_tex; }
 	inline void SetFormation(DataBlock* data) { formation = data; }
 	inline DataBlock* GetFormation() { return formation; }
@@ -1,4 +1,5 @@
 #include "Tileset.h"
+#include "Profiler.h"
 
 Tileset::Tileset(unsigned char index) : TileMap()
 {
@@ -41,7 +42,7 @@ void Tileset::Load(unsigned char index)
 	}
 }
 
-void Tileset::Render(sf::RenderWindow* window, int dest_x, int dest_y, unsigned int tile, unsigned int tile_size_x, unsigned int tile_size_y)
+void Tileset::Render(sf::RenderTarget* window, int dest_x, int dest_y, unsigned int tile, unsigned int tile_size_x, unsigned int tile_size_y, AnimatedTiles* animated)
 {
 	if (!tiles_tex)
 		return;
@@ -59,21 +60,33 @@ void Tileset::Render(sf::RenderWindow* window, int dest_x, int dest_y, unsigned
 		for (unsigned int x = 0; x < tile_size_x; x++)
 		{
 			unsigned char t = (formation ? formation->data[tile * tile_size_x * tile_size_y + y * tile_size_x + x] : tile * tile_size_x * tile_size_y + y * tile_size_x + x);
+			float px = (float)(int)(dest_x * 8 * (int)tile_size_x + x * 8);
+			float py = (float)(int)(dest_y * 8 * (int)tile_size_y + y * 8);
 			if (t == WATER_TILE && this->misc_data->data[4])
 			{
 				sprite = &water8x8;
-				src_rect.left = (water_animation_stage / ANIMATION_TIMER) * 8;
-				if (water_animation_stage / ANIMATION_TIMER > 3)
-					src_rect.left = (8 - (water_animation_stage / ANIMATION_TIMER)) * 8;
+				src_rect.left = GetWaterFrame();
 				src_rect.top = 0;
+				if (animated)
+				{
+					animated->water.append(sf::Vertex(sf::Vector2f(px, py)));
+					animated->water.append(sf::Vertex(sf::Vector2f(px + 8, py)));
+					animated->water.append(sf::Vertex(sf::Vector2f(px + 8, py + 8)));
+					animated->water.append(sf::Vertex(sf::Vector2f(px, py + 8)));
+				}
 			}
 			else if (t == FLOWER_TILE && this->misc_data->data[4] & 2)
 			{
 				sprite = &flower8x8;
-				src_rect.left = ((water_animation_stage / ANIMATION_TIMER) % 4 - 1) * 8;
-				if (src_rect.left < 0)
-					src_rect.left = 0;
+				src_rect.left = GetFlowerFrame();
 				src_rect.top = 0;
+				if (animated)
+				{
+					animated->flowers.append(sf::Vertex(sf::Vector2f(px, py)));
+					animated->flowers.append(sf::Vertex(sf::Vector2f(px + 8, py)));
+					animated->flowers.append(sf::Vertex(sf::Vector2f(px + 8, py + 8)));
+					animated->flowers.append(sf::Vertex(sf::Vector2f(px, py + 8)));
+				}
 			}
 			else
 			{
@@ -82,12 +95,56 @@ void Tileset::Render(sf::RenderWindow* window, int dest_x, int dest_y, unsigned
 				src_rect.top = (t / tiles_x) * 8;
 			}
 			sprite->setTextureRect(src_rect);
-			sprite->setPosition((float)(int)(dest_x * 8 * (int)tile_size_x + x * 8), (float)(int)(dest_y * 8 * (int)tile_size_y + y * 8));
+			sprite->setPosition(px, py);
 			window->draw(*sprite);
+			Profiler::CountDraw(sprite->getTexture());
 		}
 	}
 }
 
+void Tileset::RenderAnimatedTiles(sf::RenderTarget* window, AnimatedTiles& animated)
+{
+	if (animated.water.getVertexCount() > 0)
+	{
+		SetFrame(animated.water, GetWaterFrame());
+		window->draw(animated.water, water_tile.GetTexture());
+		Profiler::CountDraw(water_tile.GetTexture());
+	}
+	if (animated.flowers.getVertexCount() > 0)
+	{
+		SetFrame(animated.flowers, GetFlowerFrame());
+		window->draw(animated.flowers, ResourceCache::GetFlowerTexture()->GetTexture());
+		Profiler::CountDraw(ResourceCache::GetFlowerTexture()->GetTexture());
+	}
+}
+
+int Tileset::GetWaterFrame()
+{
+	//the water goes back and forth through its 5 frames
+	int frame = water_animation_stage / ANIMATION_TIMER;
+	if (frame > 3)
+		frame = 8 - frame;
+	return frame * 8;
+}
+
+int Tileset::GetFlowerFrame()
+{
+	int left = ((water_animation_stage / ANIMATION_TIMER) % 4 - 1) * 8;
+	return (left < 0 ? 0 : left);
+}
+
+void Tileset::SetFrame(sf::VertexArray& quads, int left)
+{
+	float l = (float)left;
+	for (unsigned int i = 0; i < quads.getVertexCount(); i += 4)
+	{
+		quads[i].texCoords = sf::Vector2f(l, 0);
+		quads[i + 1].texCoords = sf::Vector2f(l + 8, 0);
+		quads[i + 2].texCoords = sf::Vector2f(l + 8, 8);
+		quads[i + 3].texCoords = sf::Vector2f(l, 8);
+	}
+}
+
 void Tileset::AnimateTiles()
 {
 	if (poison_timer > 0)
@@ -97,6 +154,13 @@ void Tileset::AnimateTiles()
 		water_animation_stage = 0;
 }
 
+unsigned int Tileset::GetAnimationFrame()
+{
+	//water and flowers only animate on tilesets that have them
+	unsigned int frame = (misc_data && misc_data->data[4] ? water_animation_stage / ANIMATION_TIMER : 0);
+	return frame | (poison_timer > 0 ? 0x100 : 0);
+}
+
 void Tileset::SetPalette(sf::Color palette[])
 {
 	water_tile.SetPalette(palette);
@@ -7,6 +7,14 @@
 #include "PaletteTexture.h"
 
 
+//positions of the water and flower tiles in a cached map background, so just those get redrawn as they animate
+struct AnimatedTiles
+{
+	AnimatedTiles() : water(sf::Quads), flowers(sf::Quads) {}
+	sf::VertexArray water;
+	sf::VertexArray flowers;
+};
+
 class Tileset : public TileMap
 {
 public:
@@ -15,7 +23,8 @@ public:
 
 	void Load(unsigned char index);
 
-	void Render(sf::RenderWindow* window, int dest_x, int dest_y, unsigned int tile, unsigned int tile_size_x, unsigned int tile_size_y);
+	void Render(sf::RenderTarget* window, int dest_x, int dest_y, unsigned int tile, unsigned int tile_size_x, unsigned int tile_size_y, AnimatedTiles* animated = 0);
+	void RenderAnimatedTiles(sf::RenderTarget* window, AnimatedTiles& animated);
 
 	void AnimateTiles();
 	void SetPalette(sf::Color palette[]);
@@ -26,6 +35,8 @@ public:
 	inline PaletteTexture* GetTransparentTiles() { return &transparent_tiles; }
 	inline PaletteTexture* GetPoisonTiles() { return &poison_tiles; }
 	inline void SetPoisonTimer() { poison_timer = 3; }
+	inline bool IsPoisoned() { return poison_timer > 0; }
+	unsigned int GetAnimationFrame(); //changes whenever the tiles Render draws would look different
 
 	bool IsDoorTile(unsigned char tile);
 
@@ -42,4 +53,8 @@ protected:
 	unsigned char water_animation_stage;
 	unsigned char grass_tile;
 	unsigned char poison_timer;
+
+	int GetWaterFrame(); //x offset of the current frame in the water texture
+	int GetFlowerFrame(); //same for the flower texture
+	static void SetFrame(sf::VertexArray& quads, int left);
 };
@@ -0,0 +1,103 @@
+#pragma once
+
+//the type ids used in the game's data
+enum Types
+{
+	NORMAL = 0,
+	FIGHTING = 1,
+	FLYING = 2,
+	POISON = 3,
+	GROUND = 4,
+	ROCK = 5,
+	BUG = 7,
+	GHOST = 8,
+	FIRE = 0x14,
+	WATER = 0x15,
+	GRASS = 0x16,
+	ELECTRIC = 0x17,
+	PSYCHIC = 0x18,
+	ICE = 0x19,
+	DRAGON = 0x1A,
+};
+
+//The type ids have gaps, so tables are indexed by a dense type index instead: 0-14 in the order above,
+//and TYPE_COUNT for anything else (the unused bird type, glitch data) which nothing is strong or weak against.
+#define TYPE_COUNT 15
+#define TYPE_NEUTRAL 10 //multipliers are in tenths, like the game's
+
+static constexpr unsigned char type_indexes[0x20] =
+{
+	0, 1, 2, 3, 4, 5, TYPE_COUNT, 6, 7, TYPE_COUNT, TYPE_COUNT, TYPE_COUNT, TYPE_COUNT, TYPE_COUNT, TYPE_COUNT, TYPE_COUNT,
+	TYPE_COUNT, TYPE_COUNT, TYPE_COUNT, TYPE_COUNT, 8, 9, 10, 11, 12, 13, 14, TYPE_COUNT, TYPE_COUNT, TYPE_COUNT, TYPE_COUNT, TYPE_COUNT,
+};
+
+constexpr unsigned char GetTypeIndex(unsigned char type) { return type < 0x20 ? type_indexes[type] : TYPE_COUNT; }
+
+struct TypeMatchup
+{
+	unsigned char attacking;
+	unsigned char defending;
+	unsigned char multiplier;
+};
+
+//the game's type chart, in the game's order: anything that isn't listed is normal damage.
+//Ghost not affecting psychic is a bug in the original, kept on purpose
+static constexpr TypeMatchup type_chart[] =
+{
+	{ WATER, FIRE, 20 }, { FIRE, GRASS, 20 }, { FIRE, ICE, 20 }, { GRASS, WATER, 20 }, { ELECTRIC, WATER, 20 }, { WATER, ROCK, 20 },
+	{ GROUND, FLYING, 0 }, { WATER, WATER, 5 }, { FIRE, FIRE, 5 }, { ELECTRIC, ELECTRIC, 5 }, { ICE, ICE, 5 }, { GRASS, GRASS, 5 },
+	{ PSYCHIC, PSYCHIC, 5 }, { FIRE, WATER, 5 }, { GRASS, FIRE, 5 }, { WATER, GRASS, 5 }, { ELECTRIC, GRASS, 5 }, { NORMAL, ROCK, 5 },
+	{ NORMAL, GHOST, 0 }, { GHOST, GHOST, 20 }, { FIRE, BUG, 20 }, { FIRE, ROCK, 5 }, { WATER, GROUND, 20 }, { ELECTRIC, GROUND, 0 },
+	{ ELECTRIC, FLYING, 20 }, { GRASS, GROUND, 20 }, { GRASS, BUG, 5 }, { GRASS, POISON, 5 }, { GRASS, ROCK, 20 }, { GRASS, FLYING, 5 },
+	{ ICE, WATER, 5 }, { ICE, GRASS, 20 }, { ICE, GROUND, 20 }, { ICE, FLYING, 20 }, { FIGHTING, NORMAL, 20 }, { FIGHTING, POISON, 5 },
+	{ FIGHTING, FLYING, 5 }, { FIGHTING, PSYCHIC, 5 }, { FIGHTING, BUG, 5 }, { FIGHTING, ROCK, 20 }, { FIGHTING, ICE, 20 }, { FIGHTING, GHOST, 0 },
+	{ POISON, GRASS, 20 }, { POISON, POISON, 5 }, { POISON, GROUND, 5 }, { POISON, BUG, 20 }, { POISON, ROCK, 5 }, { POISON, GHOST, 5 },
+	{ GROUND, FIRE, 20 }, { GROUND, ELECTRIC, 20 }, { GROUND, GRASS, 5 }, { GROUND, BUG, 5 }, { GROUND, ROCK, 20 }, { GROUND, POISON, 20 },
+	{ FLYING, ELECTRIC, 5 }, { FLYING, FIGHTING, 20 }, { FLYING, BUG, 20 }, { FLYING, GRASS, 20 }, { FLYING, ROCK, 5 }, { PSYCHIC, FIGHTING, 20 },
+	{ PSYCHIC, POISON, 20 }, { BUG, FIRE, 5 }, { BUG, GRASS, 20 }, { BUG, FIGHTING, 5 }, { BUG, FLYING, 5 }, { BUG, PSYCHIC, 20 },
+	{ BUG, GHOST, 5 }, { BUG, POISON, 20 }, { ROCK, FIRE, 20 }, { ROCK, FIGHTING, 5 }, { ROCK, GROUND, 5 }, { ROCK, FLYING, 20 },
+	{ ROCK, BUG, 20 }, { ROCK, ICE, 20 }, { GHOST, NORMAL, 0 }, { GHOST, PSYCHIC, 0 }, { FIRE, DRAGON, 5 }, { WATER, DRAGON, 5 },
+	{ ELECTRIC, DRAGON, 5 }, { GRASS, DRAGON, 5 }, { ICE, DRAGON, 20 }, { DRAGON, DRAGON, 20 },
+};
+
+#define TYPE_CHART_SIZE (sizeof(type_chart) / sizeof(TypeMatchup))
+#define TYPE_NOT_LISTED 0xFF
+
+//where a matchup (by type index) is in the chart, or TYPE_NOT_LISTED
+constexpr unsigned char FindMatchup(unsigned char attacking, unsigned char defending, unsigned int i = 0)
+{
+	return i == TYPE_CHART_SIZE ? TYPE_NOT_LISTED
+		: GetTypeIndex(type_chart[i].attacking) == attacking && GetTypeIndex(type_chart[i].defending) == defending ? i
+		: FindMatchup(attacking, defending, i + 1);
+}
+
+constexpr unsigned char CalculateEffectiveness(unsigned char attacking, unsigned char defending)
+{
+	return FindMatchup(attacking, defending) == TYPE_NOT_LISTED ? TYPE_NEUTRAL : type_chart[FindMatchup(attacking, defending)].multiplier;
+}
+
+//the chart as a table, filled in at compile time: type_effectiveness[attacking][defending] by type index
+#define TYPE_ROW(a) { CalculateEffectiveness(a, 0), CalculateEffectiveness(a, 1), CalculateEffectiveness(a, 2), CalculateEffectiveness(a, 3), \
+	CalculateEffectiveness(a, 4), CalculateEffectiveness(a, 5), CalculateEffectiveness(a, 6), CalculateEffectiveness(a, 7), CalculateEffectiveness(a, 8), \
+	CalculateEffectiveness(a, 9), CalculateEffectiveness(a, 10), CalculateEffectiveness(a, 11), CalculateEffectiveness(a, 12), CalculateEffectiveness(a, 13), \
+	CalculateEffectiveness(a, 14), CalculateEffectiveness(a, 15) }
+static constexpr unsigned char type_effectiveness[TYPE_COUNT + 1][TYPE_COUNT + 1] =
+{
+	TYPE_ROW(0), TYPE_ROW(1), TYPE_ROW(2), TYPE_ROW(3), TYPE_ROW(4), TYPE_ROW(5), TYPE_ROW(6), TYPE_ROW(7),
+	TYPE_ROW(8), TYPE_ROW(9), TYPE_ROW(10), TYPE_ROW(11), TYPE_ROW(12), TYPE_ROW(13), TYPE_ROW(14), TYPE_ROW(15),
+};
+#undef TYPE_ROW
+
+static_assert(type_effectiveness[GetTypeIndex(GHOST)][GetTypeIndex(PSYCHIC)] == 0, "the type chart table doesn't match the chart");
+static_assert(type_effectiveness[GetTypeIndex(WATER)][GetTypeIndex(FIRE)] == 20, "the type chart table doesn't match the chart");
+
+//The multipliers a move type (by type index) gets against a pair of types, in the order the game applies them.
+//The game rounds down after each one, so half then double isn't always the same as double then half.
+inline void GetTypeMultipliers(unsigned char attacking, unsigned char type1, unsigned char type2, unsigned char* multipliers)
+{
+	unsigned char d1 = GetTypeIndex(type1);
+	unsigned char d2 = GetTypeIndex(type2);
+	bool swap = d1 != d2 && FindMatchup(attacking, d2) < FindMatchup(attacking, d1);
+	multipliers[0] = type_effectiveness[attacking][swap ? d2 : d1];
+	multipliers[1] = d1 == d2 ? TYPE_NEUTRAL : type_effectiveness[attacking][swap ? d1 : d2];
+}
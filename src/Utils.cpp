@@ -1,7 +1,4 @@
 #include "Utils.h"
-#include "InputController.h"
-
-bool InputController::last_keys[256];
 
 DataBlock* ReadFile(const std::string& filename)
 {
@@ -142,6 +142,25 @@ private:
 	#endif
 #endif
 
+// Add impulses to the buffer with SSE2 or NEON where the target always has it.
+// Define to 0 to force the portable code.
+#ifndef BLIP_BUFFER_SIMD
+	#if !BLIP_BUFFER_FAST && (defined (__SSE2__) || defined (_M_X64) || \
+			(defined (_M_IX86_FP) && _M_IX86_FP >= 2) || defined (__ARM_NEON))
+		#define BLIP_BUFFER_SIMD 1
+	#else
+		#define BLIP_BUFFER_SIMD 0
+	#endif
+#endif
+
+#if BLIP_BUFFER_SIMD
+	#if defined (__ARM_NEON)
+		#include <arm_neon.h>
+	#else
+		#include <emmintrin.h>
+	#endif
+#endif
+
 	// Internal
 	typedef blip_ulong blip_resampled_time_t;
 	int const blip_widest_impulse_ = 16;
@@ -167,15 +186,17 @@ private:
 		int delta_factor;
 		
 		void volume_unit( double );
-		Blip_Synth_( short* impulses, int width );
+		Blip_Synth_( short* impulses, int width, short* kernels = 0 );
 		void treble_eq( blip_eq_t const& );
 	private:
 		double volume_unit_;
 		short* const impulses;
+		short* const kernels; // optional copy of impulses laid out per phase
 		int const width;
 		blip_long kernel_unit;
 		int impulses_size() const { return blip_res / 2 * width + 1; }
 		void adjust_impulse();
+		void build_kernels();
 	};
 
 // Quality level. Start with blip_good_quality.
@@ -229,9 +250,16 @@ private:
 	Blip_Synth_ impl;
 	typedef short imp_t;
 	imp_t impulses [blip_res * (quality / 2) + 1];
+#if BLIP_BUFFER_SIMD
+	// for each phase, the quality impulse values in the order they're added
+	imp_t kernels [blip_res * quality];
+public:
+	Blip_Synth() : impl( impulses, quality, kernels ) { }
+#else
 public:
 	Blip_Synth() : impl( impulses, quality ) { }
 #endif
+#endif
 };
 
 // Low-pass equalization parameters
@@ -365,7 +393,58 @@ inline void Blip_Synth<quality,range>::offset_resampled( blip_resampled_time_t t
 	
 	imp_t const* BLIP_RESTRICT imp = impulses + blip_res - phase;
 	
-	#if defined (_M_IX86) || defined (_M_IA64) || defined (__i486__) || \
+	#if BLIP_BUFFER_SIMD && defined (__ARM_NEON)
+	
+	// same sums as below, with the impulse for this phase already contiguous
+	
+	(void) rev; (void) mid; (void) imp;
+	imp_t const* BLIP_RESTRICT k = kernels + phase * quality;
+	int32x4_t const d = vdupq_n_s32( delta );
+	for ( int i = 0; i < quality; i += 4 )
+	{
+		int32x4_t k32 = vmovl_s16( vld1_s16( k + i ) );
+		vst1q_s32( buf + fwd + i, vmlaq_s32( vld1q_s32( buf + fwd + i ), k32, d ) );
+	}
+	
+	#elif BLIP_BUFFER_SIMD
+	
+	// same sums as below, with the impulse for this phase already contiguous.
+	// SSE2 has no 32-bit multiply, so delta is split into 16-bit halves with
+	// delta = (hi << 16) + lo, lo signed, and imp * delta = imp * lo + (imp * hi << 16)
+	
+	(void) rev; (void) mid; (void) imp;
+	imp_t const* BLIP_RESTRICT k = kernels + phase * quality;
+	__m128i const lo = _mm_set1_epi16( (short) delta );
+	__m128i const hi = _mm_set1_epi16( (short) ((delta - (short) delta) >> 16) );
+	
+	// low and high 16-bit halves of the 32-bit products of k16 and delta
+	#define BLIP_MUL( k16 ) \
+		__m128i prod_lo = _mm_mullo_epi16( k16, lo );\
+		__m128i prod_hi = _mm_add_epi16( _mm_mulhi_epi16( k16, lo ), _mm_mullo_epi16( k16, hi ) )
+	
+	#define BLIP_ADD4( out, prod ) \
+		_mm_storeu_si128( (__m128i*) (out), _mm_add_epi32( \
+				_mm_loadu_si128( (__m128i const*) (out) ), prod ) )
+	
+	int i = 0;
+	for ( ; i + 8 <= quality; i += 8 )
+	{
+		__m128i k16 = _mm_loadu_si128( (__m128i const*) (k + i) );
+		BLIP_MUL( k16 );
+		BLIP_ADD4( buf + fwd + i,     _mm_unpacklo_epi16( prod_lo, prod_hi ) );
+		BLIP_ADD4( buf + fwd + i + 4, _mm_unpackhi_epi16( prod_lo, prod_hi ) );
+	}
+	if ( quality & 4 )
+	{
+		__m128i k16 = _mm_loadl_epi64( (__m128i const*) (k + i) );
+		BLIP_MUL( k16 );
+		BLIP_ADD4( buf + fwd + i, _mm_unpacklo_epi16( prod_lo, prod_hi ) );
+	}
+	
+	#undef BLIP_MUL
+	#undef BLIP_ADD4
+	
+	#elif defined (_M_IX86) || defined (_M_IA64) || defined (__i486__) || \
 			defined (__x86_64__) || defined (__ia64__) || defined (__i386__)
 	
 	// straight forward implementation resulted in better code on GCC for x86
@@ -88,6 +88,11 @@ blargg_err_t Classic_Emu::setup_buffer( long rate )
 	return 0;
 }
 
+void Classic_Emu::sync_buffer_state( blargg_state_t& s )
+{
+	buf->sync_state( s );
+}
+
 blargg_err_t Classic_Emu::start_track_( int track )
 {
 	RETURN_ERR( Music_Emu::start_track_( track ) );
@@ -120,6 +125,35 @@ blargg_err_t Classic_Emu::play_( long count, sample_t* out )
 
 // Rom_Data
 
+struct Rom_Data_::image_t
+{
+	long refs;
+	long size;
+	// followed by padded file data
+};
+
+Rom_Data_::Rom_Data_()
+{
+	image       = 0;
+	rom         = 0;
+	file_size_  = 0;
+	rom_addr    = 0;
+	mask        = 0;
+	size_       = 0;
+	mapped_size = 0;
+}
+
+Rom_Data_::~Rom_Data_() { clear_(); }
+
+void Rom_Data_::clear_()
+{
+	image_t* p = image;
+	image = 0;
+	rom   = 0;
+	if ( p && !--p->refs )
+		free( p );
+}
+
 blargg_err_t Rom_Data_::load_rom_data_( Data_Reader& in,
 		int header_size, void* header_out, int fill, long pad_size )
 {
@@ -128,26 +162,55 @@ blargg_err_t Rom_Data_::load_rom_data_( Data_Reader& in,
 	rom_addr = 0;
 	mask     = 0;
 	size_    = 0;
-	rom.clear();
+	clear_();
 	
 	file_size_ = in.remain();
 	if ( file_size_ <= header_size ) // <= because there must be data after header
 		return gme_wrong_file_type;
-	blargg_err_t err = rom.resize( file_offset + file_size_ + pad_size );
-	if ( !err )
-		err = in.read( rom.begin() + file_offset, file_size_ );
+	
+	long size = file_offset + file_size_ + pad_size;
+	image_t* p = (image_t*) malloc( sizeof (image_t) + size );
+	CHECK_ALLOC( p );
+	p->refs = 1;
+	p->size = size;
+	byte* data = (byte*) (p + 1);
+	blargg_err_t err = in.read( data + file_offset, file_size_ );
 	if ( err )
 	{
-		rom.clear();
+		free( p );
 		return err;
 	}
 	
 	file_size_ -= header_size;
-	memcpy( header_out, &rom [file_offset], header_size );
+	memcpy( header_out, data + file_offset, header_size );
+	
+	memset( data               , fill, pad_size );
+	memset( data + size - pad_size, fill, pad_size );
+	
+	image       = p;
+	rom         = data;
+	mapped_size = size - pad_size;
 	
-	memset( rom.begin()         , fill, pad_size );
-	memset( rom.end() - pad_size, fill, pad_size );
+	return 0;
+}
+
+blargg_err_t Rom_Data_::share_( Rom_Data_ const& other, long pad_size )
+{
+	if ( !other.image )
+		return "No file data to share";
 	
+	if ( other.image != image )
+	{
+		other.image->refs++;
+		clear_();
+		image = other.image;
+		rom   = other.rom;
+	}
+	file_size_  = other.file_size_;
+	rom_addr    = 0;
+	mask        = 0;
+	size_       = 0;
+	mapped_size = image->size - pad_size;
 	return 0;
 }
 
@@ -172,8 +235,12 @@ void Rom_Data_::set_addr_( long addr, int unit )
 	if ( addr < 0 )
 		addr = 0;
 	size_ = rounded;
-	if ( rom.resize( rounded - rom_addr + pad_extra ) ) { } // OK if shrink fails
-
+	
+	// data is shared, so limit mapping rather than shrinking it
+	mapped_size = rounded - rom_addr - unit;
+	if ( mapped_size > (blargg_ulong) (image->size - unit - pad_extra) )
+		mapped_size = image->size - unit - pad_extra;
+	
 	if ( 0 )
 	{
 		dprintf( "addr: %X\n", addr );
@@ -20,6 +20,7 @@ protected:
 	blargg_err_t setup_buffer( long clock_rate );
 	long clock_rate() const { return clock_rate_; }
 	void change_clock_rate( long ); // experimental
+	void sync_buffer_state( blargg_state_t& );
 	
 	// Overridable
 	virtual void set_voice( int index, Blip_Buffer* center,
@@ -49,21 +50,35 @@ inline void Classic_Emu::set_buffer( Multi_Buffer* new_buf )
 // ROM data handler, used by several Classic_Emu derivitives. Loads file data
 // with padding on both sides, allowing direct use in bank mapping. The main purpose
 // is to allow all file data to be loaded with only one read() call (for efficiency).
+// Loaded data is never modified, so it can be shared between several emulators
+// playing the same file (see share()). Sharing isn't thread-safe, so load/clear
+// all emulators sharing data from the same thread.
 
 class Rom_Data_ {
 public:
 	typedef unsigned char byte;
 protected:
 	enum { pad_extra = 8 };
-	blargg_vector<byte> rom;
+	struct image_t;
+	image_t* image; // reference-counted, shared with other Rom_Data that share() it
+	byte* rom;      // padded file data in image
 	long file_size_;
 	blargg_long rom_addr;
 	blargg_long mask;
 	blargg_long size_; // TODO: eliminate
+	blargg_ulong mapped_size;
 	
+	Rom_Data_();
+	~Rom_Data_();
 	blargg_err_t load_rom_data_( Data_Reader& in, int header_size, void* header_out,
 			int fill, long pad_size );
+	blargg_err_t share_( Rom_Data_ const&, long pad_size );
 	void set_addr_( long addr, int unit );
+	void clear_();
+private:
+	// noncopyable
+	Rom_Data_( const Rom_Data_& );
+	Rom_Data_& operator = ( const Rom_Data_& );
 };
 
 template<int unit>
@@ -77,23 +92,27 @@ public:
 		return load_rom_data_( in, header_size, header_out, fill, pad_size );
 	}
 	
+	// Use same file data as 'other' without copying it. Data is freed once
+	// all Rom_Data using it have been cleared.
+	blargg_err_t share( Rom_Data const& other ) { return share_( other, pad_size ); }
+	
 	// Size of file data read in (excluding header)
 	long file_size() const { return file_size_; }
 	
 	// Pointer to beginning of file data
-	byte* begin() const { return rom.begin() + pad_size; }
+	byte const* begin() const { return rom + pad_size; }
 	
 	// Set address that file data should start at
 	void set_addr( long addr ) { set_addr_( addr, unit ); }
 	
 	// Free data
-	void clear() { rom.clear(); }
+	void clear() { clear_(); }
 	
 	// Size of data + start addr, rounded to a multiple of unit
 	long size() const { return size_; }
 	
 	// Pointer to unmapped page filled with same value
-	byte* unmapped() { return rom.begin(); }
+	byte* unmapped() { return rom; }
 	
 	// Mask address to nearest power of two greater than size()
 	blargg_long mask_addr( blargg_long addr ) const
@@ -108,7 +127,7 @@ public:
 	byte* at_addr( blargg_long addr )
 	{
 		blargg_ulong offset = mask_addr( addr ) - rom_addr;
-		if ( offset > blargg_ulong (rom.size() - pad_size) )
+		if ( offset > mapped_size )
 			offset = 0; // unmapped
 		return &rom [offset];
 	}
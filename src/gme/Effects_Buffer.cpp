@@ -121,6 +121,24 @@ void Effects_Buffer::clear()
 		bufs [i].clear();
 }
 
+void Effects_Buffer::sync_state( blargg_state_t& s )
+{
+	s.sync( &stereo_remain, sizeof stereo_remain );
+	s.sync( &effect_remain, sizeof effect_remain );
+	s.sync( &effects_enabled, sizeof effects_enabled );
+	for ( int i = 0; i < buf_count; i++ )
+		sync_buffer( s, bufs [i] );
+	
+	// echo and reverb only matter while effects are enabled
+	if ( config_.effects_enabled && echo_buf.size() )
+	{
+		s.sync( &echo_pos, sizeof echo_pos );
+		s.sync( &reverb_pos, sizeof reverb_pos );
+		s.sync( echo_buf.begin(), echo_size * sizeof echo_buf [0] );
+		s.sync( reverb_buf.begin(), reverb_size * sizeof reverb_buf [0] );
+	}
+}
+
 inline int pin_range( int n, int max, int min = 0 )
 {
 	if ( n < min )
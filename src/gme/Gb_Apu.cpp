@@ -32,6 +32,8 @@ Gb_Apu::Gb_Apu()
 	oscs [2] = &wave;
 	oscs [3] = &noise;
 	
+	fast_forward_ = false;
+	
 	for ( int i = 0; i < osc_count; i++ )
 	{
 		Gb_Osc& osc = *oscs [i];
@@ -126,6 +128,78 @@ void Gb_Apu::reset()
 	memcpy( wave.wave, initial_wave, sizeof wave.wave );
 }
 
+void Gb_Apu::save_state( gb_apu_state_t* out ) const
+{
+	for ( int i = 0; i < osc_count; i++ )
+	{
+		Gb_Osc const& osc = *oscs [i];
+		gb_apu_state_t::osc_t& o = out->oscs [i];
+		o.delay         = osc.delay;
+		o.last_amp      = osc.last_amp;
+		o.volume        = osc.volume;
+		o.length        = osc.length;
+		o.enabled       = osc.enabled;
+		o.output_select = osc.output_select;
+		o.env_delay     = 0;
+	}
+	out->oscs [0].env_delay = square1.env_delay;
+	out->oscs [1].env_delay = square2.env_delay;
+	out->oscs [3].env_delay = noise.env_delay;
+	
+	Gb_Square const* const squares [2] = { &square1, &square2 };
+	for ( int i = 0; i < 2; i++ )
+	{
+		out->sweep_delay [i] = squares [i]->sweep_delay;
+		out->sweep_freq  [i] = squares [i]->sweep_freq;
+		out->phase       [i] = squares [i]->phase;
+	}
+	out->wave_pos   = wave.wave_pos;
+	out->noise_bits = noise.bits;
+	
+	out->next_frame_time = next_frame_time;
+	out->last_time       = last_time;
+	out->frame_count     = frame_count;
+	memcpy( out->wave, wave.wave, sizeof out->wave );
+	memcpy( out->regs, regs, sizeof out->regs );
+}
+
+void Gb_Apu::load_state( gb_apu_state_t const& in )
+{
+	memcpy( regs, in.regs, sizeof regs );
+	memcpy( wave.wave, in.wave, sizeof wave.wave );
+	next_frame_time = in.next_frame_time;
+	last_time       = in.last_time;
+	frame_count     = in.frame_count;
+	
+	for ( int i = 0; i < osc_count; i++ )
+	{
+		Gb_Osc& osc = *oscs [i];
+		gb_apu_state_t::osc_t const& o = in.oscs [i];
+		osc.delay         = o.delay;
+		osc.last_amp      = o.last_amp;
+		osc.volume        = o.volume;
+		osc.length        = o.length;
+		osc.enabled       = o.enabled;
+		osc.output_select = o.output_select & 3;
+		osc.output        = osc.outputs [osc.output_select];
+	}
+	square1.env_delay = in.oscs [0].env_delay;
+	square2.env_delay = in.oscs [1].env_delay;
+	noise.env_delay   = in.oscs [3].env_delay;
+	
+	Gb_Square* const squares [2] = { &square1, &square2 };
+	for ( int i = 0; i < 2; i++ )
+	{
+		squares [i]->sweep_delay = in.sweep_delay [i];
+		squares [i]->sweep_freq  = in.sweep_freq  [i];
+		squares [i]->phase       = in.phase       [i];
+	}
+	wave.wave_pos = in.wave_pos & (Gb_Wave::wave_size - 1);
+	noise.bits    = in.noise_bits;
+	
+	update_volume();
+}
+
 void Gb_Apu::run_until( blip_time_t end_time )
 {
 	require( end_time >= last_time ); // end_time must not be before previous time
@@ -149,6 +223,17 @@ void Gb_Apu::run_until( blip_time_t end_time )
 				if ( osc.enabled && osc.volume &&
 						(!(osc.regs [4] & osc.len_enabled_mask) || osc.length) )
 					playing = -1;
+				if ( fast_forward_ )
+				{
+					switch ( i )
+					{
+					case 0: square1.skip( last_time, time, playing ); break;
+					case 1: square2.skip( last_time, time, playing ); break;
+					case 2: wave   .skip( last_time, time, playing ); break;
+					case 3: noise  .skip( last_time, time, playing ); break;
+					}
+					continue;
+				}
 				switch ( i )
 				{
 				case 0: square1.run( last_time, time, playing ); break;
@@ -222,16 +307,16 @@ void Gb_Apu::write_register( blip_time_t time, unsigned addr, int data )
 			Gb_Osc& osc = *oscs [i];
 			int amp = osc.last_amp;
 			osc.last_amp = 0;
-			if ( amp && osc.enabled && osc.output )
+			if ( amp && osc.enabled && osc.output && !fast_forward_ )
 				other_synth.offset( time, -amp, osc.output );
 		}
 		
-		if ( wave.outputs [3] )
+		if ( wave.outputs [3] && !fast_forward_ )
 			other_synth.offset( time, 30, wave.outputs [3] );
 		
 		update_volume();
 		
-		if ( wave.outputs [3] )
+		if ( wave.outputs [3] && !fast_forward_ )
 			other_synth.offset( time, -30, wave.outputs [3] );
 		
 		// oscs will update with new amplitude when next run
@@ -254,7 +339,7 @@ void Gb_Apu::write_register( blip_time_t time, unsigned addr, int data )
 			{
 				int amp = osc.last_amp;
 				osc.last_amp = 0;
-				if ( amp && old_output )
+				if ( amp && old_output && !fast_forward_ )
 					other_synth.offset( time, -amp, old_output );
 			}
 		}
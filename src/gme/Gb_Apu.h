@@ -6,6 +6,8 @@
 
 #include "Gb_Oscs.h"
 
+struct gb_apu_state_t;
+
 class Gb_Apu {
 public:
 	
@@ -50,6 +52,14 @@ public:
 	
 	void set_tempo( double );
 	
+	// While enabled, oscillators advance exactly as usual but nothing is added
+	// to the output buffers. Used to skip ahead quickly.
+	void fast_forward( bool enable = true ) { fast_forward_ = enable; }
+	
+	// Save/load exact emulation state. Must be called between frames.
+	void save_state( gb_apu_state_t* out ) const;
+	void load_state( gb_apu_state_t const& );
+	
 public:
 	Gb_Apu();
 private:
@@ -63,6 +73,7 @@ private:
 	blip_time_t frame_period;
 	double      volume_unit;
 	int         frame_count;
+	bool        fast_forward_;
 	
 	Gb_Square   square1;
 	Gb_Square   square2;
@@ -77,6 +88,32 @@ private:
 	void write_osc( int index, int reg, int data );
 };
 
+// Only valid for the build it was saved by (not a portable file format)
+struct gb_apu_state_t
+{
+	struct osc_t
+	{
+		int delay;
+		int last_amp;
+		int volume;
+		int length;
+		int enabled;
+		int output_select;
+		int env_delay;
+	};
+	osc_t oscs [Gb_Apu::osc_count];
+	int sweep_delay [2];
+	int sweep_freq [2];
+	int phase [2];
+	int wave_pos;
+	unsigned noise_bits;
+	blip_time_t next_frame_time;
+	blip_time_t last_time;
+	int frame_count;
+	BOOST::uint8_t wave [Gb_Wave::wave_size];
+	BOOST::uint8_t regs [Gb_Apu::register_count];
+};
+
 inline void Gb_Apu::output( Blip_Buffer* b ) { output( b, b, b ); }
 	
 inline void Gb_Apu::osc_output( int i, Blip_Buffer* b ) { osc_output( i, b, b, b ); }
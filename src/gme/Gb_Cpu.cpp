@@ -89,6 +89,24 @@ unsigned const n_flag = 0x40;
 unsigned const h_flag = 0x20;
 unsigned const c_flag = 0x10;
 
+// Computed goto dispatch jumps straight from the end of each instruction to the
+// next handler through a label table, rather than through a single switch
+// branch. Only GCC and compatibles support taking the address of a label.
+#if GB_CPU_COMPUTED_GOTO && !defined (__GNUC__)
+	#undef GB_CPU_COMPUTED_GOTO
+#endif
+
+#if GB_CPU_COMPUTED_GOTO
+	#define CASE( n )   op_##n
+	#define OP_ROW( n ) \
+		&&op_0x##n##0, &&op_0x##n##1, &&op_0x##n##2, &&op_0x##n##3,\
+		&&op_0x##n##4, &&op_0x##n##5, &&op_0x##n##6, &&op_0x##n##7,\
+		&&op_0x##n##8, &&op_0x##n##9, &&op_0x##n##A, &&op_0x##n##B,\
+		&&op_0x##n##C, &&op_0x##n##D, &&op_0x##n##E, &&op_0x##n##F
+#else
+	#define CASE( n )   case n
+#endif
+
 bool Gb_Cpu::run( blargg_long cycle_count )
 {
 	state_.remain = blargg_ulong (cycle_count + clocks_per_instr) / clocks_per_instr;
@@ -123,115 +141,142 @@ bool Gb_Cpu::run( blargg_long cycle_count )
 	unsigned sp = r.sp;
 	unsigned flags = r.flags;
 	
-loop:
-	
-	check( (unsigned long) pc < 0x10000 );
-	check( (unsigned long) sp < 0x10000 );
-	check( (flags & ~0xF0) == 0 );
-	
-	uint8_t const* instr = s.code_map [pc >> page_shift];
+	uint8_t const* instr;
 	unsigned op;
+	unsigned data;
+	
+// Fetches opcode at pc into op and the byte following it into data, leaving
+// instr pointing at that byte
+#define FETCH_INSTR()\
+{\
+	check( (unsigned long) pc < 0x10000 );\
+	check( (unsigned long) sp < 0x10000 );\
+	check( (flags & ~0xF0) == 0 );\
+	\
+	instr = s.code_map [pc >> page_shift];\
+	READ_OP();\
+	\
+	if ( !--s.remain )\
+		goto stop;\
+	\
+	data = *instr;\
+	LOG_INSTR();\
+}
 	
 	// TODO: eliminate this special case
 	#if BLARGG_NONPORTABLE
-		op = instr [pc];
-		pc++;
-		instr += pc;
+		#define READ_OP() (op = instr [pc], pc++, instr += pc)
 	#else
-		instr += PAGE_OFFSET( pc );
-		op = *instr++;
-		pc++;
+		#define READ_OP() (instr += PAGE_OFFSET( pc ), op = *instr++, pc++)
+	#endif
+	
+	#ifdef GB_CPU_LOG_H
+		#define LOG_INSTR() gb_cpu_log( "new", pc - 1, op, data, instr [1] )
+	#else
+		#define LOG_INSTR() ((void) 0)
 	#endif
 	
 #define GET_ADDR()  GET_LE16( instr )
 	
-	if ( !--s.remain )
-		goto stop;
+#if GB_CPU_COMPUTED_GOTO
+	static void* const op_table [0x100] = {
+		OP_ROW( 0 ), OP_ROW( 1 ), OP_ROW( 2 ), OP_ROW( 3 ),
+		OP_ROW( 4 ), OP_ROW( 5 ), OP_ROW( 6 ), OP_ROW( 7 ),
+		OP_ROW( 8 ), OP_ROW( 9 ), OP_ROW( A ), OP_ROW( B ),
+		OP_ROW( C ), OP_ROW( D ), OP_ROW( E ), OP_ROW( F )
+	};
 	
-	unsigned data;
-	data = *instr;
+	// Every instruction fetches and jumps to the next one itself rather than
+	// going back through a shared dispatch, so each has its own indirect branch
+	// for the host's predictor to learn
+	#define NEXT_INSTR() { FETCH_INSTR(); goto *op_table [op]; }
 	
-	#ifdef GB_CPU_LOG_H
-		gb_cpu_log( "new", pc - 1, op, data, instr [1] );
-	#endif
+	NEXT_INSTR();
+	{
+#else
+	#define NEXT_INSTR() goto loop
+	
+loop:
+	FETCH_INSTR();
 	
 	switch ( op )
 	{
+#endif
 
 // TODO: more efficient way to handle negative branch that wraps PC around
 #define BRANCH( cond )\
 {\
 	pc++;\
 	int offset = (BOOST::int8_t) data;\
-	if ( !(cond) ) goto loop;\
+	if ( !(cond) ) NEXT_INSTR();\
 	pc = uint16_t (pc + offset);\
-	goto loop;\
+	NEXT_INSTR();\
 }
 
 // Most Common
 
-	case 0x20: // JR NZ
+	CASE( 0x20 ): // JR NZ
 		BRANCH( !(flags & z_flag) )
 	
-	case 0x21: // LD HL,IMM (common)
+	CASE( 0x21 ): // LD HL,IMM (common)
 		rp.hl = GET_ADDR();
 		pc += 2;
-		goto loop;
+		NEXT_INSTR();
 	
-	case 0x28: // JR Z
+	CASE( 0x28 ): // JR Z
 		BRANCH( flags & z_flag )
 	
 	{
 		unsigned temp;
-	case 0xF0: // LD A,(0xFF00+imm)
+	CASE( 0xF0 ): // LD A,(0xFF00+imm)
 		temp = data | 0xFF00;
 		pc++;
 		goto ld_a_ind_comm;
 	
-	case 0xF2: // LD A,(0xFF00+C)
+	CASE( 0xF2 ): // LD A,(0xFF00+C)
 		temp = rg.c | 0xFF00;
 		goto ld_a_ind_comm;
 	
-	case 0x0A: // LD A,(BC)
+	CASE( 0x0A ): // LD A,(BC)
 		temp = rp.bc;
 		goto ld_a_ind_comm;
 	
-	case 0x3A: // LD A,(HL-)
+	CASE( 0x3A ): // LD A,(HL-)
 		temp = rp.hl;
 		rp.hl = temp - 1;
 		goto ld_a_ind_comm;
 	
-	case 0x1A: // LD A,(DE)
+	CASE( 0x1A ): // LD A,(DE)
 		temp = rp.de;
 		goto ld_a_ind_comm;
 	
-	case 0x2A: // LD A,(HL+) (common)
+	CASE( 0x2A ): // LD A,(HL+) (common)
 		temp = rp.hl;
 		rp.hl = temp + 1;
 		goto ld_a_ind_comm;
 		
-	case 0xFA: // LD A,IND16 (common)
+	CASE( 0xFA ): // LD A,IND16 (common)
 		temp = GET_ADDR();
 		pc += 2;
 	ld_a_ind_comm:
 		READ_FAST( temp, rg.a );
-		goto loop;
+		NEXT_INSTR();
 	}
 	
-	case 0xBE: // CMP (HL)
+	CASE( 0xBE ): // CMP (HL)
 		data = READ( rp.hl );
 		goto cmp_comm;
 	
-	case 0xB8: // CMP B
-	case 0xB9: // CMP C
-	case 0xBA: // CMP D
-	case 0xBB: // CMP E
-	case 0xBC: // CMP H
-	case 0xBD: // CMP L
+	CASE( 0xB8 ): // CMP B
+	CASE( 0xB9 ): // CMP C
+	CASE( 0xBA ): // CMP D
+	CASE( 0xBB ): // CMP E
+	CASE( 0xBC ): // CMP H
+	CASE( 0xBD ): // CMP L
 		data = R8( op & 7 );
 		goto cmp_comm;
 	
-	case 0xFE: // CMP IMM
+	CASE( 0xFE ): // CMP IMM
 		pc++;
 	cmp_comm:
 		op = rg.a;
@@ -241,29 +286,29 @@ loop:
 		flags |= (data >> 4) & c_flag;
 		flags |= n_flag;
 		if ( data & 0xFF )
-			goto loop;
+			NEXT_INSTR();
 		flags |= z_flag;
-		goto loop;
+		NEXT_INSTR();
 
-	case 0x46: // LD B,(HL)
-	case 0x4E: // LD C,(HL)
-	case 0x56: // LD D,(HL)
-	case 0x5E: // LD E,(HL)
-	case 0x66: // LD H,(HL)
-	case 0x6E: // LD L,(HL)
-	case 0x7E:{// LD A,(HL)
+	CASE( 0x46 ): // LD B,(HL)
+	CASE( 0x4E ): // LD C,(HL)
+	CASE( 0x56 ): // LD D,(HL)
+	CASE( 0x5E ): // LD E,(HL)
+	CASE( 0x66 ): // LD H,(HL)
+	CASE( 0x6E ): // LD L,(HL)
+	CASE( 0x7E ):{// LD A,(HL)
 		unsigned addr = rp.hl;
 		READ_FAST( addr, R8( (op >> 3) & 7 ) );
-		goto loop;
+		NEXT_INSTR();
 	}
 	
-	case 0xC4: // CNZ (next-most-common)
+	CASE( 0xC4 ): // CNZ (next-most-common)
 		pc += 2;
 		if ( flags & z_flag )
-			goto loop;
+			NEXT_INSTR();
 	call:
 		pc -= 2;
-	case 0xCD: // CALL (most-common)
+	CASE( 0xCD ): // CALL (most-common)
 		data = pc + 2;
 		pc = GET_ADDR();
 	push:
@@ -271,31 +316,31 @@ loop:
 		WRITE( sp, data >> 8 );
 		sp = (sp - 1) & 0xFFFF;
 		WRITE( sp, data & 0xFF );
-		goto loop;
+		NEXT_INSTR();
 	
-	case 0xC8: // RNZ (next-most-common)
+	CASE( 0xC8 ): // RNZ (next-most-common)
 		if ( !(flags & z_flag) )
-			goto loop;
-	case 0xC9: // RET (most common)
+			NEXT_INSTR();
+	CASE( 0xC9 ): // RET (most common)
 	ret:
 		pc = READ( sp );
 		pc += 0x100 * READ( sp + 1 );
 		sp = (sp + 2) & 0xFFFF;
-		goto loop;
-	
-	case 0x00: // NOP
-	case 0x40: // LD B,B
-	case 0x49: // LD C,C
-	case 0x52: // LD D,D
-	case 0x5B: // LD E,E
-	case 0x64: // LD H,H
-	case 0x6D: // LD L,L
-	case 0x7F: // LD A,A
-		goto loop;
+		NEXT_INSTR();
+	
+	CASE( 0x00 ): // NOP
+	CASE( 0x40 ): // LD B,B
+	CASE( 0x49 ): // LD C,C
+	CASE( 0x52 ): // LD D,D
+	CASE( 0x5B ): // LD E,E
+	CASE( 0x64 ): // LD H,H
+	CASE( 0x6D ): // LD L,L
+	CASE( 0x7F ): // LD A,A
+		NEXT_INSTR();
 	
 // CB Instructions
 
-	case 0xCB:
+	CASE( 0xCB ):
 		pc++;
 		// now data is the opcode
 		switch ( data ) {
@@ -336,7 +381,7 @@ loop:
 			flags &= ~n_flag;
 			flags |= h_flag | z_flag;
 			flags ^= (temp << bit) & z_flag;
-			goto loop;
+			NEXT_INSTR();
 		}
 		
 		case 0x86: // RES b,(HL)
@@ -361,7 +406,7 @@ loop:
 			if ( !(data & 0x40) )
 				bit = 0;
 			WRITE( rp.hl, temp | bit );
-			goto loop;
+			NEXT_INSTR();
 		}
 		
 		case 0xC0: case 0xC1: case 0xC2: case 0xC3: // SET b,r
@@ -379,7 +424,7 @@ loop:
 		case 0xF7: case 0xF8: case 0xF9: case 0xFA:
 		case 0xFB: case 0xFC: case 0xFD: case 0xFF:
 			R8( data & 7 ) |= 1 << ((data >> 3) & 7);
-			goto loop;
+			NEXT_INSTR();
 
 		case 0x80: case 0x81: case 0x82: case 0x83: // RES b,r
 		case 0x84: case 0x85: case 0x87: case 0x88:
@@ -396,7 +441,7 @@ loop:
 		case 0xB7: case 0xB8: case 0xB9: case 0xBA:
 		case 0xBB: case 0xBC: case 0xBD: case 0xBF:
 			R8( data & 7 ) &= ~(1 << ((data >> 3) & 7));
-			goto loop;
+			NEXT_INSTR();
 		
 		{
 			int temp;
@@ -451,8 +496,8 @@ loop:
 	} // CB op
 	assert( false ); // unhandled CB op
 
-	case 0x07: // RLCA
-	case 0x17: // RLA
+	CASE( 0x07 ): // RLCA
+	CASE( 0x17 ): // RLA
 		data = op;
 		op = rg.a;
 	rl_comm:
@@ -464,8 +509,8 @@ loop:
 		// SLA doesn't fill lower bit
 		goto shift_comm;
 	
-	case 0x0F: // RRCA
-	case 0x1F: // RRA
+	CASE( 0x0F ): // RRCA
+	CASE( 0x1F ): // RRA
 		data = op;
 		op = rg.a;
 	rr_comm:
@@ -483,197 +528,197 @@ loop:
 		if ( data == 6 )
 			goto write_hl_op_ff;
 		R8( data ) = op;
-		goto loop;
+		NEXT_INSTR();
 
 // Load
 
-	case 0x70: // LD (HL),B
-	case 0x71: // LD (HL),C
-	case 0x72: // LD (HL),D
-	case 0x73: // LD (HL),E
-	case 0x74: // LD (HL),H
-	case 0x75: // LD (HL),L
-	case 0x77: // LD (HL),A
+	CASE( 0x70 ): // LD (HL),B
+	CASE( 0x71 ): // LD (HL),C
+	CASE( 0x72 ): // LD (HL),D
+	CASE( 0x73 ): // LD (HL),E
+	CASE( 0x74 ): // LD (HL),H
+	CASE( 0x75 ): // LD (HL),L
+	CASE( 0x77 ): // LD (HL),A
 		op = R8( op & 7 );
 	write_hl_op_ff:
 		WRITE( rp.hl, op & 0xFF );
-		goto loop;
+		NEXT_INSTR();
 
-	case 0x41: case 0x42: case 0x43: case 0x44: case 0x45: case 0x47: // LD r,r
-	case 0x48: case 0x4A: case 0x4B: case 0x4C: case 0x4D: case 0x4F:
-	case 0x50: case 0x51: case 0x53: case 0x54: case 0x55: case 0x57:
-	case 0x58: case 0x59: case 0x5A: case 0x5C: case 0x5D: case 0x5F:
-	case 0x60: case 0x61: case 0x62: case 0x63: case 0x65: case 0x67:
-	case 0x68: case 0x69: case 0x6A: case 0x6B: case 0x6C: case 0x6F:
-	case 0x78: case 0x79: case 0x7A: case 0x7B: case 0x7C: case 0x7D:
+	CASE( 0x41 ): CASE( 0x42 ): CASE( 0x43 ): CASE( 0x44 ): CASE( 0x45 ): CASE( 0x47 ): // LD r,r
+	CASE( 0x48 ): CASE( 0x4A ): CASE( 0x4B ): CASE( 0x4C ): CASE( 0x4D ): CASE( 0x4F ):
+	CASE( 0x50 ): CASE( 0x51 ): CASE( 0x53 ): CASE( 0x54 ): CASE( 0x55 ): CASE( 0x57 ):
+	CASE( 0x58 ): CASE( 0x59 ): CASE( 0x5A ): CASE( 0x5C ): CASE( 0x5D ): CASE( 0x5F ):
+	CASE( 0x60 ): CASE( 0x61 ): CASE( 0x62 ): CASE( 0x63 ): CASE( 0x65 ): CASE( 0x67 ):
+	CASE( 0x68 ): CASE( 0x69 ): CASE( 0x6A ): CASE( 0x6B ): CASE( 0x6C ): CASE( 0x6F ):
+	CASE( 0x78 ): CASE( 0x79 ): CASE( 0x7A ): CASE( 0x7B ): CASE( 0x7C ): CASE( 0x7D ):
 		R8( (op >> 3) & 7 ) = R8( op & 7 );
-		goto loop;
+		NEXT_INSTR();
 
-	case 0x08: // LD IND16,SP
+	CASE( 0x08 ): // LD IND16,SP
 		data = GET_ADDR();
 		pc += 2;
 		WRITE( data, sp&0xFF );
 		data++;
 		WRITE( data, sp >> 8 );
-		goto loop;
+		NEXT_INSTR();
 	
-	case 0xF9: // LD SP,HL
+	CASE( 0xF9 ): // LD SP,HL
 		sp = rp.hl;
-		goto loop;
+		NEXT_INSTR();
 
-	case 0x31: // LD SP,IMM
+	CASE( 0x31 ): // LD SP,IMM
 		sp = GET_ADDR();
 		pc += 2;
-		goto loop;
+		NEXT_INSTR();
 	
-	case 0x01: // LD BC,IMM
-	case 0x11: // LD DE,IMM
+	CASE( 0x01 ): // LD BC,IMM
+	CASE( 0x11 ): // LD DE,IMM
 		r16 [op >> 4] = GET_ADDR();
 		pc += 2;
-		goto loop;
+		NEXT_INSTR();
 	
 	{
 		unsigned temp;
-	case 0xE0: // LD (0xFF00+imm),A
+	CASE( 0xE0 ): // LD (0xFF00+imm),A
 		temp = data | 0xFF00;
 		pc++;
 		goto write_data_rg_a;
 	
-	case 0xE2: // LD (0xFF00+C),A
+	CASE( 0xE2 ): // LD (0xFF00+C),A
 		temp = rg.c | 0xFF00;
 		goto write_data_rg_a;
 
-	case 0x32: // LD (HL-),A
+	CASE( 0x32 ): // LD (HL-),A
 		temp = rp.hl;
 		rp.hl = temp - 1;
 		goto write_data_rg_a;
 	
-	case 0x02: // LD (BC),A
+	CASE( 0x02 ): // LD (BC),A
 		temp = rp.bc;
 		goto write_data_rg_a;
 	
-	case 0x12: // LD (DE),A
+	CASE( 0x12 ): // LD (DE),A
 		temp = rp.de;
 		goto write_data_rg_a;
 	
-	case 0x22: // LD (HL+),A
+	CASE( 0x22 ): // LD (HL+),A
 		temp = rp.hl;
 		rp.hl = temp + 1;
 		goto write_data_rg_a;
 		
-	case 0xEA: // LD IND16,A (common)
+	CASE( 0xEA ): // LD IND16,A (common)
 		temp = GET_ADDR();
 		pc += 2;
 	write_data_rg_a:
 		WRITE( temp, rg.a );
-		goto loop;
+		NEXT_INSTR();
 	}
 	
-	case 0x06: // LD B,IMM
+	CASE( 0x06 ): // LD B,IMM
 		rg.b = data;
 		pc++;
-		goto loop;
+		NEXT_INSTR();
 	
-	case 0x0E: // LD C,IMM
+	CASE( 0x0E ): // LD C,IMM
 		rg.c = data;
 		pc++;
-		goto loop;
+		NEXT_INSTR();
 	
-	case 0x16: // LD D,IMM
+	CASE( 0x16 ): // LD D,IMM
 		rg.d = data;
 		pc++;
-		goto loop;
+		NEXT_INSTR();
 	
-	case 0x1E: // LD E,IMM
+	CASE( 0x1E ): // LD E,IMM
 		rg.e = data;
 		pc++;
-		goto loop;
+		NEXT_INSTR();
 	
-	case 0x26: // LD H,IMM
+	CASE( 0x26 ): // LD H,IMM
 		rg.h = data;
 		pc++;
-		goto loop;
+		NEXT_INSTR();
 	
-	case 0x2E: // LD L,IMM
+	CASE( 0x2E ): // LD L,IMM
 		rg.l = data;
 		pc++;
-		goto loop;
+		NEXT_INSTR();
 	
-	case 0x36: // LD (HL),IMM
+	CASE( 0x36 ): // LD (HL),IMM
 		WRITE( rp.hl, data );
 		pc++;
-		goto loop;
+		NEXT_INSTR();
 	
-	case 0x3E: // LD A,IMM
+	CASE( 0x3E ): // LD A,IMM
 		rg.a = data;
 		pc++;
-		goto loop;
+		NEXT_INSTR();
 
 // Increment/Decrement
 
-	case 0x03: // INC BC
-	case 0x13: // INC DE
-	case 0x23: // INC HL
+	CASE( 0x03 ): // INC BC
+	CASE( 0x13 ): // INC DE
+	CASE( 0x23 ): // INC HL
 		r16 [op >> 4]++;
-		goto loop;
+		NEXT_INSTR();
 	
-	case 0x33: // INC SP
+	CASE( 0x33 ): // INC SP
 		sp = (sp + 1) & 0xFFFF;
-		goto loop;
+		NEXT_INSTR();
 
-	case 0x0B: // DEC BC
-	case 0x1B: // DEC DE
-	case 0x2B: // DEC HL
+	CASE( 0x0B ): // DEC BC
+	CASE( 0x1B ): // DEC DE
+	CASE( 0x2B ): // DEC HL
 		r16 [op >> 4]--;
-		goto loop;
+		NEXT_INSTR();
 	
-	case 0x3B: // DEC SP
+	CASE( 0x3B ): // DEC SP
 		sp = (sp - 1) & 0xFFFF;
-		goto loop;
+		NEXT_INSTR();
 	
-	case 0x34: // INC (HL)
+	CASE( 0x34 ): // INC (HL)
 		op = rp.hl;
 		data = READ( op );
 		data++;
 		WRITE( op, data & 0xFF );
 		goto inc_comm;
 	
-	case 0x04: // INC B
-	case 0x0C: // INC C (common)
-	case 0x14: // INC D
-	case 0x1C: // INC E
-	case 0x24: // INC H
-	case 0x2C: // INC L
-	case 0x3C: // INC A
+	CASE( 0x04 ): // INC B
+	CASE( 0x0C ): // INC C (common)
+	CASE( 0x14 ): // INC D
+	CASE( 0x1C ): // INC E
+	CASE( 0x24 ): // INC H
+	CASE( 0x2C ): // INC L
+	CASE( 0x3C ): // INC A
 		op = (op >> 3) & 7;
 		R8( op ) = data = R8( op ) + 1;
 	inc_comm:
 		flags = (flags & c_flag) | (((data & 15) - 1) & h_flag) | ((data >> 1) & z_flag);
-		goto loop;
+		NEXT_INSTR();
 	
-	case 0x35: // DEC (HL)
+	CASE( 0x35 ): // DEC (HL)
 		op = rp.hl;
 		data = READ( op );
 		data--;
 		WRITE( op, data & 0xFF );
 		goto dec_comm;
 	
-	case 0x05: // DEC B
-	case 0x0D: // DEC C
-	case 0x15: // DEC D
-	case 0x1D: // DEC E
-	case 0x25: // DEC H
-	case 0x2D: // DEC L
-	case 0x3D: // DEC A
+	CASE( 0x05 ): // DEC B
+	CASE( 0x0D ): // DEC C
+	CASE( 0x15 ): // DEC D
+	CASE( 0x1D ): // DEC E
+	CASE( 0x25 ): // DEC H
+	CASE( 0x2D ): // DEC L
+	CASE( 0x3D ): // DEC A
 		op = (op >> 3) & 7;
 		data = R8( op ) - 1;
 		R8( op ) = data;
 	dec_comm:
 		flags = (flags & c_flag) | n_flag | (((data & 15) + 0x31) & h_flag);
 		if ( data & 0xFF )
-			goto loop;
+			NEXT_INSTR();
 		flags |= z_flag;
-		goto loop;
+		NEXT_INSTR();
 
 // Add 16-bit
 
@@ -681,7 +726,7 @@ loop:
 		blargg_ulong temp; // need more than 16 bits for carry
 		unsigned prev;
 		
-	case 0xF8: // LD HL,SP+imm
+	CASE( 0xF8 ): // LD HL,SP+imm
 		temp = BOOST::int8_t (data); // sign-extend to 16 bits
 		pc++;
 		flags = 0;
@@ -689,7 +734,7 @@ loop:
 		prev = sp;
 		goto add_16_hl;
 	
-	case 0xE8: // ADD SP,IMM
+	CASE( 0xE8 ): // ADD SP,IMM
 		temp = BOOST::int8_t (data); // sign-extend to 16 bits
 		pc++;
 		flags = 0;
@@ -698,13 +743,13 @@ loop:
 		sp = temp & 0xFFFF;
 		goto add_16_comm;
 
-	case 0x39: // ADD HL,SP
+	CASE( 0x39 ): // ADD HL,SP
 		temp = sp;
 		goto add_hl_comm;
 	
-	case 0x09: // ADD HL,BC
-	case 0x19: // ADD HL,DE
-	case 0x29: // ADD HL,HL
+	CASE( 0x09 ): // ADD HL,BC
+	CASE( 0x19 ): // ADD HL,DE
+	CASE( 0x29 ): // ADD HL,HL
 		temp = r16 [op >> 4];
 	add_hl_comm:
 		prev = rp.hl;
@@ -715,24 +760,24 @@ loop:
 	add_16_comm:
 		flags |= (temp >> 12) & c_flag;
 		flags |= (((temp & 0x0FFF) - (prev & 0x0FFF)) >> 7) & h_flag;
-		goto loop;
+		NEXT_INSTR();
 	}
 	
-	case 0x86: // ADD (HL)
+	CASE( 0x86 ): // ADD (HL)
 		data = READ( rp.hl );
 		goto add_comm;
 	
-	case 0x80: // ADD B
-	case 0x81: // ADD C
-	case 0x82: // ADD D
-	case 0x83: // ADD E
-	case 0x84: // ADD H
-	case 0x85: // ADD L
-	case 0x87: // ADD A
+	CASE( 0x80 ): // ADD B
+	CASE( 0x81 ): // ADD C
+	CASE( 0x82 ): // ADD D
+	CASE( 0x83 ): // ADD E
+	CASE( 0x84 ): // ADD H
+	CASE( 0x85 ): // ADD L
+	CASE( 0x87 ): // ADD A
 		data = R8( op & 7 );
 		goto add_comm;
 	
-	case 0xC6: // ADD IMM
+	CASE( 0xC6 ): // ADD IMM
 		pc++;
 	add_comm:
 		flags = rg.a;
@@ -741,48 +786,48 @@ loop:
 		flags |= (data >> 4) & c_flag;
 		rg.a = data;
 		if ( data & 0xFF )
-			goto loop;
+			NEXT_INSTR();
 		flags |= z_flag;
-		goto loop;
+		NEXT_INSTR();
 
 // Add/Subtract
 
-	case 0x8E: // ADC (HL)
+	CASE( 0x8E ): // ADC (HL)
 		data = READ( rp.hl );
 		goto adc_comm;
 	
-	case 0x88: // ADC B
-	case 0x89: // ADC C
-	case 0x8A: // ADC D
-	case 0x8B: // ADC E
-	case 0x8C: // ADC H
-	case 0x8D: // ADC L
-	case 0x8F: // ADC A
+	CASE( 0x88 ): // ADC B
+	CASE( 0x89 ): // ADC C
+	CASE( 0x8A ): // ADC D
+	CASE( 0x8B ): // ADC E
+	CASE( 0x8C ): // ADC H
+	CASE( 0x8D ): // ADC L
+	CASE( 0x8F ): // ADC A
 		data = R8( op & 7 );
 		goto adc_comm;
 	
-	case 0xCE: // ADC IMM
+	CASE( 0xCE ): // ADC IMM
 		pc++;
 	adc_comm:
 		data += (flags >> 4) & 1;
 		data &= 0xFF; // to do: does carry get set when sum + carry = 0x100?
 		goto add_comm;
 
-	case 0x96: // SUB (HL)
+	CASE( 0x96 ): // SUB (HL)
 		data = READ( rp.hl );
 		goto sub_comm;
 	
-	case 0x90: // SUB B
-	case 0x91: // SUB C
-	case 0x92: // SUB D
-	case 0x93: // SUB E
-	case 0x94: // SUB H
-	case 0x95: // SUB L
-	case 0x97: // SUB A
+	CASE( 0x90 ): // SUB B
+	CASE( 0x91 ): // SUB C
+	CASE( 0x92 ): // SUB D
+	CASE( 0x93 ): // SUB E
+	CASE( 0x94 ): // SUB H
+	CASE( 0x95 ): // SUB L
+	CASE( 0x97 ): // SUB A
 		data = R8( op & 7 );
 		goto sub_comm;
 	
-	case 0xD6: // SUB IMM
+	CASE( 0xD6 ): // SUB IMM
 		pc++;
 	sub_comm:
 		op = rg.a;
@@ -790,21 +835,21 @@ loop:
 		rg.a = data;
 		goto sub_set_flags;
 
-	case 0x9E: // SBC (HL)
+	CASE( 0x9E ): // SBC (HL)
 		data = READ( rp.hl );
 		goto sbc_comm;
 	
-	case 0x98: // SBC B
-	case 0x99: // SBC C
-	case 0x9A: // SBC D
-	case 0x9B: // SBC E
-	case 0x9C: // SBC H
-	case 0x9D: // SBC L
-	case 0x9F: // SBC A
+	CASE( 0x98 ): // SBC B
+	CASE( 0x99 ): // SBC C
+	CASE( 0x9A ): // SBC D
+	CASE( 0x9B ): // SBC E
+	CASE( 0x9C ): // SBC H
+	CASE( 0x9D ): // SBC L
+	CASE( 0x9F ): // SBC A
 		data = R8( op & 7 );
 		goto sbc_comm;
 	
-	case 0xDE: // SBC IMM
+	CASE( 0xDE ): // SBC IMM
 		pc++;
 	sbc_comm:
 		data += (flags >> 4) & 1;
@@ -813,226 +858,226 @@ loop:
 
 // Logical
 
-	case 0xA0: // AND B
-	case 0xA1: // AND C
-	case 0xA2: // AND D
-	case 0xA3: // AND E
-	case 0xA4: // AND H
-	case 0xA5: // AND L
+	CASE( 0xA0 ): // AND B
+	CASE( 0xA1 ): // AND C
+	CASE( 0xA2 ): // AND D
+	CASE( 0xA3 ): // AND E
+	CASE( 0xA4 ): // AND H
+	CASE( 0xA5 ): // AND L
 		data = R8( op & 7 );
 		goto and_comm;
 	
-	case 0xA6: // AND (HL)
+	CASE( 0xA6 ): // AND (HL)
 		data = READ( rp.hl );
 		pc--;
-	case 0xE6: // AND IMM
+	CASE( 0xE6 ): // AND IMM
 		pc++;
 	and_comm:
 		rg.a &= data;
-	case 0xA7: // AND A
+	CASE( 0xA7 ): // AND A
 		flags = h_flag | (((rg.a - 1) >> 1) & z_flag);
-		goto loop;
+		NEXT_INSTR();
 
-	case 0xB0: // OR B
-	case 0xB1: // OR C
-	case 0xB2: // OR D
-	case 0xB3: // OR E
-	case 0xB4: // OR H
-	case 0xB5: // OR L
+	CASE( 0xB0 ): // OR B
+	CASE( 0xB1 ): // OR C
+	CASE( 0xB2 ): // OR D
+	CASE( 0xB3 ): // OR E
+	CASE( 0xB4 ): // OR H
+	CASE( 0xB5 ): // OR L
 		data = R8( op & 7 );
 		goto or_comm;
 	
-	case 0xB6: // OR (HL)
+	CASE( 0xB6 ): // OR (HL)
 		data = READ( rp.hl );
 		pc--;
-	case 0xF6: // OR IMM
+	CASE( 0xF6 ): // OR IMM
 		pc++;
 	or_comm:
 		rg.a |= data;
-	case 0xB7: // OR A
+	CASE( 0xB7 ): // OR A
 		flags = ((rg.a - 1) >> 1) & z_flag;
-		goto loop;
+		NEXT_INSTR();
 
-	case 0xA8: // XOR B
-	case 0xA9: // XOR C
-	case 0xAA: // XOR D
-	case 0xAB: // XOR E
-	case 0xAC: // XOR H
-	case 0xAD: // XOR L
+	CASE( 0xA8 ): // XOR B
+	CASE( 0xA9 ): // XOR C
+	CASE( 0xAA ): // XOR D
+	CASE( 0xAB ): // XOR E
+	CASE( 0xAC ): // XOR H
+	CASE( 0xAD ): // XOR L
 		data = R8( op & 7 );
 		goto xor_comm;
 	
-	case 0xAE: // XOR (HL)
+	CASE( 0xAE ): // XOR (HL)
 		data = READ( rp.hl );
 		pc--;
-	case 0xEE: // XOR IMM
+	CASE( 0xEE ): // XOR IMM
 		pc++;
 	xor_comm:
 		data ^= rg.a;
 		rg.a = data;
 		data--;
 		flags = (data >> 1) & z_flag;
-		goto loop;
+		NEXT_INSTR();
 	
-	case 0xAF: // XOR A
+	CASE( 0xAF ): // XOR A
 		rg.a = 0;
 		flags = z_flag;
-		goto loop;
+		NEXT_INSTR();
 
 // Stack
 
-	case 0xF1: // POP FA
-	case 0xC1: // POP BC
-	case 0xD1: // POP DE
-	case 0xE1: // POP HL (common)
+	CASE( 0xF1 ): // POP FA
+	CASE( 0xC1 ): // POP BC
+	CASE( 0xD1 ): // POP DE
+	CASE( 0xE1 ): // POP HL (common)
 		data = READ( sp );
 		r16 [(op >> 4) & 3] = data + 0x100 * READ( sp + 1 );
 		sp = (sp + 2) & 0xFFFF;
 		if ( op != 0xF1 )
-			goto loop;
+			NEXT_INSTR();
 		flags = rg.flags & 0xF0;
-		goto loop;
+		NEXT_INSTR();
 	
-	case 0xC5: // PUSH BC
+	CASE( 0xC5 ): // PUSH BC
 		data = rp.bc;
 		goto push;
 	
-	case 0xD5: // PUSH DE
+	CASE( 0xD5 ): // PUSH DE
 		data = rp.de;
 		goto push;
 	
-	case 0xE5: // PUSH HL
+	CASE( 0xE5 ): // PUSH HL
 		data = rp.hl;
 		goto push;
 	
-	case 0xF5: // PUSH FA
+	CASE( 0xF5 ): // PUSH FA
 		data = (flags << 8) | rg.a;
 		goto push;
 
 // Flow control
 	
-	case 0xFF:
+	CASE( 0xFF ):
 		if ( pc == idle_addr + 1 )
 			goto stop;
-	case 0xC7: case 0xCF: case 0xD7: case 0xDF:  // RST
-	case 0xE7: case 0xEF: case 0xF7:
+	CASE( 0xC7 ): CASE( 0xCF ): CASE( 0xD7 ): CASE( 0xDF ):  // RST
+	CASE( 0xE7 ): CASE( 0xEF ): CASE( 0xF7 ):
 		data = pc;
 		pc = (op & 0x38) + rst_base;
 		goto push;
 	
-	case 0xCC: // CZ
+	CASE( 0xCC ): // CZ
 		pc += 2;
 		if ( flags & z_flag )
 			goto call;
-		goto loop;
+		NEXT_INSTR();
 	
-	case 0xD4: // CNC
+	CASE( 0xD4 ): // CNC
 		pc += 2;
 		if ( !(flags & c_flag) )
 			goto call;
-		goto loop;
+		NEXT_INSTR();
 	
-	case 0xDC: // CC
+	CASE( 0xDC ): // CC
 		pc += 2;
 		if ( flags & c_flag )
 			goto call;
-		goto loop;
+		NEXT_INSTR();
 
-	case 0xD9: // RETI
+	CASE( 0xD9 ): // RETI
 		//interrupts_enabled = 1;
 		goto ret;
 	
-	case 0xC0: // RZ
+	CASE( 0xC0 ): // RZ
 		if ( !(flags & z_flag) )
 			goto ret;
-		goto loop;
+		NEXT_INSTR();
 	
-	case 0xD0: // RNC
+	CASE( 0xD0 ): // RNC
 		if ( !(flags & c_flag) )
 			goto ret;
-		goto loop;
+		NEXT_INSTR();
 	
-	case 0xD8: // RC
+	CASE( 0xD8 ): // RC
 		if ( flags & c_flag )
 			goto ret;
-		goto loop;
+		NEXT_INSTR();
 
-	case 0x18: // JR
+	CASE( 0x18 ): // JR
 		BRANCH( true )
 	
-	case 0x30: // JR NC
+	CASE( 0x30 ): // JR NC
 		BRANCH( !(flags & c_flag) )
 	
-	case 0x38: // JR C
+	CASE( 0x38 ): // JR C
 		BRANCH( flags & c_flag )
 	
-	case 0xE9: // JP_HL
+	CASE( 0xE9 ): // JP_HL
 		pc = rp.hl;
-		goto loop;
+		NEXT_INSTR();
 
-	case 0xC3: // JP (next-most-common)
+	CASE( 0xC3 ): // JP (next-most-common)
 		pc = GET_ADDR();
-		goto loop;
+		NEXT_INSTR();
 	
-	case 0xC2: // JP NZ
+	CASE( 0xC2 ): // JP NZ
 		pc += 2;
 		if ( !(flags & z_flag) )
 			goto jp_taken;
-		goto loop;
+		NEXT_INSTR();
 	
-	case 0xCA: // JP Z (most common)
+	CASE( 0xCA ): // JP Z (most common)
 		pc += 2;
 		if ( !(flags & z_flag) )
-			goto loop;
+			NEXT_INSTR();
 	jp_taken:
 		pc -= 2;
 		pc = GET_ADDR();
-		goto loop;
+		NEXT_INSTR();
 	
-	case 0xD2: // JP NC
+	CASE( 0xD2 ): // JP NC
 		pc += 2;
 		if ( !(flags & c_flag) )
 			goto jp_taken;
-		goto loop;
+		NEXT_INSTR();
 	
-	case 0xDA: // JP C
+	CASE( 0xDA ): // JP C
 		pc += 2;
 		if ( flags & c_flag )
 			goto jp_taken;
-		goto loop;
+		NEXT_INSTR();
 
 // Flags
 
-	case 0x2F: // CPL
+	CASE( 0x2F ): // CPL
 		rg.a = ~rg.a;
 		flags |= n_flag | h_flag;
-		goto loop;
+		NEXT_INSTR();
 
-	case 0x3F: // CCF
+	CASE( 0x3F ): // CCF
 		flags = (flags ^ c_flag) & ~(n_flag | h_flag);
-		goto loop;
+		NEXT_INSTR();
 
-	case 0x37: // SCF
+	CASE( 0x37 ): // SCF
 		flags = (flags | c_flag) & ~(n_flag | h_flag);
-		goto loop;
+		NEXT_INSTR();
 
-	case 0xF3: // DI
+	CASE( 0xF3 ): // DI
 		//interrupts_enabled = 0;
-		goto loop;
+		NEXT_INSTR();
 
-	case 0xFB: // EI
+	CASE( 0xFB ): // EI
 		//interrupts_enabled = 1;
-		goto loop;
+		NEXT_INSTR();
 
 // Special
 
-	case 0xDD: case 0xD3: case 0xDB: case 0xE3: case 0xE4: // ?
-	case 0xEB: case 0xEC: case 0xF4: case 0xFD: case 0xFC:
-	case 0x10: // STOP
-	case 0x27: // DAA (I'll have to implement this eventually...)
-	case 0xBF:
-	case 0xED: // Z80 prefix
-	case 0x76: // HALT
+	CASE( 0xDD ): CASE( 0xD3 ): CASE( 0xDB ): CASE( 0xE3 ): CASE( 0xE4 ): // ?
+	CASE( 0xEB ): CASE( 0xEC ): CASE( 0xF4 ): CASE( 0xFD ): CASE( 0xFC ):
+	CASE( 0x10 ): // STOP
+	CASE( 0x27 ): // DAA (I'll have to implement this eventually...)
+	CASE( 0xBF ):
+	CASE( 0xED ): // Z80 prefix
+	CASE( 0x76 ): // HALT
 		s.remain++;
 		goto stop;
 	}
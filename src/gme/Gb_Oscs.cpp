@@ -166,6 +166,41 @@ void Gb_Square::run( blip_time_t time, blip_time_t end_time, int playing )
 	delay = time - end_time;
 }
 
+// same as run() without synthesis; phase is advanced in one step
+void Gb_Square::skip( blip_time_t time, blip_time_t end_time, int playing )
+{
+	if ( sweep_freq == 2048 )
+		playing = false;
+	
+	static unsigned char const table [4] = { 1, 2, 4, 6 };
+	int const duty = table [regs [1] >> 6];
+	int amp = volume & playing;
+	if ( phase >= duty )
+		amp = -amp;
+	
+	int frequency = this->frequency();
+	if ( unsigned (frequency - 1) > 2040 ) // frequency < 1 || frequency > 2041
+	{
+		amp = volume >> 1;
+		playing = false;
+	}
+	last_amp = amp;
+	
+	time += delay;
+	if ( !playing )
+		time = end_time;
+	
+	if ( time < end_time )
+	{
+		int const period = (2048 - frequency) * 4;
+		blip_time_t count = (end_time - time + period - 1) / period;
+		time += count * period;
+		phase = (phase + count) & 7;
+		last_amp = (phase >= duty ? -volume : volume);
+	}
+	delay = time - end_time;
+}
+
 // Gb_Noise
 
 void Gb_Noise::run( blip_time_t time, blip_time_t end_time, int playing )
@@ -222,6 +257,44 @@ void Gb_Noise::run( blip_time_t time, blip_time_t end_time, int playing )
 	delay = time - end_time;
 }
 
+// same as run() without synthesis; shift register is advanced several steps at a time
+void Gb_Noise::skip( blip_time_t time, blip_time_t end_time, int playing )
+{
+	int amp = volume & playing;
+	int tap = 13 - (regs [3] & 8);
+	if ( bits >> tap & 2 )
+		amp = -amp;
+	last_amp = amp;
+	
+	time += delay;
+	if ( !playing )
+		time = end_time;
+	
+	if ( time < end_time )
+	{
+		static unsigned char const table [8] = { 8, 16, 32, 48, 64, 80, 96, 112 };
+		int period = table [regs [3] & 7] << (regs [3] >> 4);
+		blip_time_t count = (end_time - time + period - 1) / period;
+		time += count * period;
+		
+		// each new bit only depends on bits at least tap steps old, so up to
+		// tap steps can be done at once
+		unsigned bits = this->bits;
+		while ( count > 0 )
+		{
+			int n = (count < tap ? count : tap);
+			unsigned x = (bits ^ (bits >> 1)) >> (tap - n + 1);
+			bits = (bits << n) | (x & ((1u << n) - 1));
+			count -= n;
+		}
+		this->bits = bits;
+		
+		// amplitude is negative whenever bit tap + 1 is set
+		last_amp = (bits >> tap & 2 ? -volume : volume);
+	}
+	delay = time - end_time;
+}
+
 // Gb_Wave
 
 inline void Gb_Wave::write_register( int reg, int data )
@@ -303,6 +376,33 @@ void Gb_Wave::run( blip_time_t time, blip_time_t end_time, int playing )
 	delay = time - end_time;
 }
 
+// same as run() without synthesis; position is advanced in one step
+void Gb_Wave::skip( blip_time_t time, blip_time_t end_time, int playing )
+{
+	int volume_shift = (volume - 1) & 7; // volume = 0 causes shift = 7
+	int frequency = this->frequency();
+	last_amp = (wave [wave_pos] >> volume_shift & playing) * 2;
+	if ( unsigned (frequency - 1) > 2044 ) // frequency < 1 || frequency > 2045
+	{
+		last_amp = 30 >> volume_shift & playing;
+		playing = false;
+	}
+	
+	time += delay;
+	if ( !playing )
+		time = end_time;
+	
+	if ( time < end_time )
+	{
+		int const period = (2048 - frequency) * 2;
+		blip_time_t count = (end_time - time + period - 1) / period;
+		time += count * period;
+		wave_pos = (wave_pos + count) & (wave_size - 1);
+		last_amp = (wave [wave_pos] >> volume_shift) * 2;
+	}
+	delay = time - end_time;
+}
+
 // Gb_Apu::write_osc
 
 void Gb_Apu::write_osc( int index, int reg, int data )
@@ -51,6 +51,7 @@ struct Gb_Square : Gb_Env
 	void reset();
 	void clock_sweep();
 	void run( blip_time_t, blip_time_t, int playing );
+	void skip( blip_time_t, blip_time_t, int playing );
 };
 
 struct Gb_Noise : Gb_Env
@@ -60,6 +61,7 @@ struct Gb_Noise : Gb_Env
 	unsigned bits;
 	
 	void run( blip_time_t, blip_time_t, int playing );
+	void skip( blip_time_t, blip_time_t, int playing );
 };
 
 struct Gb_Wave : Gb_Osc
@@ -72,6 +74,7 @@ struct Gb_Wave : Gb_Osc
 	
 	void write_register( int, int );
 	void run( blip_time_t, blip_time_t, int playing );
+	void skip( blip_time_t, blip_time_t, int playing );
 };
 
 inline void Gb_Env::reset()
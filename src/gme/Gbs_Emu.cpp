@@ -107,7 +107,19 @@ blargg_err_t Gbs_Emu::load_( Data_Reader& in )
 {
 	assert( offsetof (header_t,copyright [32]) == header_size );
 	RETURN_ERR( rom.load( in, header_size, &header_, 0 ) );
-	
+	return check_header();
+}
+
+blargg_err_t Gbs_Emu::load_shared_( Music_Emu const& source )
+{
+	Gbs_Emu const& gbs = STATIC_CAST(Gbs_Emu const&,source);
+	RETURN_ERR( rom.share( gbs.rom ) );
+	header_ = gbs.header_;
+	return check_header();
+}
+
+blargg_err_t Gbs_Emu::check_header()
+{
 	set_track_count( header_.track_count );
 	RETURN_ERR( check_gbs_header( &header_ ) );
 	
@@ -154,6 +166,7 @@ void Gbs_Emu::set_bank( int n )
 		return;
 		//n = 1;
 	}
+	bank_addr = addr;
 	cpu::map_code( bank_size, bank_size, rom.at_addr( addr ) );
 }
 
@@ -192,12 +205,30 @@ void Gbs_Emu::cpu_jsr( gb_addr_t addr )
 	cpu_write( --cpu::r.sp, idle_addr&0xFF );
 }
 
+bool Gbs_Emu::fast_forward_( bool b )
+{
+	apu.fast_forward( b );
+	return true;
+}
+
 void Gbs_Emu::set_tempo_( double t )
 {
 	apu.set_tempo( t );
 	update_timer();
 }
 
+void Gbs_Emu::map_memory()
+{
+	cpu::reset( rom.unmapped() );
+	
+	unsigned load_addr = get_le16( header_.load_addr );
+	cpu::rst_base = load_addr;
+	rom.set_addr( load_addr );
+	
+	cpu::map_code( ram_addr, 0x10000 - ram_addr, ram );
+	cpu::map_code( 0, bank_size, rom.at_addr( 0 ) );
+}
+
 blargg_err_t Gbs_Emu::start_track_( int track )
 {
 	RETURN_ERR( Classic_Emu::start_track_( track ) );
@@ -211,14 +242,7 @@ blargg_err_t Gbs_Emu::start_track_( int track )
 	for ( int i = 0; i < (int) sizeof sound_data; i++ )
 		apu.write_register( 0, i + apu.start_addr, sound_data [i] );
 	
-	cpu::reset( rom.unmapped() );
-	
-	unsigned load_addr = get_le16( header_.load_addr );
-	cpu::rst_base = load_addr;
-	rom.set_addr( load_addr );
-	
-	cpu::map_code( ram_addr, 0x10000 - ram_addr, ram );
-	cpu::map_code( 0, bank_size, rom.at_addr( 0 ) );
+	map_memory();
 	set_bank( rom.size() > bank_size );
 	
 	ram [hi_page + 6] = header_.timer_modulo;
@@ -235,6 +259,37 @@ blargg_err_t Gbs_Emu::start_track_( int track )
 	return 0;
 }
 
+blargg_err_t Gbs_Emu::sync_state_( blargg_state_t& s )
+{
+	// header is saved only to catch state from a different file
+	header_t header = header_;
+	s.sync( &header, sizeof header );
+	if ( memcmp( &header, &header_, sizeof header ) )
+		s.set_error( "Saved state is for a different file" );
+	
+	sync_buffer_state( s );
+	
+	gb_apu_state_t apu_state;
+	if ( !s.loading() )
+		apu.save_state( &apu_state );
+	s.sync( &apu_state, sizeof apu_state );
+	
+	s.sync( ram, sizeof ram );
+	s.sync( &next_play, sizeof next_play );
+	s.sync( &bank_addr, sizeof bank_addr );
+	
+	if ( s.loading() && !s.error() )
+	{
+		apu.load_state( apu_state );
+		map_memory(); // also resets registers, so they're loaded below
+		cpu::map_code( bank_size, bank_size, rom.at_addr( bank_addr ) );
+		update_timer();
+	}
+	s.sync( &(cpu::r), sizeof cpu::r );
+	
+	return s.error();
+}
+
 blargg_err_t Gbs_Emu::run_clocks( blip_time_t& duration, int )
 {
 	cpu_time = 0;
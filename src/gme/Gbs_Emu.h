@@ -51,8 +51,11 @@ public:
 protected:
 	blargg_err_t track_info_( track_info_t*, int track ) const;
 	blargg_err_t load_( Data_Reader& );
+	blargg_err_t load_shared_( Music_Emu const& );
 	blargg_err_t start_track_( int );
 	blargg_err_t run_clocks( blip_time_t&, int );
+	bool fast_forward_( bool );
+	blargg_err_t sync_state_( blargg_state_t& );
 	void set_tempo_( double );
 	void set_voice( int, Blip_Buffer*, Blip_Buffer*, Blip_Buffer* );
 	void update_eq( blip_eq_t const& );
@@ -61,7 +64,10 @@ private:
 	// rom
 	enum { bank_size = 0x4000 };
 	Rom_Data<bank_size> rom;
+	blargg_long bank_addr; // ROM address currently mapped at $4000
 	void set_bank( int );
+	void map_memory();
+	blargg_err_t check_header();
 	
 	// timer
 	blip_time_t cpu_time;
@@ -80,6 +80,7 @@ protected:
 	void set_warning( const char* s )   { warning_ = s; }
 	void set_type( gme_type_t t )       { type_ = t; }
 	blargg_err_t load_remaining_( void const* header, long header_size, Data_Reader& remaining );
+	blargg_err_t post_load( blargg_err_t err ); // public load functions call this at end
 	
 	// Overridable
 	virtual void unload();  // called before loading file and if loading fails
@@ -108,7 +109,6 @@ private:
 	blargg_vector<byte> file_data; // only if loaded into memory using default load
 	
 	blargg_err_t load_m3u_( blargg_err_t );
-	blargg_err_t post_load( blargg_err_t err );
 public:
 	// track_info field copying
 	enum { max_field_ = 255 };
@@ -28,6 +28,38 @@ Multi_Buffer::Multi_Buffer( int spf ) : samples_per_frame_( spf )
 
 blargg_err_t Multi_Buffer::set_channel_count( int ) { return 0; }
 
+void Multi_Buffer::sync_buffer( blargg_state_t& s, Blip_Buffer& buf )
+{
+	// size and rate are only saved to catch a mismatch when loading
+	blip_long size = buf.buffer_size_;
+	blip_ulong factor = buf.factor_;
+	s.sync( &size, sizeof size );
+	s.sync( &factor, sizeof factor );
+	if ( size != buf.buffer_size_ || factor != buf.factor_ )
+		s.set_error( "Saved state doesn't match sound buffer settings" );
+	if ( s.error() )
+		return;
+	
+	if ( s.loading() )
+		buf.clear();
+	
+	int modified = buf.clear_modified();
+	s.sync( &modified, sizeof modified );
+	if ( modified )
+		buf.set_modified();
+	
+	s.sync( &buf.offset_, sizeof buf.offset_ );
+	s.sync( &buf.reader_accum_, sizeof buf.reader_accum_ );
+	if ( buf.samples_avail() > buf.buffer_size_ )
+	{
+		s.set_error( "Corrupt saved state" );
+		buf.offset_ = 0;
+	}
+	
+	// unread samples, followed by the tails of impulses added past them
+	s.sync( buf.buffer_, (buf.samples_avail() + blip_buffer_extra_) * sizeof *buf.buffer_ );
+}
+
 // Silent_Buffer
 
 Silent_Buffer::Silent_Buffer() : Multi_Buffer( 1 ) // 0 channels would probably confuse
@@ -93,6 +125,14 @@ void Stereo_Buffer::clear()
 		bufs [i].clear();
 }
 
+void Stereo_Buffer::sync_state( blargg_state_t& s )
+{
+	s.sync( &stereo_added, sizeof stereo_added );
+	s.sync( &was_stereo, sizeof was_stereo );
+	for ( int i = 0; i < buf_count; i++ )
+		sync_buffer( s, bufs [i] );
+}
+
 void Stereo_Buffer::end_frame( blip_time_t clock_count )
 {
 	stereo_added = 0;
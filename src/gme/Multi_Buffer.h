@@ -51,10 +51,15 @@ public:
 	virtual long read_samples( blip_sample_t*, long ) = 0;
 	virtual long samples_avail() const = 0;
 	
+	// Save or restore unread samples, pending synthesis and filter state (see
+	// blargg_common.h). Settings must be the same when restoring.
+	virtual void sync_state( blargg_state_t& ) = 0;
+	
 public:
 	BLARGG_DISABLE_NOTHROW
 protected:
 	void channels_changed() { channels_changed_count_++; }
+	static void sync_buffer( blargg_state_t&, Blip_Buffer& );
 private:
 	// noncopyable
 	Multi_Buffer( const Multi_Buffer& );
@@ -85,6 +90,7 @@ public:
 	long read_samples( blip_sample_t* p, long s ) { return buf.read_samples( p, s ); }
 	channel_t channel( int, int ) { return chan; }
 	void end_frame( blip_time_t t ) { buf.end_frame( t ); }
+	void sync_state( blargg_state_t& s ) { sync_buffer( s, buf ); }
 };
 
 // Uses three buffers (one for center) and outputs stereo sample pairs.
@@ -108,6 +114,7 @@ public:
 	
 	long samples_avail() const { return bufs [0].samples_avail() * 2; }
 	long read_samples( blip_sample_t*, long );
+	void sync_state( blargg_state_t& );
 	
 private:
 	enum { buf_count = 3 };
@@ -137,6 +144,7 @@ public:
 	void end_frame( blip_time_t ) { }
 	long samples_avail() const { return 0; }
 	long read_samples( blip_sample_t*, long ) { return 0; }
+	void sync_state( blargg_state_t& ) { }
 };
 
 
@@ -129,6 +129,18 @@ void Music_Emu::post_load_()
 	remute_voices();
 }
 
+blargg_err_t Music_Emu::load_shared_( Music_Emu const& ) { return "Sharing file data not supported"; }
+
+blargg_err_t Music_Emu::load_shared( Music_Emu const& source )
+{
+	pre_load();
+	blargg_err_t err = "Can't share file data with different emulator type";
+	// info-only objects never have a sample rate
+	if ( source.type() == type() && source.sample_rate() && source.track_count() )
+		err = load_shared_( source );
+	return post_load( err );
+}
+
 blargg_err_t Music_Emu::start_track( int track )
 {
 	clear_track_vars();
@@ -143,7 +155,8 @@ blargg_err_t Music_Emu::start_track( int track )
 	
 	if ( !ignore_silence_ )
 	{
-		// play until non-silence or end of track
+		// play until non-silence or end of track. silence can only be found in
+		// rendered samples, so this can't use fast_forward_() like skip_() does
 		for ( long end = max_initial_silence * stereo * sample_rate(); emu_time < end; )
 		{
 			fill_buf();
@@ -222,20 +235,27 @@ blargg_err_t Music_Emu::skip( long count )
 
 blargg_err_t Music_Emu::skip_( long count )
 {
-	// for long skip, mute sound
+	// for long skip, run without synthesis, or mute sound if that isn't supported
 	const long threshold = 30000;
 	if ( count > threshold )
 	{
 		int saved_mute = mute_mask_;
-		mute_voices( ~0 );
+		bool fast = fast_forward_( true );
+		if ( !fast )
+			mute_voices( ~0 );
 		
-		while ( count > threshold / 2 && !emu_track_ended_ )
+		blargg_err_t err = 0;
+		while ( count > threshold / 2 && !emu_track_ended_ && !err )
 		{
-			RETURN_ERR( play_( buf_size, buf.begin() ) );
+			err = play_( buf_size, buf.begin() );
 			count -= buf_size;
 		}
 		
-		mute_voices( saved_mute );
+		if ( fast )
+			fast_forward_( false );
+		else
+			mute_voices( saved_mute );
+		RETURN_ERR( err );
 	}
 	
 	while ( count && !emu_track_ended_ )
@@ -249,6 +269,63 @@ blargg_err_t Music_Emu::skip_( long count )
 	return 0;
 }
 
+// Saved state
+
+void Music_Emu::sync_track_vars( state_t& s )
+{
+	#define SYNC( var ) s.sync( &var, sizeof var )
+	
+	SYNC( current_track_ );
+	SYNC( out_time );
+	SYNC( emu_time );
+	SYNC( emu_track_ended_ );
+	bool ended = track_ended_;
+	SYNC( ended );
+	track_ended_ = ended;
+	SYNC( fade_start );
+	SYNC( fade_step );
+	SYNC( silence_time );
+	SYNC( silence_count );
+	SYNC( buf_remain );
+	
+	#undef SYNC
+	
+	if ( (unsigned long) buf_remain > buf_size )
+	{
+		s.set_error( "Corrupt saved state" );
+		buf_remain = 0;
+	}
+	s.sync( buf.end() - buf_remain, buf_remain * sizeof (sample_t) );
+}
+
+blargg_err_t Music_Emu::save_state( state_t* out )
+{
+	require( current_track() >= 0 ); // start_track() must have been called already
+	out->begin_save();
+	sync_track_vars( *out );
+	RETURN_ERR( sync_state_( *out ) );
+	return out->error();
+}
+
+blargg_err_t Music_Emu::load_state( state_t& in )
+{
+	require( sample_rate() ); // sample rate must be set first
+	in.begin_load();
+	sync_track_vars( in );
+	blargg_err_t err = sync_state_( in );
+	if ( !err )
+		err = in.error();
+	if ( !err && !in.at_end() )
+		err = "Corrupt saved state";
+	if ( err )
+	{
+		// partially loaded state is unusable
+		clear_track_vars();
+		return err;
+	}
+	return 0;
+}
+
 // Fading
 
 void Music_Emu::set_fade( long start_msec, long length_msec )
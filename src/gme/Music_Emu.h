@@ -14,6 +14,11 @@ public:
 	// Set output sample rate. Must be called only once before loading file.
 	blargg_err_t set_sample_rate( long sample_rate );
 	
+	// Load same file as 'source', which must be the same type of emulator, using
+	// its file data rather than a copy (file data is read-only, so it can be shared).
+	// Source can be unloaded or deleted afterwards. Not supported by all emulators.
+	blargg_err_t load_shared( Music_Emu const& source );
+	
 	// Start a track, where 0 is the first track. Also clears warning string.
 	blargg_err_t start_track( int );
 	
@@ -57,6 +62,14 @@ public:
 	// Disable automatic end-of-track detection and skipping of silence at beginning
 	void ignore_silence( bool disable = true );
 	
+	// Save complete state of current track, or restore state saved earlier. The
+	// track then continues exactly where it was saved, even if other tracks were
+	// played in between. Same file must still be loaded, with sample rate, tempo,
+	// equalizer and voice muting unchanged. Not supported by all emulators.
+	typedef blargg_state_t state_t;
+	blargg_err_t save_state( state_t* out );
+	blargg_err_t load_state( state_t& in );
+	
 	// Info for current track
 	using Gme_File::track_info;
 	blargg_err_t track_info( track_info_t* out ) const;
@@ -117,6 +130,17 @@ protected:
 	virtual blargg_err_t start_track_( int ) = 0; // tempo is set before this
 	virtual blargg_err_t play_( long count, sample_t* out ) = 0;
 	virtual blargg_err_t skip_( long count );
+	
+	// Enable/disable running emulator without sound synthesis, for skipping.
+	// Emulator state must advance exactly as it would during normal play.
+	// Returns false if not supported.
+	virtual bool fast_forward_( bool ) { return false; }
+	
+	// Save or restore emulator-specific state with state_t::sync()
+	virtual blargg_err_t sync_state_( blargg_state_t& );
+	
+	// Load file data shared with source, which is same type and has a file loaded
+	virtual blargg_err_t load_shared_( Music_Emu const& source );
 protected:
 	virtual void unload();
 	virtual void pre_load();
@@ -141,6 +165,7 @@ private:
 	bool emu_track_ended_; // emulator has reached end of track
 	volatile bool track_ended_;
 	void clear_track_vars();
+	void sync_track_vars( state_t& );
 	void end_track_if_error( blargg_err_t );
 	
 	// fading
@@ -193,6 +218,7 @@ inline void Music_Emu::set_tempo_( double t )       { tempo_ = t; }
 inline void Music_Emu::remute_voices()              { mute_voices( mute_mask_ ); }
 inline void Music_Emu::ignore_silence( bool b )     { ignore_silence_ = b; }
 inline blargg_err_t Music_Emu::start_track_( int )  { return 0; }
+inline blargg_err_t Music_Emu::sync_state_( blargg_state_t& ) { return "Saving state not supported"; }
 
 inline void Music_Emu::set_voice_names( const char* const* names )
 {
@@ -8,6 +8,7 @@
 #include <stdlib.h>
 #include <assert.h>
 #include <limits.h>
+#include <string.h>
 
 #undef BLARGG_COMMON_H
 // allow blargg_config.h to #include blargg_common.h
@@ -53,6 +54,71 @@ public:
 	}
 };
 
+// blargg_state_t - saved emulator state, kept as a sequence of raw blocks. Each
+// component copies its blocks with sync(), in the same order when saving and
+// loading. Only valid for the object it was saved from (not a file format).
+class blargg_state_t {
+	blargg_vector<unsigned char> data;
+	size_t size_;
+	size_t pos;
+	bool loading_;
+	blargg_err_t err;
+public:
+	blargg_state_t() : size_( 0 ), pos( 0 ), loading_( false ), err( 0 ) { }
+
+	// Start saving (discards previous contents) or loading from beginning
+	void begin_save() { size_ = 0; pos = 0; loading_ = false; err = 0; }
+	void begin_load() { pos = 0; loading_ = true; err = 0; }
+	bool loading() const { return loading_; }
+
+	// Copy block to state when saving, or from state when loading. Does nothing
+	// once an error has occurred.
+	void sync( void* p, size_t n )
+	{
+		if ( err )
+			return;
+		if ( loading_ )
+		{
+			if ( n > size_ - pos )
+			{
+				err = "Corrupt saved state";
+				return;
+			}
+			memcpy( p, data.begin() + pos, n );
+		}
+		else
+		{
+			if ( pos + n > data.size() )
+			{
+				size_t new_size = data.size() * 2;
+				if ( new_size < pos + n )
+					new_size = pos + n;
+				err = data.resize( new_size );
+				if ( err )
+					return;
+			}
+			memcpy( data.begin() + pos, p, n );
+			size_ = pos + n;
+		}
+		pos += n;
+	}
+
+	// First error that occurred, or NULL
+	blargg_err_t error() const { return err; }
+	void set_error( blargg_err_t e ) { if ( !err ) err = e; }
+
+	// Size of saved state, and true if loading has reached the end of it
+	size_t size() const { return size_; }
+	bool at_end() const { return pos == size_; }
+
+	// Discard saved state past first n bytes, as if saving had stopped there (for testing)
+	void truncate( size_t n ) { if ( n < size_ ) size_ = n; }
+private:
+	// noncopyable
+	blargg_state_t( const blargg_state_t& );
+	blargg_state_t& operator = ( const blargg_state_t& );
+};
+
 #ifndef BLARGG_DISABLE_NOTHROW
 	#if __cplusplus < 199711
 		#define BLARGG_THROWS( spec )
@@ -16,6 +16,10 @@
 // Uncomment to use faster, lower quality sound synthesis
 //#define BLIP_BUFFER_FAST 1
 
+// Uncomment to use computed goto dispatch in Gb_Cpu (GCC/Clang only). Build
+// Gb_Cpu.cpp with -fno-crossjumping on GCC to get the full benefit.
+//#define GB_CPU_COMPUTED_GOTO 1
+
 // Uncomment if automatic byte-order determination doesn't work
 //#define BLARGG_BIG_ENDIAN 1
 
@@ -131,6 +131,24 @@ gme_err_t gme_open_data( void const* data, long size, Music_Emu** out, long samp
 	return err;
 }
 
+gme_err_t gme_open_shared( Music_Emu const* source, Music_Emu** out, long sample_rate )
+{
+	require( source && out );
+	*out = 0;
+	
+	Music_Emu* emu = gme_new_emu( source->type(), sample_rate );
+	CHECK_ALLOC( emu );
+	
+	gme_err_t err = emu->load_shared( *source );
+	
+	if ( err )
+		delete emu;
+	else
+		*out = emu;
+	
+	return err;
+}
+
 gme_err_t gme_open_file( const char* path, Music_Emu** out, long sample_rate )
 {
 	require( path && out );
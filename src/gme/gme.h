@@ -171,6 +171,12 @@ extern const char gme_wrong_file_type [];
 /* Same as gme_open_file(), but uses file data already in memory. Makes copy of data. */
 gme_err_t gme_open_data( void const* data, long size, Music_Emu** out, long sample_rate );
 
+/* Create another emulator for the file loaded in 'source', sharing its copy of the
+file data rather than making a new one. Source can be deleted afterwards. Sets *out to
+new emulator. Not supported by all music types. The game doesn't use this yet, since each
+of Engine's players loads a different file (see Tests/MusicSharedTest.cpp). */
+gme_err_t gme_open_shared( Music_Emu const* source, Music_Emu** out, long sample_rate );
+
 /* Determine likely game music type based on first four bytes of file. Returns
 string containing proper file suffix (i.e. "NSF", "SPC", etc.) or "" if
 file header is not recognized. */